@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+
+#include "libdsc/arena.h"
+#include "libdsc/list.h"
+#include "libdsc/unordered_map.h"
+#include "libdsc/vector.h"
+
+// Simulates one request: a few short-lived containers filled with
+// state.range(0) elements each.
+static void run_request(benchmark::State &state,
+                        DSCAllocator const *allocator, bool destroy) {
+    DSCVector *vec = vector_create_with_allocator(sizeof(int), allocator);
+    DSCList *list = list_create_with_allocator(sizeof(int), allocator);
+    DSCUnorderedMap *map = unordered_map_create_with_allocator(
+        sizeof(int), sizeof(int), nullptr, nullptr, allocator);
+
+    for (int i = 0; i < state.range(0); ++i) {
+        vector_push_back(vec, &i);
+        list_push_back(list, &i);
+        unordered_map_insert(map, &i, &i);
+    }
+    benchmark::DoNotOptimize(unordered_map_size(map));
+
+    if (destroy) {
+        vector_destroy(vec);
+        list_destroy(list);
+        unordered_map_destroy(map);
+    }
+}
+
+// Baseline: every container allocates and frees through malloc().
+static void BM_RequestMalloc(benchmark::State &state) {
+    for (auto _ : state) {
+        run_request(state, nullptr, true);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RequestMalloc)->Range(1 << 4, 1 << 14);
+
+// The same request served from an arena that is reset afterwards.
+static void BM_RequestArena(benchmark::State &state) {
+    DSCArena *arena = arena_create(0);
+    DSCAllocator allocator = arena_allocator(arena);
+
+    for (auto _ : state) {
+        run_request(state, &allocator, false);
+        arena_reset(arena);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    arena_destroy(arena);
+}
+BENCHMARK(BM_RequestArena)->Range(1 << 4, 1 << 14);
+
+// Raw allocation cost of small blocks.
+static void BM_ArenaAllocate(benchmark::State &state) {
+    DSCArena *arena = arena_create(0);
+
+    for (auto _ : state) {
+        for (int i = 0; i < 1024; ++i) {
+            benchmark::DoNotOptimize(arena_allocate(arena, 32));
+        }
+        arena_reset(arena);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+
+    arena_destroy(arena);
+}
+BENCHMARK(BM_ArenaAllocate);
+
+static void BM_MallocFree(benchmark::State &state) {
+    void *blocks[1024];
+
+    for (auto _ : state) {
+        for (auto &block : blocks) {
+            block = malloc(32);
+            benchmark::DoNotOptimize(block);
+        }
+        for (auto &block : blocks) free(block);
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+BENCHMARK(BM_MallocFree);
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <mutex>
+#include <random>
+
+#include "libdsc/concurrent_map.h"
+#include "libdsc/unordered_map.h"
+
+// Keys preloaded before timing; the workload draws from twice as many so
+// that about half of the lookups miss and inserts keep growing the map.
+static constexpr uint64_t kPreloaded = 1 << 20;
+
+// One operation in ten is an insert, the rest are lookups.
+static constexpr uint64_t kInsertEvery = 10;
+
+static DSCConcurrentMap *g_concurrent;
+static DSCUnorderedMap *g_locked;
+static std::mutex g_lock;
+
+// Thread 0 builds the shared map before the threads start timing and
+// tears it down after they stop; benchmark synchronizes around both.
+static void BM_ConcurrentMapMixed(benchmark::State &state) {
+    if (state.thread_index() == 0) {
+        g_concurrent = concurrent_map_create(sizeof(uint64_t),
+                                             sizeof(uint64_t), nullptr,
+                                             nullptr, state.range(0));
+        for (uint64_t key = 0; key < kPreloaded; ++key) {
+            concurrent_map_insert(g_concurrent, &key, &key);
+        }
+    }
+
+    std::mt19937_64 gen(state.thread_index());
+    uint64_t ops = 0;
+    for (auto _ : state) {
+        uint64_t key = gen() % (2 * kPreloaded);
+        if (++ops % kInsertEvery == 0) {
+            benchmark::DoNotOptimize(
+                concurrent_map_insert(g_concurrent, &key, &key));
+        } else {
+            uint64_t value;
+            benchmark::DoNotOptimize(
+                concurrent_map_find(g_concurrent, &key, &value));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        concurrent_map_destroy(g_concurrent);
+    }
+}
+BENCHMARK(BM_ConcurrentMapMixed)
+    ->Arg(64)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+// Baseline: a single DSCUnorderedMap behind one mutex.
+static void BM_LockedUnorderedMapMixed(benchmark::State &state) {
+    if (state.thread_index() == 0) {
+        g_locked = unordered_map_create(sizeof(uint64_t), sizeof(uint64_t),
+                                        nullptr, nullptr);
+        for (uint64_t key = 0; key < kPreloaded; ++key) {
+            unordered_map_insert(g_locked, &key, &key);
+        }
+    }
+
+    std::mt19937_64 gen(state.thread_index());
+    uint64_t ops = 0;
+    for (auto _ : state) {
+        uint64_t key = gen() % (2 * kPreloaded);
+        std::lock_guard<std::mutex> guard(g_lock);
+        if (++ops % kInsertEvery == 0) {
+            benchmark::DoNotOptimize(
+                unordered_map_insert(g_locked, &key, &key));
+        } else {
+            benchmark::DoNotOptimize(unordered_map_find(g_locked, &key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        unordered_map_destroy(g_locked);
+    }
+}
+BENCHMARK(BM_LockedUnorderedMapMixed)->ThreadRange(1, 16)->UseRealTime();
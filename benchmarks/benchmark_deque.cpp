@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "libdsc/deque.h"
+
+// Benchmark filling a deque from the back
+static void BM_DequePushBack(benchmark::State &state) {
+    for (auto _ : state) {
+        DSCDeque *deque = deque_create(sizeof(int));
+        for (int i = 0; i < state.range(0); ++i) {
+            deque_push_back(deque, &i);
+        }
+        benchmark::DoNotOptimize(deque_back(deque));
+        deque_destroy(deque);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DequePushBack)->Range(1 << 10, 1 << 20);
+
+static void BM_StdDequePushBack(benchmark::State &state) {
+    for (auto _ : state) {
+        std::deque<int> deque;
+        for (int i = 0; i < state.range(0); ++i) {
+            deque.push_back(i);
+        }
+        benchmark::DoNotOptimize(deque.back());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdDequePushBack)->Range(1 << 10, 1 << 20);
+
+// Benchmark filling a deque from the front
+static void BM_DequePushFront(benchmark::State &state) {
+    for (auto _ : state) {
+        DSCDeque *deque = deque_create(sizeof(int));
+        for (int i = 0; i < state.range(0); ++i) {
+            deque_push_front(deque, &i);
+        }
+        benchmark::DoNotOptimize(deque_front(deque));
+        deque_destroy(deque);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DequePushFront)->Range(1 << 10, 1 << 20);
+
+static void BM_StdDequePushFront(benchmark::State &state) {
+    for (auto _ : state) {
+        std::deque<int> deque;
+        for (int i = 0; i < state.range(0); ++i) {
+            deque.push_front(i);
+        }
+        benchmark::DoNotOptimize(deque.front());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdDequePushFront)->Range(1 << 10, 1 << 20);
+
+// Benchmark random access into a deque grown at both ends
+static void BM_DequeRandomAccess(benchmark::State &state) {
+    DSCDeque *deque = deque_create(sizeof(int));
+    for (int i = 0; i < state.range(0); ++i) {
+        (i % 2 ? deque_push_back : deque_push_front)(deque, &i);
+    }
+    std::mt19937 rng(42);
+    std::vector<size_t> indices(4096);
+    for (auto &index : indices) index = rng() % state.range(0);
+
+    for (auto _ : state) {
+        long sum = 0;
+        for (size_t index : indices) {
+            sum += *static_cast<int *>(deque_at(deque, index));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+
+    deque_destroy(deque);
+}
+BENCHMARK(BM_DequeRandomAccess)->Range(1 << 10, 1 << 20);
+
+static void BM_StdDequeRandomAccess(benchmark::State &state) {
+    std::deque<int> deque;
+    for (int i = 0; i < state.range(0); ++i) {
+        if (i % 2) {
+            deque.push_back(i);
+        } else {
+            deque.push_front(i);
+        }
+    }
+    std::mt19937 rng(42);
+    std::vector<size_t> indices(4096);
+    for (auto &index : indices) index = rng() % state.range(0);
+
+    for (auto _ : state) {
+        long sum = 0;
+        for (size_t index : indices) {
+            sum += deque[index];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * indices.size());
+}
+BENCHMARK(BM_StdDequeRandomAccess)->Range(1 << 10, 1 << 20);
+
+// Benchmark FIFO use: push at the back and pop at the front around a
+// constant size, which walks through blocks and exercises recycling
+static void BM_DequeFifo(benchmark::State &state) {
+    DSCDeque *deque = deque_create(sizeof(int));
+    for (int i = 0; i < state.range(0); ++i) {
+        deque_push_back(deque, &i);
+    }
+
+    int value = 0;
+    for (auto _ : state) {
+        deque_push_back(deque, &value);
+        deque_pop_front(deque);
+        ++value;
+    }
+    benchmark::DoNotOptimize(deque_front(deque));
+    state.SetItemsProcessed(state.iterations());
+
+    deque_destroy(deque);
+}
+BENCHMARK(BM_DequeFifo)->Range(1 << 4, 1 << 16);
+
+static void BM_StdDequeFifo(benchmark::State &state) {
+    std::deque<int> deque;
+    for (int i = 0; i < state.range(0); ++i) {
+        deque.push_back(i);
+    }
+
+    int value = 0;
+    for (auto _ : state) {
+        deque.push_back(value);
+        deque.pop_front();
+        ++value;
+    }
+    benchmark::DoNotOptimize(deque.front());
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StdDequeFifo)->Range(1 << 4, 1 << 16);
+
+BENCHMARK_MAIN();
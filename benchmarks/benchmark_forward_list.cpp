@@ -1,12 +1,14 @@
 #include <benchmark/benchmark.h>
 
 #include <forward_list>
+#include <random>
+#include <vector>
 
 #include "libdsc/forward_list.h"
 
 // Benchmark push_front
 static void BM_ForwardListPushFront(benchmark::State &state) {
-    dsc_forward_list *list = forward_list_create(sizeof(int));
+    DSCForwardList *list = forward_list_create(sizeof(int));
 
     for (auto _ : state) {
         int value = 42;
@@ -30,7 +32,7 @@ BENCHMARK(BM_StdForwardListPushFront)->Range(1, 1 << 20);
 
 // Benchmark push_front and pop_front
 static void BM_ForwardListPushPopFront(benchmark::State &state) {
-    dsc_forward_list *list = forward_list_create(sizeof(int));
+    DSCForwardList *list = forward_list_create(sizeof(int));
 
     for (auto _ : state) {
         int value = 42;
@@ -55,7 +57,7 @@ BENCHMARK(BM_StdForwardListPushPopFront)->Range(1, 1 << 20);
 
 // Benchmark front access
 static void BM_ForwardListFront(benchmark::State &state) {
-    dsc_forward_list *list = forward_list_create(sizeof(int));
+    DSCForwardList *list = forward_list_create(sizeof(int));
     int value = 42;
     forward_list_push_front(list, &value);
 
@@ -80,10 +82,10 @@ BENCHMARK(BM_StdForwardListFront)->Range(1 << 10, 1 << 20);
 
 // Benchmark insert_after
 static void BM_ForwardListInsertAfter(benchmark::State &state) {
-    dsc_forward_list *list = forward_list_create(sizeof(int));
+    DSCForwardList *list = forward_list_create(sizeof(int));
     int value = 42;
     forward_list_push_front(list, &value);
-    forward_list_node_t *pos = forward_list_begin(list);
+    DSCForwardListNode *pos = forward_list_begin(list);
 
     for (auto _ : state) {
         benchmark::DoNotOptimize(forward_list_insert_after(list, pos, &value));
@@ -108,7 +110,7 @@ BENCHMARK(BM_StdForwardListInsertAfter)->Range(1, 1 << 20);
 
 // Benchmark size operation
 static void BM_ForwardListSize(benchmark::State &state) {
-    dsc_forward_list *list = forward_list_create(sizeof(int));
+    DSCForwardList *list = forward_list_create(sizeof(int));
     int value = 42;
     for (size_t i = 0; i < 1000; ++i) {
         forward_list_push_front(list, &value);
@@ -138,7 +140,7 @@ BENCHMARK(BM_StdForwardListSize)->Range(1 << 10, 1 << 20);
 
 // Benchmark empty check
 static void BM_ForwardListEmpty(benchmark::State &state) {
-    dsc_forward_list *list = forward_list_create(sizeof(int));
+    DSCForwardList *list = forward_list_create(sizeof(int));
 
     for (auto _ : state) {
         benchmark::DoNotOptimize(forward_list_empty(list));
@@ -160,10 +162,10 @@ BENCHMARK(BM_StdForwardListEmpty)->Range(1 << 10, 1 << 20);
 
 // Benchmark erase_after operation
 static void BM_ForwardListEraseAfter(benchmark::State &state) {
-    dsc_forward_list *list = forward_list_create(sizeof(int));
+    DSCForwardList *list = forward_list_create(sizeof(int));
     int value = 42;
     forward_list_push_front(list, &value);
-    forward_list_node_t *pos = forward_list_begin(list);
+    DSCForwardListNode *pos = forward_list_begin(list);
     forward_list_insert_after(list, pos, &value);  // Add a node to erase
 
     for (auto _ : state) {
@@ -195,7 +197,7 @@ BENCHMARK(BM_StdForwardListEraseAfter)->Range(1 << 10, 1 << 20);
 
 // Benchmark clear operation
 static void BM_ForwardListClear(benchmark::State &state) {
-    dsc_forward_list *list = forward_list_create(sizeof(int));
+    DSCForwardList *list = forward_list_create(sizeof(int));
     int value = 42;
 
     for (auto _ : state) {
@@ -232,14 +234,14 @@ BENCHMARK(BM_StdForwardListClear)->Range(1 << 10, 1 << 20);
 
 // Benchmark iterator operations (begin/end traversal)
 static void BM_ForwardListTraversal(benchmark::State &state) {
-    dsc_forward_list *list = forward_list_create(sizeof(int));
+    DSCForwardList *list = forward_list_create(sizeof(int));
     int value = 42;
     for (size_t i = 0; i < 1000; ++i) {
         forward_list_push_front(list, &value);
     }
 
     for (auto _ : state) {
-        forward_list_node_t *it = forward_list_begin(list);
+        DSCForwardListNode *it = forward_list_begin(list);
         while (it != forward_list_end(list)) {
             benchmark::DoNotOptimize(it);
             it = it->next;
@@ -265,4 +267,48 @@ static void BM_StdForwardListTraversal(benchmark::State &state) {
 }
 BENCHMARK(BM_StdForwardListTraversal)->Range(1 << 10, 1 << 20);
 
+// Benchmark sorting random elements by relinking nodes
+static void BM_ForwardListSort(benchmark::State &state) {
+    std::mt19937 gen(42);
+    std::vector<int> values(state.range(0));
+    for (int &value : values) value = static_cast<int>(gen());
+    DSCForwardList *list = forward_list_create(sizeof(int));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        forward_list_clear(list);
+        for (int &value : values) forward_list_push_front(list, &value);
+        state.ResumeTiming();
+
+        forward_list_sort(list, dsc_compare_int);
+        benchmark::DoNotOptimize(forward_list_begin(list));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    forward_list_destroy(list);
+}
+BENCHMARK(BM_ForwardListSort)->Range(1 << 10, 1 << 20);
+
+// Benchmark std::forward_list::sort on the same input
+static void BM_StdForwardListSort(benchmark::State &state) {
+    std::mt19937 gen(42);
+    std::vector<int> values(state.range(0));
+    for (int &value : values) value = static_cast<int>(gen());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::forward_list<int> list(values.rbegin(), values.rend());
+        state.ResumeTiming();
+
+        list.sort();
+        benchmark::DoNotOptimize(list.front());
+
+        state.PauseTiming();
+        list.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdForwardListSort)->Range(1 << 10, 1 << 20);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "libdsc/frozen_map.h"
+#include "libdsc/unordered_map.h"
+
+static DSCUnorderedMap *make_map(uint64_t n) {
+    DSCUnorderedMap *map = unordered_map_create(
+        sizeof(uint64_t), sizeof(uint64_t), nullptr, nullptr);
+    for (uint64_t key = 0; key < n; ++key) {
+        unordered_map_insert(map, &key, &key);
+    }
+    return map;
+}
+
+static std::vector<uint64_t> random_keys(uint64_t n) {
+    std::mt19937_64 gen(42);
+    std::vector<uint64_t> keys(1 << 16);
+    for (auto &key : keys) key = gen() % n;
+    return keys;
+}
+
+static void BM_FrozenMapBuild(benchmark::State &state) {
+    DSCUnorderedMap *map = make_map(state.range(0));
+
+    for (auto _ : state) {
+        DSCFrozenMap *frozen = unordered_map_freeze(map);
+        benchmark::DoNotOptimize(frozen);
+        frozen_map_destroy(frozen);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    unordered_map_destroy(map);
+}
+BENCHMARK(BM_FrozenMapBuild)->Range(1 << 10, 1 << 20);
+
+static void BM_FrozenMapFind(benchmark::State &state) {
+    DSCUnorderedMap *map = make_map(state.range(0));
+    DSCFrozenMap *frozen = unordered_map_freeze(map);
+    std::vector<uint64_t> keys = random_keys(state.range(0));
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            frozen_map_find(frozen, &keys[i++ & (keys.size() - 1)]));
+    }
+
+    frozen_map_destroy(frozen);
+    unordered_map_destroy(map);
+}
+BENCHMARK(BM_FrozenMapFind)->Range(1 << 10, 1 << 22);
+
+// Baseline: the same lookups on the source map.
+static void BM_UnorderedMapFindBeforeFreeze(benchmark::State &state) {
+    DSCUnorderedMap *map = make_map(state.range(0));
+    std::vector<uint64_t> keys = random_keys(state.range(0));
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            unordered_map_find(map, &keys[i++ & (keys.size() - 1)]));
+    }
+
+    unordered_map_destroy(map);
+}
+BENCHMARK(BM_UnorderedMapFindBeforeFreeze)->Range(1 << 10, 1 << 22);
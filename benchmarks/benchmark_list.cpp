@@ -1,12 +1,14 @@
 #include <benchmark/benchmark.h>
 
 #include <list>
+#include <random>
+#include <vector>
 
 #include "libdsc/list.h"
 
 // Benchmark push_front
 static void BM_ListPushFront(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
 
     for (auto _ : state) {
         int value = 42;
@@ -30,7 +32,7 @@ BENCHMARK(BM_StdListPushFront)->Range(1, 1 << 20);
 
 // Benchmark push_back
 static void BM_ListPushBack(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
 
     for (auto _ : state) {
         int value = 42;
@@ -54,7 +56,7 @@ BENCHMARK(BM_StdListPushBack)->Range(1, 1 << 20);
 
 // Benchmark push_front and pop_front
 static void BM_ListPushPopFront(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
 
     for (auto _ : state) {
         int value = 42;
@@ -79,7 +81,7 @@ BENCHMARK(BM_StdListPushPopFront)->Range(1, 1 << 20);
 
 // Benchmark push_back and pop_back
 static void BM_ListPushPopBack(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
 
     for (auto _ : state) {
         int value = 42;
@@ -104,7 +106,7 @@ BENCHMARK(BM_StdListPushPopBack)->Range(1, 1 << 20);
 
 // Benchmark front access
 static void BM_ListFront(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
     int value = 42;
     list_push_front(list, &value);
 
@@ -129,7 +131,7 @@ BENCHMARK(BM_StdListFront)->Range(1 << 10, 1 << 20);
 
 // Benchmark back access
 static void BM_ListBack(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
     int value = 42;
     list_push_back(list, &value);
 
@@ -154,7 +156,7 @@ BENCHMARK(BM_StdListBack)->Range(1 << 10, 1 << 20);
 
 // Benchmark size operation
 static void BM_ListSize(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
     int value = 42;
     for (size_t i = 0; i < 1000; ++i) {
         list_push_front(list, &value);
@@ -183,7 +185,7 @@ BENCHMARK(BM_StdListSize)->Range(1 << 10, 1 << 20);
 
 // Benchmark empty check
 static void BM_ListEmpty(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
 
     for (auto _ : state) {
         benchmark::DoNotOptimize(list_empty(list));
@@ -205,14 +207,14 @@ BENCHMARK(BM_StdListEmpty)->Range(1 << 10, 1 << 20);
 
 // Benchmark insert operation
 static void BM_ListInsert(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
     int value = 42;
 
     for (auto _ : state) {
         state.PauseTiming();
         list_clear(list);                     // Clear any previous nodes
         list_push_back(list, &value);         // Add initial node
-        list_node_t *pos = list_begin(list);  // Get fresh position
+        DSCListNode *pos = list_begin(list);  // Get fresh position
         state.ResumeTiming();
 
         benchmark::DoNotOptimize(list_insert(list, pos, &value));
@@ -240,11 +242,11 @@ BENCHMARK(BM_StdListInsert)->Range(1 << 10, 1 << 20);
 
 // Benchmark erase operation
 static void BM_ListErase(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
     int value = 42;
     list_push_back(list, &value);
     list_push_back(list, &value);
-    list_node_t *pos = list_begin(list)->next;
+    DSCListNode *pos = list_begin(list)->next;
 
     for (auto _ : state) {
         benchmark::DoNotOptimize(list_erase(list, pos));
@@ -276,7 +278,7 @@ BENCHMARK(BM_StdListErase)->Range(1 << 10, 1 << 20);
 
 // Benchmark clear operation
 static void BM_ListClear(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
     int value = 42;
 
     for (auto _ : state) {
@@ -313,14 +315,14 @@ BENCHMARK(BM_StdListClear)->Range(1 << 10, 1 << 20);
 
 // Benchmark forward iterator traversal
 static void BM_ListForwardTraversal(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
     int value = 42;
     for (size_t i = 0; i < 1000; ++i) {
         list_push_back(list, &value);
     }
 
     for (auto _ : state) {
-        list_node_t *it = list_begin(list);
+        DSCListNode *it = list_begin(list);
         while (it != list_end(list)) {
             benchmark::DoNotOptimize(it);
             it = it->next;
@@ -348,14 +350,14 @@ BENCHMARK(BM_StdListForwardTraversal)->Range(1 << 10, 1 << 20);
 
 // Benchmark reverse iterator traversal
 static void BM_ListReverseTraversal(benchmark::State &state) {
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
     int value = 42;
     for (size_t i = 0; i < 1000; ++i) {
         list_push_back(list, &value);
     }
 
     for (auto _ : state) {
-        list_node_t *it = list_rbegin(list);
+        DSCListNode *it = list_rbegin(list);
         while (it != list_rend(list)) {
             benchmark::DoNotOptimize(it);
             it = it->prev;
@@ -381,4 +383,48 @@ static void BM_StdListReverseTraversal(benchmark::State &state) {
 }
 BENCHMARK(BM_StdListReverseTraversal)->Range(1 << 10, 1 << 20);
 
+// Benchmark sorting random elements by relinking nodes
+static void BM_ListSort(benchmark::State &state) {
+    std::mt19937 gen(42);
+    std::vector<int> values(state.range(0));
+    for (int &value : values) value = static_cast<int>(gen());
+    DSCList *list = list_create(sizeof(int));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        list_clear(list);
+        for (int &value : values) list_push_back(list, &value);
+        state.ResumeTiming();
+
+        list_sort(list, dsc_compare_int);
+        benchmark::DoNotOptimize(list_begin(list));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    list_destroy(list);
+}
+BENCHMARK(BM_ListSort)->Range(1 << 10, 1 << 20);
+
+// Benchmark std::list::sort on the same input
+static void BM_StdListSort(benchmark::State &state) {
+    std::mt19937 gen(42);
+    std::vector<int> values(state.range(0));
+    for (int &value : values) value = static_cast<int>(gen());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::list<int> list(values.begin(), values.end());
+        state.ResumeTiming();
+
+        list.sort();
+        benchmark::DoNotOptimize(list.front());
+
+        state.PauseTiming();
+        list.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdListSort)->Range(1 << 10, 1 << 20);
+
 BENCHMARK_MAIN();
@@ -1,13 +1,19 @@
 #include <benchmark/benchmark.h>
 
+#include <cstdint>
+#include <mutex>
+#include <numeric>
 #include <queue>
 #include <random>
+#include <thread>
+#include <vector>
 
+#include "libdsc/mpmc_queue.h"
 #include "libdsc/queue.h"
 
 // Benchmark size operation
 static void BM_QueueSize(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
     int value = 42;
     for (size_t i = 0; i < 1000; ++i) {
         queue_push(queue, &value);
@@ -36,7 +42,7 @@ BENCHMARK(BM_StdQueueSize)->Range(1 << 10, 1 << 20);
 
 // Benchmark empty check
 static void BM_QueueEmpty(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
 
     for (auto _ : state) {
         benchmark::DoNotOptimize(queue_empty(queue));
@@ -58,7 +64,7 @@ BENCHMARK(BM_StdQueueEmpty)->Range(1 << 10, 1 << 20);
 
 // Benchmark back access
 static void BM_QueueBack(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
     int value = 42;
     queue_push(queue, &value);
 
@@ -83,7 +89,7 @@ BENCHMARK(BM_StdQueueBack)->Range(1 << 10, 1 << 20);
 
 // Benchmark clear operation
 static void BM_QueueClear(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
     int value = 42;
 
     for (auto _ : state) {
@@ -122,7 +128,7 @@ BENCHMARK(BM_StdQueueClear)->Range(1 << 10, 1 << 20);
 
 // Benchmark reserve operation
 static void BM_QueueReserve(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
 
     for (auto _ : state) {
         benchmark::DoNotOptimize(queue_reserve(queue, state.range(0)));
@@ -134,7 +140,7 @@ BENCHMARK(BM_QueueReserve)->Range(1 << 10, 1 << 20);
 
 // Benchmark push
 static void BM_QueuePush(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
 
     for (auto _ : state) {
         int value = 42;
@@ -159,7 +165,7 @@ BENCHMARK(BM_StdQueuePush)->Range(1, 1 << 20);
 
 // Benchmark push and pop
 static void BM_QueuePushPop(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
 
     for (auto _ : state) {
         int value = 42;
@@ -186,7 +192,7 @@ BENCHMARK(BM_StdQueuePushPop)->Range(1, 1 << 20);
 
 // Benchmark front access
 static void BM_QueueFront(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
     int value = 42;
     queue_push(queue, &value);
 
@@ -212,7 +218,7 @@ BENCHMARK(BM_StdQueueFront)->Range(1 << 10, 1 << 20);
 
 // Benchmark push with pre-reserved capacity
 static void BM_QueuePushReserved(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
     queue_reserve(queue, state.range(0));
     int value = 42;
 
@@ -248,7 +254,7 @@ BENCHMARK(BM_StdQueuePushReserved)->Range(1 << 10, 1 << 20);
 
 // Benchmark alternating push/pop pattern
 static void BM_QueueAlternating(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
     queue_reserve(queue, state.range(0) / 2);  // Reserve half capacity
     int value = 42;
     bool push = true;
@@ -290,7 +296,7 @@ BENCHMARK(BM_StdQueueAlternating)->Range(1 << 10, 1 << 20);
 
 // Benchmark circular buffer behavior
 static void BM_QueueCircularBuffer(benchmark::State &state) {
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
     queue_reserve(queue, state.range(0));
     int value = 42;
 
@@ -337,4 +343,150 @@ static void BM_StdQueueCircularBuffer(benchmark::State &state) {
 }
 BENCHMARK(BM_StdQueueCircularBuffer)->Range(1 << 10, 1 << 20);
 
+// Benchmark draining a batch element by element
+static void BM_QueueDrainPop(benchmark::State &state) {
+    DSCQueue *queue = queue_create(sizeof(int));
+    queue_reserve(queue, state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int i = 0; i < state.range(0); ++i) queue_push(queue, &i);
+        state.ResumeTiming();
+
+        long sum = 0;
+        while (!queue_empty(queue)) {
+            sum += *static_cast<int *>(queue_front(queue));
+            queue_pop(queue);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    queue_destroy(queue);
+}
+BENCHMARK(BM_QueueDrainPop)->Range(1 << 10, 1 << 16);
+
+// Benchmark draining a batch in place through its spans
+static void BM_QueueDrainSpan(benchmark::State &state) {
+    DSCQueue *queue = queue_create(sizeof(int));
+    queue_reserve(queue, state.range(0));
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int i = 0; i < state.range(0); ++i) queue_push(queue, &i);
+        state.ResumeTiming();
+
+        long sum = 0;
+        DSCQueueSpan spans[2];
+        size_t count = queue_front_span(queue, spans);
+        for (size_t i = 0; i < count; ++i) {
+            int const *values = static_cast<int const *>(spans[i].data);
+            for (size_t j = 0; j < spans[i].count; ++j) sum += values[j];
+        }
+        queue_consume(queue, queue_size(queue));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    queue_destroy(queue);
+}
+BENCHMARK(BM_QueueDrainSpan)->Range(1 << 10, 1 << 16);
+
+// Benchmark moving a batch through the queue one element at a time
+static void BM_QueueBatchLoop(benchmark::State &state) {
+    DSCQueue *queue = queue_create(sizeof(int));
+    std::vector<int> in(state.range(0)), out(state.range(0));
+    std::iota(in.begin(), in.end(), 0);
+
+    for (auto _ : state) {
+        for (int const &value : in) queue_push(queue, &value);
+        for (int &value : out) {
+            value = *static_cast<int *>(queue_front(queue));
+            queue_pop(queue);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    queue_destroy(queue);
+}
+BENCHMARK(BM_QueueBatchLoop)->Range(1 << 6, 1 << 16);
+
+// Benchmark moving the same batch with queue_push_n() and queue_pop_n()
+static void BM_QueueBatchBulk(benchmark::State &state) {
+    DSCQueue *queue = queue_create(sizeof(int));
+    std::vector<int> in(state.range(0)), out(state.range(0));
+    std::iota(in.begin(), in.end(), 0);
+
+    for (auto _ : state) {
+        queue_push_n(queue, in.data(), in.size());
+        queue_pop_n(queue, out.data(), out.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    queue_destroy(queue);
+}
+BENCHMARK(BM_QueueBatchBulk)->Range(1 << 6, 1 << 16);
+
+// Every thread pushes one element and pops one per iteration, so the
+// queue stays shallow and producers and consumers contend on both ends.
+// Thread 0 sets up before the threads start timing and tears down after
+// they stop; benchmark synchronizes around both.
+static DSCMpmcQueue *g_mpmc;
+static DSCQueue *g_locked;
+static std::mutex g_lock;
+
+static void BM_MpmcQueuePushPop(benchmark::State &state) {
+    if (state.thread_index() == 0) {
+        g_mpmc = mpmc_queue_create(sizeof(uint64_t), 1024);
+    }
+
+    uint64_t value = state.thread_index();
+    for (auto _ : state) {
+        while (mpmc_queue_push(g_mpmc, &value) != DSC_ERROR_OK) {
+            std::this_thread::yield();
+        }
+        // Another thread may have claimed a slot before us and not have
+        // filled it yet.
+        while (mpmc_queue_pop(g_mpmc, &value) != DSC_ERROR_OK) {
+            std::this_thread::yield();
+        }
+    }
+    benchmark::DoNotOptimize(value);
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        mpmc_queue_destroy(g_mpmc);
+    }
+}
+BENCHMARK(BM_MpmcQueuePushPop)->ThreadRange(1, 16)->UseRealTime();
+
+// Baseline: DSCQueue behind one mutex
+static void BM_LockedQueuePushPop(benchmark::State &state) {
+    if (state.thread_index() == 0) {
+        g_locked = queue_create(sizeof(uint64_t));
+    }
+
+    uint64_t value = state.thread_index();
+    for (auto _ : state) {
+        {
+            std::lock_guard<std::mutex> guard(g_lock);
+            queue_push(g_locked, &value);
+        }
+        {
+            std::lock_guard<std::mutex> guard(g_lock);
+            value = *static_cast<uint64_t *>(queue_front(g_locked));
+            queue_pop(g_locked);
+        }
+    }
+    benchmark::DoNotOptimize(value);
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        queue_destroy(g_locked);
+    }
+}
+BENCHMARK(BM_LockedQueuePushPop)->ThreadRange(1, 16)->UseRealTime();
+
 BENCHMARK_MAIN();
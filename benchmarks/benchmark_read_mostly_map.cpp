@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <shared_mutex>
+
+#include "libdsc/read_mostly_map.h"
+#include "libdsc/unordered_map.h"
+
+static constexpr uint64_t kKeys = 1 << 16;
+
+static DSCUnorderedMap *g_locked;
+static std::shared_mutex g_lock;
+
+static DSCError fill(DSCUnorderedMap *table, void *context) {
+    (void)context;
+    for (uint64_t key = 0; key < kKeys; ++key) {
+        DSCError err = unordered_map_insert(table, &key, &key);
+        if (err != DSC_ERROR_OK) return err;
+    }
+    return DSC_ERROR_OK;
+}
+
+// Every thread registers before the timed loop starts, so the map must
+// exist before any of them runs; it is built once and kept for the
+// lifetime of the process.
+static DSCReadMostlyMap *shared_read_mostly_map() {
+    static DSCReadMostlyMap *map = [] {
+        DSCReadMostlyMap *m = read_mostly_map_create(
+            sizeof(uint64_t), sizeof(uint64_t), nullptr, nullptr);
+        read_mostly_map_update(m, fill, nullptr);
+        return m;
+    }();
+    return map;
+}
+
+// Lookups only: this is the path read-mostly tables are built for.
+static void BM_ReadMostlyMapFind(benchmark::State &state) {
+    DSCReadMostlyReader *reader =
+        read_mostly_map_register(shared_read_mostly_map());
+    std::mt19937_64 gen(state.thread_index());
+    for (auto _ : state) {
+        uint64_t key = gen() % kKeys;
+        read_mostly_map_read_lock(reader);
+        benchmark::DoNotOptimize(read_mostly_map_find(reader, &key));
+        read_mostly_map_read_unlock(reader);
+    }
+    read_mostly_map_unregister(reader);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReadMostlyMapFind)->ThreadRange(1, 16)->UseRealTime();
+
+// Baseline: the same lookups under a shared reader-writer lock.
+static void BM_RwLockedUnorderedMapFind(benchmark::State &state) {
+    if (state.thread_index() == 0) {
+        g_locked = unordered_map_create(sizeof(uint64_t), sizeof(uint64_t),
+                                        nullptr, nullptr);
+        fill(g_locked, nullptr);
+    }
+
+    std::mt19937_64 gen(state.thread_index());
+    for (auto _ : state) {
+        uint64_t key = gen() % kKeys;
+        std::shared_lock<std::shared_mutex> guard(g_lock);
+        benchmark::DoNotOptimize(unordered_map_find(g_locked, &key));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        unordered_map_destroy(g_locked);
+    }
+}
+BENCHMARK(BM_RwLockedUnorderedMapFind)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "libdsc/queue.h"
+#include "libdsc/spsc_queue.h"
+
+// Thread 0 produces and thread 1 consumes. Every iteration moves one
+// batch of state.range(0) elements through the queue; both threads run
+// the same number of iterations, so the consumer always drains exactly
+// what the producer pushed. A side that cannot make progress yields, so
+// the numbers stay meaningful when both threads share a core.
+//
+// Thread 0 sets up before the threads start timing and tears down after
+// they stop; benchmark synchronizes around both.
+static constexpr size_t kCapacity = 4096;
+
+static DSCSpscQueue *g_spsc;
+static DSCQueue *g_locked;
+static std::mutex g_lock;
+
+// One element per call
+static void BM_SpscQueuePushPop(benchmark::State &state) {
+    if (state.thread_index() == 0) {
+        g_spsc = spsc_queue_create(sizeof(uint64_t), kCapacity);
+    }
+
+    size_t const batch = state.range(0);
+    uint64_t value = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < batch;) {
+            DSCError error = state.thread_index() == 0
+                                 ? spsc_queue_push(g_spsc, &value)
+                                 : spsc_queue_pop(g_spsc, &value);
+            if (error == DSC_ERROR_OK) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+    benchmark::DoNotOptimize(value);
+    state.SetItemsProcessed(state.iterations() * batch);
+
+    if (state.thread_index() == 0) {
+        spsc_queue_destroy(g_spsc);
+    }
+}
+BENCHMARK(BM_SpscQueuePushPop)->Arg(1024)->Threads(2)->UseRealTime();
+
+// Bulk transfers of up to state.range(0) elements per call
+static void BM_SpscQueueBulk(benchmark::State &state) {
+    if (state.thread_index() == 0) {
+        g_spsc = spsc_queue_create(sizeof(uint64_t), kCapacity);
+    }
+
+    size_t const batch = state.range(0);
+    std::vector<uint64_t> buffer(batch);
+    for (auto _ : state) {
+        for (size_t done = 0; done < batch;) {
+            size_t moved =
+                state.thread_index() == 0
+                    ? spsc_queue_push_n(g_spsc, buffer.data() + done,
+                                        batch - done)
+                    : spsc_queue_pop_n(g_spsc, buffer.data() + done,
+                                       batch - done);
+            if (moved == 0) std::this_thread::yield();
+            done += moved;
+        }
+    }
+    benchmark::DoNotOptimize(buffer.data());
+    state.SetItemsProcessed(state.iterations() * batch);
+
+    if (state.thread_index() == 0) {
+        spsc_queue_destroy(g_spsc);
+    }
+}
+BENCHMARK(BM_SpscQueueBulk)
+    ->RangeMultiplier(4)
+    ->Range(16, 1024)
+    ->Threads(2)
+    ->UseRealTime();
+
+// Baseline: DSCQueue behind a mutex
+static void BM_LockedQueuePushPop(benchmark::State &state) {
+    if (state.thread_index() == 0) {
+        g_locked = queue_create(sizeof(uint64_t));
+    }
+
+    size_t const batch = state.range(0);
+    uint64_t value = 0;
+    for (auto _ : state) {
+        for (size_t i = 0; i < batch;) {
+            std::lock_guard<std::mutex> guard(g_lock);
+            if (state.thread_index() == 0) {
+                if (queue_push(g_locked, &value) == DSC_ERROR_OK) ++i;
+            } else if (!queue_empty(g_locked)) {
+                value = *static_cast<uint64_t *>(queue_front(g_locked));
+                queue_pop(g_locked);
+                ++i;
+            }
+        }
+    }
+    benchmark::DoNotOptimize(value);
+    state.SetItemsProcessed(state.iterations() * batch);
+
+    if (state.thread_index() == 0) {
+        queue_destroy(g_locked);
+    }
+}
+BENCHMARK(BM_LockedQueuePushPop)->Arg(1024)->Threads(2)->UseRealTime();
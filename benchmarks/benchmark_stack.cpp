@@ -1,6 +1,8 @@
 #include <benchmark/benchmark.h>
 
+#include <numeric>
 #include <stack>
+#include <vector>
 
 #include "libdsc/stack.h"
 
@@ -316,4 +318,41 @@ static void BM_StdStackPushSized(benchmark::State &state) {
 }
 BENCHMARK(BM_StdStackPushSized)->Range(1 << 10, 1 << 20);
 
+// Benchmark moving a batch through the stack one element at a time
+static void BM_StackBatchLoop(benchmark::State &state) {
+    DSCStack *stack = stack_create(sizeof(int));
+    std::vector<int> in(state.range(0)), out(state.range(0));
+    std::iota(in.begin(), in.end(), 0);
+
+    for (auto _ : state) {
+        for (int const &value : in) stack_push(stack, &value);
+        for (auto it = out.rbegin(); it != out.rend(); ++it) {
+            *it = *static_cast<int *>(stack_top(stack));
+            stack_pop(stack);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    stack_destroy(stack);
+}
+BENCHMARK(BM_StackBatchLoop)->Range(1 << 6, 1 << 16);
+
+// Benchmark moving the same batch with stack_push_n() and stack_pop_n()
+static void BM_StackBatchBulk(benchmark::State &state) {
+    DSCStack *stack = stack_create(sizeof(int));
+    std::vector<int> in(state.range(0)), out(state.range(0));
+    std::iota(in.begin(), in.end(), 0);
+
+    for (auto _ : state) {
+        stack_push_n(stack, in.data(), in.size());
+        stack_pop_n(stack, out.data(), out.size());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    stack_destroy(stack);
+}
+BENCHMARK(BM_StackBatchBulk)->Range(1 << 6, 1 << 16);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "libdsc/typed_hashmap.h"
+#include "libdsc/typed_vector.h"
+#include "libdsc/unordered_map.h"
+#include "libdsc/vector.h"
+
+DSC_DEFINE_VECTOR(int_vector, int)
+DSC_DEFINE_HASHMAP(u64_u32, uint64_t, uint32_t, dsc_typed_hash_int,
+                   dsc_typed_equal)
+
+static size_t uint64_hash(void const *key) {
+    return static_cast<size_t>(*static_cast<uint64_t const *>(key));
+}
+
+static int uint64_compare(void const *a, void const *b) {
+    uint64_t x = *static_cast<uint64_t const *>(a);
+    uint64_t y = *static_cast<uint64_t const *>(b);
+    return x < y ? -1 : x > y;
+}
+
+static std::vector<uint64_t> random_keys(uint64_t n) {
+    std::mt19937_64 gen(42);
+    std::vector<uint64_t> keys(1 << 16);
+    for (auto &key : keys) key = gen() % n;
+    return keys;
+}
+
+static void BM_TypedVectorPushBack(benchmark::State &state) {
+    for (auto _ : state) {
+        int_vector *vec = int_vector_create();
+        for (int i = 0; i < state.range(0); ++i) {
+            int_vector_push_back(vec, i);
+        }
+        benchmark::DoNotOptimize(vec->data);
+        int_vector_destroy(vec);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TypedVectorPushBack)->Range(1 << 10, 1 << 20);
+
+// Baseline: the same pushes through the generic vector.
+static void BM_GenericVectorPushBack(benchmark::State &state) {
+    for (auto _ : state) {
+        DSCVector *vec = vector_create(sizeof(int));
+        for (int i = 0; i < state.range(0); ++i) {
+            vector_push_back(vec, &i);
+        }
+        benchmark::DoNotOptimize(vec->data);
+        vector_destroy(vec);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenericVectorPushBack)->Range(1 << 10, 1 << 20);
+
+static void BM_TypedHashMapInsert(benchmark::State &state) {
+    for (auto _ : state) {
+        u64_u32 *map = u64_u32_create();
+        for (uint64_t key = 0; key < static_cast<uint64_t>(state.range(0));
+             ++key) {
+            u64_u32_insert(map, key, static_cast<uint32_t>(key));
+        }
+        benchmark::DoNotOptimize(map->size);
+        u64_u32_destroy(map);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TypedHashMapInsert)->Range(1 << 10, 1 << 20);
+
+// Baseline: the same inserts through the generic map, with a hash and
+// comparison function called through pointers.
+static void BM_GenericHashMapInsert(benchmark::State &state) {
+    for (auto _ : state) {
+        DSCUnorderedMap *map = unordered_map_create(
+            sizeof(uint64_t), sizeof(uint32_t), uint64_hash, uint64_compare);
+        for (uint64_t key = 0; key < static_cast<uint64_t>(state.range(0));
+             ++key) {
+            uint32_t value = static_cast<uint32_t>(key);
+            unordered_map_insert(map, &key, &value);
+        }
+        benchmark::DoNotOptimize(unordered_map_size(map));
+        unordered_map_destroy(map);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_GenericHashMapInsert)->Range(1 << 10, 1 << 20);
+
+static void BM_TypedHashMapFind(benchmark::State &state) {
+    u64_u32 *map = u64_u32_create();
+    for (uint64_t key = 0; key < static_cast<uint64_t>(state.range(0));
+         ++key) {
+        u64_u32_insert(map, key, static_cast<uint32_t>(key));
+    }
+    std::vector<uint64_t> keys = random_keys(state.range(0));
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            u64_u32_find(map, keys[i++ & (keys.size() - 1)]));
+    }
+
+    u64_u32_destroy(map);
+}
+BENCHMARK(BM_TypedHashMapFind)->Range(1 << 10, 1 << 20);
+
+static void BM_GenericHashMapFind(benchmark::State &state) {
+    DSCUnorderedMap *map = unordered_map_create(
+        sizeof(uint64_t), sizeof(uint32_t), uint64_hash, uint64_compare);
+    for (uint64_t key = 0; key < static_cast<uint64_t>(state.range(0));
+         ++key) {
+        uint32_t value = static_cast<uint32_t>(key);
+        unordered_map_insert(map, &key, &value);
+    }
+    std::vector<uint64_t> keys = random_keys(state.range(0));
+
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            unordered_map_find(map, &keys[i++ & (keys.size() - 1)]));
+    }
+
+    unordered_map_destroy(map);
+}
+BENCHMARK(BM_GenericHashMapFind)->Range(1 << 10, 1 << 20);
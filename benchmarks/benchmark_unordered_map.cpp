@@ -1,8 +1,11 @@
 #include <benchmark/benchmark.h>
 
+#include <cstdio>
+#include <filesystem>
 #include <random>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "libdsc/unordered_map.h"
 
@@ -40,7 +43,7 @@ static std::string random_string(size_t length) {
 
 // Benchmark insertion
 static void BM_UnorderedMapInsert(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
 
     for (auto _ : state) {
@@ -66,7 +69,7 @@ BENCHMARK(BM_StdUnorderedMapInsert)->Range(1, 1 << 20);
 
 // Benchmark find
 static void BM_UnorderedMapFind(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
 
     // Pre-populate map
@@ -116,7 +119,7 @@ BENCHMARK(BM_StdUnorderedMapFind)->Range(1 << 10, 1 << 20);
 
 // Benchmark size operation
 static void BM_UnorderedMapSize(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
 
     // Pre-populate map
@@ -151,7 +154,7 @@ BENCHMARK(BM_StdUnorderedMapSize)->Range(1 << 10, 1 << 20);
 
 // Benchmark empty check
 static void BM_UnorderedMapEmpty(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
 
     for (auto _ : state) {
@@ -174,7 +177,7 @@ BENCHMARK(BM_StdUnorderedMapEmpty)->Range(1 << 10, 1 << 20);
 
 // Benchmark clear operation
 static void BM_UnorderedMapClear(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
 
     for (auto _ : state) {
@@ -213,7 +216,7 @@ BENCHMARK(BM_StdUnorderedMapClear)->Range(1 << 10, 1 << 20);
 
 // Benchmark reserve operation
 static void BM_UnorderedMapReserve(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
 
     for (auto _ : state) {
@@ -237,7 +240,7 @@ BENCHMARK(BM_StdUnorderedMapReserve)->Range(1 << 10, 1 << 20);
 
 // Benchmark erase operation
 static void BM_UnorderedMapErase(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
     std::vector<std::string> keys;
 
@@ -295,7 +298,7 @@ BENCHMARK(BM_StdUnorderedMapErase)->Range(1 << 10, 1 << 20);
 
 // Benchmark insert with pre-reserved capacity
 static void BM_UnorderedMapInsertReserved(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
     unordered_map_reserve(map, state.range(0));
 
@@ -334,7 +337,7 @@ BENCHMARK(BM_StdUnorderedMapInsertReserved)->Range(1 << 10, 1 << 20);
 
 // Benchmark mixed operations pattern
 static void BM_UnorderedMapMixedOps(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
     std::vector<std::string> keys;
     std::random_device rd;
@@ -415,7 +418,7 @@ BENCHMARK(BM_StdUnorderedMapMixedOps)->Range(1 << 10, 1 << 20);
 
 // Benchmark collision handling (keys with same hash)
 static void BM_UnorderedMapCollisions(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
     std::vector<std::string> colliding_keys;
 
@@ -469,7 +472,7 @@ BENCHMARK(BM_StdUnorderedMapCollisions)->Range(1 << 8, 1 << 16);
 
 // Benchmark load factor performance
 static void BM_UnorderedMapLoadFactor(benchmark::State &state) {
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
     size_t target_size = state.range(0);
     unordered_map_reserve(map, target_size / 2);  // Force higher load factor
@@ -510,4 +513,87 @@ static void BM_StdUnorderedMapLoadFactor(benchmark::State &state) {
 }
 BENCHMARK(BM_StdUnorderedMapLoadFactor)->Range(1 << 10, 1 << 20);
 
+// Builds an int map of the given size and a random sequence of its keys
+static DSCUnorderedMap *make_int_map(size_t size, std::vector<uint64_t> *keys) {
+    DSCUnorderedMap *map = unordered_map_create(
+        sizeof(uint64_t), sizeof(uint64_t), nullptr, nullptr);
+    std::mt19937_64 gen(42);
+    for (uint64_t i = 0; i < size; ++i) {
+        unordered_map_insert(map, &i, &i);
+    }
+    keys->resize(4096);
+    for (auto &key : *keys) {
+        key = gen() % size;
+    }
+    return map;
+}
+
+// Benchmark random lookups one at a time
+static void BM_UnorderedMapFindSerial(benchmark::State &state) {
+    std::vector<uint64_t> keys;
+    DSCUnorderedMap *map = make_int_map(state.range(0), &keys);
+
+    for (auto _ : state) {
+        for (auto const &key : keys) {
+            benchmark::DoNotOptimize(unordered_map_find(map, &key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+
+    unordered_map_destroy(map);
+}
+BENCHMARK(BM_UnorderedMapFindSerial)->Range(1 << 12, 1 << 24);
+
+// Benchmark the same lookups through the prefetching batch API
+static void BM_UnorderedMapFindBatch(benchmark::State &state) {
+    std::vector<uint64_t> keys;
+    DSCUnorderedMap *map = make_int_map(state.range(0), &keys);
+    std::vector<void *> values(keys.size());
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(unordered_map_find_batch(
+            map, keys.data(), keys.size(), values.data()));
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+
+    unordered_map_destroy(map);
+}
+BENCHMARK(BM_UnorderedMapFindBatch)->Range(1 << 12, 1 << 24);
+
+// Startup cost: rebuilding a map entry by entry
+static void BM_UnorderedMapRebuild(benchmark::State &state) {
+    for (auto _ : state) {
+        DSCUnorderedMap *map = unordered_map_create(
+            sizeof(uint64_t), sizeof(uint64_t), nullptr, nullptr);
+        for (uint64_t i = 0; i < static_cast<uint64_t>(state.range(0)); ++i) {
+            unordered_map_insert(map, &i, &i);
+        }
+        benchmark::DoNotOptimize(map);
+        unordered_map_destroy(map);
+    }
+}
+BENCHMARK(BM_UnorderedMapRebuild)->Range(1 << 12, 1 << 22);
+
+// Startup cost: mapping a saved copy of the same map and looking up a key
+static void BM_UnorderedMapOpenMapped(benchmark::State &state) {
+    std::vector<uint64_t> keys;
+    DSCUnorderedMap *map = make_int_map(state.range(0), &keys);
+    std::string path =
+        (std::filesystem::temp_directory_path() / "libdsc_bench_map.dsc")
+            .string();
+    unordered_map_save(map, path.c_str());
+    unordered_map_destroy(map);
+
+    for (auto _ : state) {
+        DSCUnorderedMap *mapped = unordered_map_open_mapped(
+            path.c_str(), sizeof(uint64_t), sizeof(uint64_t), nullptr,
+            nullptr);
+        benchmark::DoNotOptimize(unordered_map_find(mapped, &keys[0]));
+        unordered_map_destroy(mapped);
+    }
+
+    std::remove(path.c_str());
+}
+BENCHMARK(BM_UnorderedMapOpenMapped)->Range(1 << 12, 1 << 22);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+
+#include <list>
+#include <vector>
+
+#include "libdsc/list.h"
+#include "libdsc/unrolled_list.h"
+
+// Benchmark node-wise traversal
+static void BM_UnrolledListBlockTraversal(benchmark::State &state) {
+    DSCUnrolledList *list = unrolled_list_create(sizeof(int));
+    for (int i = 0; i < state.range(0); ++i) {
+        unrolled_list_push_back(list, &i);
+    }
+
+    for (auto _ : state) {
+        long sum = 0;
+        DSCUnrolledListNode *node = nullptr;
+        void *elements;
+        size_t count;
+        while (unrolled_list_next_block(list, &node, &elements, &count)) {
+            int const *values = static_cast<int const *>(elements);
+            for (size_t i = 0; i < count; ++i) sum += values[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    unrolled_list_destroy(list);
+}
+BENCHMARK(BM_UnrolledListBlockTraversal)->Range(1 << 10, 1 << 20);
+
+// Benchmark element-wise traversal through iterators
+static void BM_UnrolledListTraversal(benchmark::State &state) {
+    DSCUnrolledList *list = unrolled_list_create(sizeof(int));
+    for (int i = 0; i < state.range(0); ++i) {
+        unrolled_list_push_back(list, &i);
+    }
+
+    for (auto _ : state) {
+        long sum = 0;
+        for (auto it = unrolled_list_begin(list); it.node;
+             unrolled_list_advance(&it)) {
+            sum += *static_cast<int *>(unrolled_list_get(list, it));
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    unrolled_list_destroy(list);
+}
+BENCHMARK(BM_UnrolledListTraversal)->Range(1 << 10, 1 << 20);
+
+// Baseline: DSCList traversal, one node per element
+static void BM_ListTraversal(benchmark::State &state) {
+    DSCList *list = list_create(sizeof(int));
+    for (int i = 0; i < state.range(0); ++i) {
+        list_push_back(list, &i);
+    }
+
+    for (auto _ : state) {
+        long sum = 0;
+        for (DSCListNode *node = list_begin(list); node; node = node->next) {
+            sum += *(int *)node->data;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+
+    list_destroy(list);
+}
+BENCHMARK(BM_ListTraversal)->Range(1 << 10, 1 << 20);
+
+// Baseline: std::vector traversal
+static void BM_StdVectorTraversal(benchmark::State &state) {
+    std::vector<int> vec;
+    for (int i = 0; i < state.range(0); ++i) {
+        vec.push_back(i);
+    }
+
+    for (auto _ : state) {
+        long sum = 0;
+        for (int value : vec) sum += value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdVectorTraversal)->Range(1 << 10, 1 << 20);
+
+// Benchmark insertion and removal in the middle through an iterator
+static void BM_UnrolledListInsertErase(benchmark::State &state) {
+    DSCUnrolledList *list = unrolled_list_create(sizeof(int));
+    for (int i = 0; i < state.range(0); ++i) {
+        unrolled_list_push_back(list, &i);
+    }
+    DSCUnrolledListIterator it =
+        unrolled_list_iterator_at(list, state.range(0) / 2);
+
+    int value = 42;
+    for (auto _ : state) {
+        unrolled_list_insert(list, &it, &value);
+        unrolled_list_erase(list, &it);
+    }
+
+    unrolled_list_destroy(list);
+}
+BENCHMARK(BM_UnrolledListInsertErase)->Range(1 << 10, 1 << 20);
+
+// Baseline: std::list insertion and removal in the middle
+static void BM_StdListInsertErase(benchmark::State &state) {
+    std::list<int> list;
+    for (int i = 0; i < state.range(0); ++i) {
+        list.push_back(i);
+    }
+    auto it = std::next(list.begin(), state.range(0) / 2);
+
+    for (auto _ : state) {
+        it = list.insert(it, 42);
+        it = list.erase(it);
+        benchmark::DoNotOptimize(it);
+    }
+}
+BENCHMARK(BM_StdListInsertErase)->Range(1 << 10, 1 << 20);
+
+BENCHMARK_MAIN();
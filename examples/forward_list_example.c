@@ -3,7 +3,7 @@
 
 int main() {
     // Create a forward list of integers
-    dsc_forward_list *list = forward_list_create(sizeof(int));
+    DSCForwardList *list = forward_list_create(sizeof(int));
     if (!list) {
         printf("Failed to create forward list\n");
         return EXIT_FAILURE;
@@ -25,7 +25,7 @@ int main() {
 
     // Print all values (will be in reverse order: 5, 4, 3, 2, 1)
     printf("\nList contents:\n");
-    forward_list_node_t *current = forward_list_begin(list);
+    DSCForwardListNode *current = forward_list_begin(list);
     while (current) {
         printf("%d ", *(int *)current->data);
         current = current->next;
@@ -34,7 +34,7 @@ int main() {
 
     // Insert a value after the first node
     int value = 42;
-    forward_list_node_t *pos = forward_list_begin(list);
+    DSCForwardListNode *pos = forward_list_begin(list);
     if (forward_list_insert_after(list, pos, &value) == DSC_ERROR_OK) {
         printf("\nInserted %d after first node\n", value);
     }
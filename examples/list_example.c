@@ -3,7 +3,7 @@
 
 int main() {
     // Create a list of integers
-    dsc_list *list = list_create(sizeof(int));
+    DSCList *list = list_create(sizeof(int));
     if (!list) {
         printf("Failed to create list\n");
         return EXIT_FAILURE;
@@ -34,7 +34,7 @@ int main() {
 
     // Print all values forward
     printf("\nList contents (forward):\n");
-    list_node_t *current = list_begin(list);
+    DSCListNode *current = list_begin(list);
     while (current) {
         printf("%d ", *(int *)current->data);
         current = current->next;
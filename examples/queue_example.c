@@ -3,7 +3,7 @@
 
 int main() {
     // Create a queue of integers
-    dsc_queue *queue = queue_create(sizeof(int));
+    DSCQueue *queue = queue_create(sizeof(int));
     if (!queue) {
         printf("Failed to create queue\n");
         return EXIT_FAILURE;
@@ -22,7 +22,7 @@ static int string_compare(void const *a, void const *b) {
 
 int main() {
     // Create a map with string keys and integer values
-    dsc_unordered_map *map = unordered_map_create(sizeof(char *), sizeof(int),
+    DSCUnorderedMap *map = unordered_map_create(sizeof(char *), sizeof(int),
                                                   string_hash, string_compare);
     if (!map) {
         printf("Failed to create map\n");
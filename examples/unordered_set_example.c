@@ -22,7 +22,7 @@ static int string_compare(void const *a, void const *b) {
 
 int main() {
     // Create a set of strings
-    dsc_unordered_set *set =
+    DSCUnorderedSet *set =
         unordered_set_create(sizeof(char *), string_hash, string_compare);
     if (!set) {
         printf("Failed to create set\n");
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSC_ARENA_H_
+#define DSC_ARENA_H_
+
+#include <stddef.h>
+
+#include "libdsc/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Chunk size used when arena_create() is given 0
+#define DSC_ARENA_DEFAULT_CHUNK_SIZE ((size_t)64 * 1024)
+
+/// @brief Chunk of arena memory (internal)
+typedef struct DSCArenaChunk DSCArenaChunk;
+
+/// @brief Chunked bump allocator
+///
+/// Hands out memory by advancing a pointer through large chunks obtained
+/// from malloc(), so an allocation is a bounds check and an addition. Blocks
+/// are not freed one by one: arena_reset() releases everything at once in
+/// O(1), and arena_rollback() releases everything allocated since an
+/// arena_checkpoint(). Chunks are kept for reuse, so an arena that is reset
+/// between requests stops calling malloc() once it has reached its peak
+/// size.
+///
+/// Containers use an arena through arena_allocator():
+///
+/// ```c
+/// DSCArena *arena = arena_create(0);
+/// DSCAllocator allocator = arena_allocator(arena);
+///
+/// DSCVector *vec = vector_create_with_allocator(sizeof(int), &allocator);
+/// DSCUnorderedMap *map = unordered_map_create_with_allocator(
+///     sizeof(int), sizeof(int), NULL, NULL, &allocator);
+/// // ... handle the request; no need to destroy vec or map ...
+/// arena_reset(arena);
+/// ```
+///
+/// @note This structure should be treated as opaque. An arena is not
+///       thread-safe.
+typedef struct DSCArena {
+    DSCArenaChunk *first;   ///< Oldest chunk, where a reset restarts
+    DSCArenaChunk *current; ///< Chunk allocations are served from
+    char *ptr;              ///< Next free byte in the current chunk
+    char *end;              ///< End of the current chunk
+    size_t chunk_size;      ///< Minimum size of a new chunk in bytes
+    size_t reserved;        ///< Total bytes held in chunks
+} DSCArena;
+
+/// @brief Saved arena position, see arena_checkpoint()
+typedef struct {
+    DSCArenaChunk *chunk; ///< Chunk in use when the checkpoint was taken
+    char *ptr;            ///< Next free byte at that time
+} DSCArenaCheckpoint;
+
+/// @brief Creates a new, empty arena
+///
+/// No memory is reserved until the first allocation.
+///
+/// @param chunk_size Minimum chunk size in bytes, or 0 for
+///                   DSC_ARENA_DEFAULT_CHUNK_SIZE. Larger allocations get
+///                   a chunk of their own.
+/// @return Pointer to the new arena, or NULL on failure
+/// @note The caller is responsible for calling arena_destroy()
+DSCArena *arena_create(size_t chunk_size);
+
+/// @brief Destroys an arena and frees all of its chunks
+///
+/// Every block allocated from the arena becomes invalid.
+///
+/// @param arena Pointer to the arena to destroy (can be NULL)
+void arena_destroy(DSCArena *arena);
+
+/// @brief Allocates a block from the arena
+///
+/// The block is aligned like malloc() and stays valid until the arena is
+/// reset, rolled back past it or destroyed.
+///
+/// @param arena Pointer to the arena (must not be NULL)
+/// @param size Number of bytes to allocate
+/// @return Pointer to the block, or NULL on failure
+void *arena_allocate(DSCArena *arena, size_t size);
+
+/// @brief Releases every block allocated from the arena
+///
+/// Runs in O(1): the chunks are kept and reused by later allocations.
+///
+/// @param arena Pointer to the arena (can be NULL)
+/// @note Invalidates all checkpoints of the arena
+void arena_reset(DSCArena *arena);
+
+/// @brief Records the current arena position
+///
+/// @param arena Pointer to the arena (can be NULL)
+/// @return Checkpoint to pass to arena_rollback(), or an empty checkpoint
+///         (which rolls back to a reset) if arena is NULL
+DSCArenaCheckpoint arena_checkpoint(DSCArena const *arena);
+
+/// @brief Releases every block allocated since a checkpoint
+///
+/// Runs in O(1). Checkpoints nest: rolling back to a checkpoint
+/// invalidates those taken after it, but not those taken before.
+///
+/// @param arena Pointer to the arena (must not be NULL)
+/// @param checkpoint Checkpoint taken on this arena since its last reset
+void arena_rollback(DSCArena *arena, DSCArenaCheckpoint checkpoint);
+
+/// @brief Frees the chunks that the arena is not currently using
+///
+/// Returns memory kept for reuse after a reset or rollback to the system.
+///
+/// @param arena Pointer to the arena (can be NULL)
+void arena_trim(DSCArena *arena);
+
+/// @brief Returns the number of bytes the arena holds in chunks
+///
+/// @param arena Pointer to the arena (can be NULL)
+/// @return Total chunk capacity in bytes, or 0 if arena is NULL
+size_t arena_reserved(DSCArena const *arena);
+
+/// @brief Returns an allocator that serves containers from the arena
+///
+/// The allocator's deallocate is a no-op except for the most recent
+/// block, which is returned to the arena, and reallocate of the most
+/// recent block grows it in place when the chunk has room. A growing
+/// vector that is the arena's only user therefore never copies.
+///
+/// Containers using the allocator may be destroyed as usual, or simply
+/// abandoned when the arena is reset.
+///
+/// @param arena Pointer to the arena (must not be NULL)
+/// @return Allocator whose context is arena
+DSCAllocator arena_allocator(DSCArena *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_ARENA_H_
@@ -5,9 +5,12 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "libdsc/hash.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -24,8 +27,21 @@ typedef enum {
     DSC_ERROR_NOT_FOUND,
     DSC_ERROR_DUPLICATE,
     DSC_ERROR_OVERFLOW,
+    DSC_ERROR_READ_ONLY,
+    DSC_ERROR_IO,
+    DSC_ERROR_FULL,
 } DSCError;
 
+/// @brief Collision resolution strategy of the unordered containers
+///
+/// Group probing is the default. Robin Hood probing bounds the length of
+/// unsuccessful lookups and allows a higher load factor, at the cost of
+/// one extra byte per slot and slower inserts.
+typedef enum {
+    DSC_PROBE_GROUP = 0,   ///< Control-byte group probing, max load 0.75
+    DSC_PROBE_ROBIN_HOOD,  ///< Robin Hood linear probing, max load 0.9
+} DSCProbeMode;
+
 /// @brief Memory allocation wrapper with error checking
 ///
 /// Allocates memory using malloc() with additional error handling.
@@ -71,34 +87,108 @@ static inline void dsc_free(void *ptr) {
     }
 }
 
-/// @brief Default hash function for integers
+/// @brief Memory allocator used by a container
 ///
-/// Computes a hash value for an integer key. The key should point
-/// to an int value.
+/// Containers created with a *_create_with_allocator() function obtain
+/// every block they own (the container structure itself, element buffers,
+/// list nodes and hash tables) from the allocator. Blocks are returned
+/// with the size they were requested with, so pool and arena allocators
+/// need no per-block headers.
 ///
-/// @param key Pointer to an int value
-/// @return Hash value for the integer
-static inline size_t dsc_hash_int(void const *key) {
-    return (size_t)*(int const *)key;
+/// The allocator is copied into the container, but context must stay
+/// valid until the container is destroyed.
+typedef struct DSCAllocator {
+    /// Returns a block of size bytes aligned like malloc(), or NULL
+    void *(*allocate)(void *context, size_t size);
+    /// Resizes a block like realloc(). Can be NULL, in which case a new
+    /// block is allocated, the contents copied and the old block released.
+    void *(*reallocate)(void *context, void *ptr, size_t old_size,
+                        size_t new_size);
+    /// Releases a block. Can be NULL for allocators that release memory
+    /// in bulk, such as arenas.
+    void (*deallocate)(void *context, void *ptr, size_t size);
+    void *context;  ///< Passed to every call
+} DSCAllocator;
+
+static inline void *dsc_libc_allocate(void *context, size_t size) {
+    (void)context;
+    return malloc(size);
+}
+
+static inline void *dsc_libc_reallocate(void *context, void *ptr,
+                                        size_t old_size, size_t new_size) {
+    (void)context;
+    (void)old_size;
+    return realloc(ptr, new_size);
 }
 
-/// @brief Default hash function for strings
+static inline void dsc_libc_deallocate(void *context, void *ptr,
+                                       size_t size) {
+    (void)context;
+    (void)size;
+    free(ptr);
+}
+
+/// @brief Returns the allocator backed by malloc(), realloc() and free()
 ///
-/// Computes a hash value for a string using the djb2 algorithm.
-/// The key should point to a char* value.
+/// Used by every container created without an explicit allocator.
+static inline DSCAllocator dsc_default_allocator(void) {
+    DSCAllocator allocator = {dsc_libc_allocate, dsc_libc_reallocate,
+                              dsc_libc_deallocate, NULL};
+    return allocator;
+}
+
+/// @brief Returns true if allocator can be passed to a constructor
 ///
-/// @param key Pointer to a char* value (string)
-/// @return Hash value for the string
-static inline size_t dsc_hash_string(void const *key) {
-    char const *str = *(char const **)key;
-    size_t hash = 5381;
-    int c;
+/// NULL selects the default allocator; otherwise allocate must be set.
+static inline bool dsc_allocator_valid(DSCAllocator const *allocator) {
+    return !allocator || allocator->allocate;
+}
 
-    while ((c = (unsigned char)*str++)) {
-        hash = ((hash << 5) + hash) + c;
+/// @brief Returns a copy of allocator, or the default allocator if NULL
+static inline DSCAllocator dsc_allocator_or_default(
+    DSCAllocator const *allocator) {
+    return allocator ? *allocator : dsc_default_allocator();
+}
+
+/// @brief Allocates size bytes from allocator
+static inline void *dsc_allocate(DSCAllocator const *allocator,
+                                 size_t size) {
+    return allocator->allocate(allocator->context, size);
+}
+
+/// @brief Releases a block of size bytes obtained from allocator
+///
+/// @param ptr Block to release (can be NULL)
+static inline void dsc_deallocate(DSCAllocator const *allocator, void *ptr,
+                                  size_t size) {
+    if (ptr && allocator->deallocate) {
+        allocator->deallocate(allocator->context, ptr, size);
+    }
+}
+
+/// @brief Resizes a block obtained from allocator
+///
+/// @param ptr Block to resize, or NULL to allocate a new one
+/// @param old_size Current size of the block (0 if ptr is NULL)
+/// @param new_size Requested size in bytes
+/// @return Pointer to the resized block, or NULL on failure, in which
+///         case the original block is left untouched
+static inline void *dsc_reallocate(DSCAllocator const *allocator, void *ptr,
+                                   size_t old_size, size_t new_size) {
+    if (allocator->reallocate) {
+        return allocator->reallocate(allocator->context, ptr, old_size,
+                                     new_size);
     }
 
-    return hash;
+    void *new_ptr = dsc_allocate(allocator, new_size);
+    if (!new_ptr) return NULL;
+
+    if (ptr) {
+        memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+        dsc_deallocate(allocator, ptr, old_size);
+    }
+    return new_ptr;
 }
 
 /// @brief Default comparison function for integers
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSC_CONCURRENT_MAP_H_
+#define DSC_CONCURRENT_MAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "libdsc/common.h"
+#include "libdsc/hash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Thread-safe hash map partitioned into independently locked shards
+///
+/// The key space is split across a power-of-two number of shards by the
+/// high bits of each key's hash. Every shard is a DSCUnorderedMap guarded
+/// by its own reader-writer lock and padded to a cache line, so threads
+/// working on different shards neither contend for a lock nor share cache
+/// lines, and each shard resizes on its own without stopping the others.
+///
+/// Values are copied in and out under the shard lock: no function returns
+/// a pointer into the map, since another thread could move or erase the
+/// pair as soon as the lock is released.
+///
+/// @note The shard locks are pthread reader-writer locks, so this
+///       container requires POSIX threads.
+/// @note This structure is opaque; use the functions below.
+typedef struct DSCConcurrentMap DSCConcurrentMap;
+
+/// @brief Callback that updates a value in place under the shard lock
+///
+/// @param value Pointer to the value stored in the map
+/// @param context User pointer passed through from the caller
+typedef void (*DSCConcurrentUpdateFn)(void *value, void *context);
+
+/// @brief Creates a new concurrent map
+///
+/// @param key_size Size of each key in bytes (must be > 0)
+/// @param value_size Size of each value in bytes (must be > 0)
+/// @param hash_fn Hash function for keys, or NULL to hash the raw key bytes
+/// @param compare_fn Comparison function for keys, or NULL to compare the
+///                   raw key bytes (must be NULL exactly when hash_fn is)
+/// @param shard_count Number of shards, rounded up to a power of two, or 0
+///                    for the default of 64; more shards than threads keeps
+///                    lock collisions rare
+/// @return Pointer to the newly created map, or NULL on failure
+/// @note The caller is responsible for calling concurrent_map_destroy()
+/// @note hash_fn and compare_fn must be safe to call from several threads
+DSCConcurrentMap *concurrent_map_create(size_t key_size, size_t value_size,
+                                        size_t (*hash_fn)(void const *),
+                                        int (*compare_fn)(void const *,
+                                                          void const *),
+                                        size_t shard_count);
+
+/// @brief Destroys the concurrent map and frees its memory
+///
+/// @param map Pointer to the map to destroy (can be NULL)
+/// @note No other thread may be using the map
+void concurrent_map_destroy(DSCConcurrentMap *map);
+
+/// @brief Returns the number of key-value pairs in the map
+///
+/// @param map Pointer to the map (can be NULL)
+/// @return Number of pairs, or 0 if map is NULL
+/// @note Shards are counted one after another, so the result is only a
+///       snapshot while other threads modify the map
+size_t concurrent_map_size(DSCConcurrentMap *map);
+
+/// @brief Inserts or updates a key-value pair
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key to insert (must not be NULL)
+/// @param value Pointer to the value to store (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT map, key, or value is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed during growth
+DSCError concurrent_map_insert(DSCConcurrentMap *map, void const *key,
+                               void const *value);
+
+/// @brief Looks up a key and copies its value out
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key to search for (must not be NULL)
+/// @param value Receives a copy of the value (can be NULL to only test
+///              for the key)
+/// @return DSC_ERROR_OK if the key was found, error code otherwise
+/// @retval DSC_ERROR_INVALID_ARGUMENT map or key is NULL
+/// @retval DSC_ERROR_NOT_FOUND Key not found in map
+/// @note Lookups take the shard lock for reading and run in parallel
+DSCError concurrent_map_find(DSCConcurrentMap *map, void const *key,
+                             void *value);
+
+/// @brief Removes a key-value pair from the map
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key to remove (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT map or key is NULL
+/// @retval DSC_ERROR_NOT_FOUND Key not found in map
+DSCError concurrent_map_erase(DSCConcurrentMap *map, void const *key);
+
+/// @brief Finds a key, inserting it if absent, and updates its value
+///
+/// Inserts the key with a zero-filled value if it is absent, then calls
+/// update on the value while still holding the shard lock, so that
+/// read-modify-write patterns such as counting are atomic:
+///
+/// ```c
+/// static void increment(void *value, void *context) {
+///     (void)context;
+///     ++*(long *)value;
+/// }
+///
+/// concurrent_map_try_emplace(map, &word, increment, NULL, NULL);
+/// ```
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key (must not be NULL)
+/// @param update Callback applied to the value (can be NULL)
+/// @param context User pointer passed to update
+/// @param inserted Receives true if the key was inserted (can be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT map or key is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed during growth
+/// @note update must not call back into the map
+DSCError concurrent_map_try_emplace(DSCConcurrentMap *map, void const *key,
+                                    DSCConcurrentUpdateFn update,
+                                    void *context, bool *inserted);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_CONCURRENT_MAP_H_
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSC_DEQUE_H_
+#define DSC_DEQUE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "libdsc/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Target size of a deque block in bytes
+#define DSC_DEQUE_BLOCK_BYTES 4096
+
+/// Minimum number of elements per block, for elements too large to fit
+/// several in DSC_DEQUE_BLOCK_BYTES
+#define DSC_DEQUE_MIN_BLOCK_ELEMENTS 16
+
+/// Number of emptied blocks a deque keeps for reuse instead of freeing
+#define DSC_DEQUE_MAX_SPARE_BLOCKS 4
+
+/// @brief Double-ended queue with stable element addresses
+///
+/// Elements live in fixed-size blocks holding block_elements elements
+/// each, a power of two. A map of block pointers orders the blocks, and
+/// the elements occupy the positions [start, start + size) counted across
+/// the mapped blocks, so element i is found with a shift and a mask.
+///
+/// Adding a block at either end only moves block pointers within the map,
+/// never elements, so a pointer to an element stays valid until that
+/// element is removed or the deque is cleared or destroyed. Blocks
+/// emptied at either end are kept for reuse, up to
+/// DSC_DEQUE_MAX_SPARE_BLOCKS, so a deque used as a FIFO reaches a steady
+/// state without calling the allocator.
+///
+/// @note This structure should be treated as opaque.
+typedef struct {
+    void **map;              ///< Block pointers; the used ones are contiguous
+    size_t map_capacity;     ///< Number of slots in the map
+    size_t map_begin;        ///< Map slot of the first block
+    size_t block_count;      ///< Number of blocks in use
+    size_t start;            ///< Offset of the front element in the first block
+    size_t size;             ///< Number of elements currently stored
+    size_t element_size;     ///< Size of each element in bytes
+    size_t block_elements;   ///< Elements per block, a power of two
+    unsigned block_shift;    ///< log2(block_elements)
+    void *spare;             ///< Singly-linked list of blocks kept for reuse
+    size_t spare_count;      ///< Number of blocks in the spare list
+    DSCAllocator allocator;  ///< Source of the structure, map and blocks
+} DSCDeque;
+
+/// @brief Creates a new deque with the specified element size
+///
+/// No memory besides the structure is allocated until the first push.
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @return Pointer to the newly created deque, or NULL on failure
+/// @note The caller is responsible for calling deque_destroy()
+DSCDeque *deque_create(size_t element_size);
+
+/// @brief Creates a new deque that allocates through the given allocator
+///
+/// Like deque_create(), but the structure, the map and the blocks are
+/// obtained from allocator instead of malloc().
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param allocator Allocator to use, or NULL for the default allocator
+/// @return Pointer to the newly created deque, or NULL on failure
+DSCDeque *deque_create_with_allocator(size_t element_size,
+                                      DSCAllocator const *allocator);
+
+/// @brief Destroys the deque and frees its memory
+///
+/// @param deque Pointer to the deque to destroy (can be NULL)
+void deque_destroy(DSCDeque *deque);
+
+/// @brief Returns the number of elements in the deque
+///
+/// @param deque Pointer to the deque (can be NULL)
+/// @return Number of elements, or 0 if deque is NULL
+/// @note This operation is O(1)
+size_t deque_size(DSCDeque const *deque);
+
+/// @brief Checks if the deque is empty
+///
+/// @param deque Pointer to the deque (can be NULL)
+/// @return true if the deque is empty or NULL, false otherwise
+bool deque_empty(DSCDeque const *deque);
+
+/// @brief Copies an element to the back of the deque
+///
+/// @param deque Pointer to the deque (must not be NULL)
+/// @param element Pointer to the element to copy (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT deque or element is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @retval DSC_ERROR_OVERFLOW The map would overflow
+/// @note This operation is amortized O(1) and never moves elements
+DSCError deque_push_back(DSCDeque *deque, void const *element);
+
+/// @brief Copies an element to the front of the deque
+///
+/// @param deque Pointer to the deque (must not be NULL)
+/// @param element Pointer to the element to copy (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT deque or element is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @retval DSC_ERROR_OVERFLOW The map would overflow
+/// @note This operation is amortized O(1) and never moves elements
+DSCError deque_push_front(DSCDeque *deque, void const *element);
+
+/// @brief Removes the last element
+///
+/// @param deque Pointer to the deque (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT deque is NULL
+/// @retval DSC_ERROR_EMPTY The deque is empty
+/// @note This operation is O(1)
+DSCError deque_pop_back(DSCDeque *deque);
+
+/// @brief Removes the first element
+///
+/// @param deque Pointer to the deque (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT deque is NULL
+/// @retval DSC_ERROR_EMPTY The deque is empty
+/// @note This operation is O(1)
+DSCError deque_pop_front(DSCDeque *deque);
+
+/// @brief Returns a pointer to the element at the given index
+///
+/// @param deque Pointer to the deque (can be NULL)
+/// @param index Index of the element, 0 being the front
+/// @return Pointer to the element, or NULL if index is out of range or
+///         deque is NULL
+/// @note This operation is O(1)
+void *deque_at(DSCDeque const *deque, size_t index);
+
+/// @brief Returns a pointer to the first element
+///
+/// @param deque Pointer to the deque (can be NULL)
+/// @return Pointer to the first element, or NULL if the deque is empty or
+///         NULL
+void *deque_front(DSCDeque const *deque);
+
+/// @brief Returns a pointer to the last element
+///
+/// @param deque Pointer to the deque (can be NULL)
+/// @return Pointer to the last element, or NULL if the deque is empty or
+///         NULL
+void *deque_back(DSCDeque const *deque);
+
+/// @brief Removes all elements
+///
+/// Up to DSC_DEQUE_MAX_SPARE_BLOCKS blocks are kept for reuse and the
+/// rest are freed.
+///
+/// @param deque Pointer to the deque (can be NULL)
+/// @note This operation is O(number of blocks)
+void deque_clear(DSCDeque *deque);
+
+/// @brief Frees the blocks kept for reuse
+///
+/// @param deque Pointer to the deque (can be NULL)
+void deque_shrink_to_fit(DSCDeque *deque);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_DEQUE_H_
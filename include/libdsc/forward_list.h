@@ -4,6 +4,7 @@
 #define DSC_FORWARD_LIST_H_
 
 #include "libdsc/common.h"
+#include "libdsc/pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -11,11 +12,12 @@ extern "C" {
 
 /// @brief Node structure for forward list
 ///
-/// Each node contains data and a pointer to the next node.
-/// This structure should be treated as opaque.
+/// Each node contains a pointer to the next node, followed by the element
+/// itself, so a node is a single allocation. This structure should be
+/// treated as opaque.
 typedef struct forward_list_node {
-    void *data;                      ///< Pointer to the stored data
     struct forward_list_node *next;  ///< Pointer to the next node
+    max_align_t data[];              ///< Element storage, aligned for any type
 } DSCForwardListNode;
 
 /// @brief Forward list structure
@@ -26,6 +28,9 @@ typedef struct {
     DSCForwardListNode *head; ///< Pointer to the first node
     size_t size;              ///< Number of elements in the list
     size_t element_size;      ///< Size of each element in bytes
+    DSCPool *pool;            ///< Source of the nodes
+    bool owns_pool;           ///< Whether the list created pool itself
+    DSCAllocator allocator;   ///< Source of the structure and node slabs
 } DSCForwardList;
 
 /// @brief Creates a new forward list
@@ -33,11 +38,46 @@ typedef struct {
 /// Allocates and initializes a new forward list that can store elements
 /// of the specified size.
 ///
+/// Nodes come from a DSCPool owned by the list, so pushes and pops reuse
+/// freed nodes instead of calling malloc() and free() once the list has
+/// reached its peak size.
+///
 /// @param element_size Size of each element in bytes (must be > 0)
 /// @return Pointer to the newly created forward list, or NULL on failure
 /// @note The caller is responsible for calling forward_list_destroy()
 DSCForwardList *forward_list_create(size_t element_size);
 
+/// @brief Creates a new forward list that allocates through an allocator
+///
+/// Like forward_list_create(), but the list structure and the slabs of its
+/// node pool are obtained from allocator instead of malloc().
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param allocator Allocator to use, or NULL for the default allocator
+/// @return Pointer to the newly created forward list, or NULL on failure
+DSCForwardList *forward_list_create_with_allocator(
+    size_t element_size, DSCAllocator const *allocator);
+
+/// @brief Creates a new forward list that takes its nodes from a shared pool
+///
+/// Lists sharing a pool reuse each other's freed nodes. The list
+/// structure is obtained from the pool's allocator.
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param pool Pool to take nodes from (must not be NULL). Its block size
+///             must be at least forward_list_node_size(element_size).
+/// @return Pointer to the newly created forward list, or NULL on failure
+/// @note The pool must outlive the list
+DSCForwardList *forward_list_create_with_pool(size_t element_size,
+                                              DSCPool *pool);
+
+/// @brief Returns the size of a forward list node holding an element
+///
+/// @param element_size Size of each element in bytes
+/// @return Node size in bytes, the minimum block size of a shared pool,
+///         or 0 if element_size is too large
+size_t forward_list_node_size(size_t element_size);
+
 /// @brief Destroys the forward list and frees its memory
 ///
 /// Deallocates all memory associated with the forward list, including
@@ -127,9 +167,68 @@ DSCError forward_list_erase_after(DSCForwardList *list,
 ///
 /// @param list Pointer to the forward list (can be NULL)
 /// @note This function is safe to call with a NULL pointer
-/// @note This operation is O(n) where n is the number of elements
+/// @note This operation is O(1) when the list owns its pool, and O(n)
+///       where n is the number of elements when the pool is shared
 void forward_list_clear(DSCForwardList *list);
 
+/// @brief Moves all elements of one forward list into another
+///
+/// The elements of src are inserted after pos in dst, in order, and src
+/// becomes empty. When both lists take their nodes from the same pool
+/// (see forward_list_create_with_pool()), the nodes are relinked and stay
+/// valid. Otherwise the elements are copied into nodes from dst's pool,
+/// and src's nodes are released.
+///
+/// @param dst Pointer to the destination list (must not be NULL)
+/// @param pos Node of dst to insert after, or NULL to prepend
+/// @param src Pointer to the source list (must not be NULL or dst)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT A list is NULL, src is dst, or the
+///         element sizes differ
+/// @retval DSC_ERROR_MEMORY Copying failed; both lists are unchanged
+/// @note This operation is O(m) in the length of src
+DSCError forward_list_splice_after(DSCForwardList *dst,
+                                   DSCForwardListNode *pos,
+                                   DSCForwardList *src);
+
+/// @brief Merges a sorted forward list into another sorted forward list
+///
+/// Moves the elements of src into dst so that dst stays sorted, and src
+/// becomes empty. The merge is stable: of equal elements, those from dst
+/// come first. Nodes are moved as by forward_list_splice_after().
+///
+/// @param dst Pointer to the destination list, sorted (must not be NULL)
+/// @param src Pointer to the source list, sorted (must not be NULL or dst)
+/// @param compare Comparison function returning <0, 0 or >0 (must not be
+///                NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT An argument is NULL, src is dst, or
+///         the element sizes differ
+/// @retval DSC_ERROR_MEMORY Copying failed; both lists are unchanged
+/// @note This operation is O(n + m)
+DSCError forward_list_merge(DSCForwardList *dst, DSCForwardList *src,
+                            int (*compare)(void const *, void const *));
+
+/// @brief Sorts the forward list
+///
+/// A stable bottom-up merge sort that relinks the nodes without
+/// allocating or copying elements, so node pointers stay valid.
+///
+/// @param list Pointer to the forward list (must not be NULL)
+/// @param compare Comparison function returning <0, 0 or >0 (must not be
+///                NULL)
+/// @return DSC_ERROR_OK on success, or DSC_ERROR_INVALID_ARGUMENT if list
+///         or compare is NULL
+/// @note This operation is O(n log n)
+DSCError forward_list_sort(DSCForwardList *list,
+                           int (*compare)(void const *, void const *));
+
+/// @brief Reverses the order of the elements
+///
+/// @param list Pointer to the forward list (can be NULL)
+/// @note This operation is O(n) and does not move elements
+void forward_list_reverse(DSCForwardList *list);
+
 /// @brief Returns the first node of the forward list
 ///
 /// Returns a pointer to the first node for iteration purposes.
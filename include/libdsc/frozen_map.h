@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSC_FROZEN_MAP_H_
+#define DSC_FROZEN_MAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libdsc/common.h"
+#include "libdsc/unordered_map.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Immutable hash map indexed by a minimal perfect hash
+///
+/// Built once from a DSCUnorderedMap with unordered_map_freeze(). The n
+/// pairs are stored in arrays of exactly n slots, and a minimal perfect
+/// hash function in the style of PTHash maps every key to its own slot:
+/// keys are split into buckets, and each bucket stores a small "pilot"
+/// value chosen at build time so that the bucket's keys land on free
+/// slots. A lookup reads one pilot, computes one slot, and makes exactly
+/// one key comparison, with no probing and no empty slots.
+///
+/// The pilot table costs about 4 * 5 / log2(n) bytes per key, well under
+/// the 25% of empty slots a DSCUnorderedMap keeps.
+///
+/// @note This structure should be treated as opaque.
+typedef struct DSCFrozenMap {
+    void *keys;                                    ///< Keys in slot order
+    void *values;                                  ///< Values in slot order
+    uint32_t *pilots;                              ///< Pilot per bucket
+    size_t size;                                   ///< Number of key-value pairs
+    size_t bucket_count;                           ///< Number of buckets
+    size_t dense_buckets;                          ///< Buckets taking 60% of keys
+    size_t key_size;                               ///< Size of each key in bytes
+    size_t value_size;                             ///< Size of each value in bytes
+    size_t (*hash_fn)(void const *);               ///< Hash function for keys
+    int (*compare_fn)(void const *, void const *); ///< Comparison function for keys
+} DSCFrozenMap;
+
+/// @brief Builds an immutable frozen copy of a map
+///
+/// Copies every key-value pair of map into a new DSCFrozenMap that uses
+/// the same hash and comparison functions. The source map is not changed
+/// and can be destroyed afterwards.
+///
+/// Construction takes O(n log n) time and O(n) extra memory.
+///
+/// @param map Pointer to the map to freeze (must not be NULL)
+/// @return Pointer to the new frozen map, or NULL on failure
+/// @note Fails if two distinct keys have the same hash value, since no
+///       perfect hash function can separate them. Maps without a hash_fn
+///       use a 64-bit hash on every target; where size_t is 32 bits wide,
+///       a hash_fn makes collisions likely beyond about 50000 keys
+/// @note The caller is responsible for calling frozen_map_destroy()
+DSCFrozenMap *unordered_map_freeze(DSCUnorderedMap const *map);
+
+/// @brief Destroys a frozen map and frees its memory
+///
+/// @param map Pointer to the map to destroy (can be NULL)
+void frozen_map_destroy(DSCFrozenMap *map);
+
+/// @brief Returns the number of key-value pairs in the frozen map
+///
+/// @param map Pointer to the map (can be NULL)
+/// @return Number of pairs, or 0 if map is NULL
+size_t frozen_map_size(DSCFrozenMap const *map);
+
+/// @brief Looks up a key
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key to search for (must not be NULL)
+/// @return Pointer to the value, or NULL if the key is not present
+/// @note Makes exactly one key comparison. The value must not be modified.
+/// @note Safe to call from any number of threads at once
+void const *frozen_map_find(DSCFrozenMap const *map, void const *key);
+
+/// @brief Advances an iteration over the key-value pairs of the map
+///
+/// Start with a cursor of 0 and call repeatedly until it returns false.
+///
+/// @param map Pointer to the map (can be NULL)
+/// @param cursor Iteration position, 0 to start (must not be NULL)
+/// @param key Receives a pointer to the key (can be NULL)
+/// @param value Receives a pointer to the value (can be NULL)
+/// @return true if a key-value pair was found, false at the end of the map
+bool frozen_map_next(DSCFrozenMap const *map, size_t *cursor,
+                     void const **key, void const **value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_FROZEN_MAP_H_
@@ -0,0 +1,234 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/// @file hash.h
+/// @brief Hash functions for the unordered containers
+///
+/// Provides avalanche-quality integer mixers, a fast word-at-a-time hash
+/// for byte strings in the style of wyhash, and ready-made hash functions
+/// with the signature expected by DSCUnorderedMap and DSCUnorderedSet.
+///
+/// @example
+/// ```c
+/// #include <libdsc/hash.h>
+///
+/// uint64_t id = 1234;
+/// size_t h1 = dsc_hash_uint64(&id);
+///
+/// char const *name = "libdsc";
+/// uint64_t h2 = dsc_hash_bytes(name, strlen(name), DSC_HASH_DEFAULT_SEED);
+/// ```
+
+#ifndef DSC_HASH_H_
+#define DSC_HASH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Seed used by the default hash functions
+#define DSC_HASH_DEFAULT_SEED 0x9E3779B97F4A7C15ull
+
+/// @brief Mixes a 32-bit integer so that every input bit affects every
+/// output bit
+///
+/// Sequential or stride-aligned integers map to well-spread hashes, which
+/// keeps them from clustering in power-of-two tables.
+///
+/// @param x Value to mix
+/// @return Mixed value
+static inline uint32_t dsc_hash_mix32(uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+/// @brief Mixes a 64-bit integer so that every input bit affects every
+/// output bit
+///
+/// This is the SplitMix64 finalizer.
+///
+/// @param x Value to mix
+/// @return Mixed value
+static inline uint64_t dsc_hash_mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/// @brief Mixes a size_t with the mixer matching its width
+///
+/// @param x Value to mix
+/// @return Mixed value
+static inline size_t dsc_hash_mix(size_t x) {
+#if SIZE_MAX > 0xFFFFFFFFu
+    return (size_t)dsc_hash_mix64((uint64_t)x);
+#else
+    return (size_t)dsc_hash_mix32((uint32_t)x);
+#endif
+}
+
+/// @brief Multiplies two 64-bit values and folds the 128-bit product
+static inline uint64_t dsc_hash_mum(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+    uint64_t ha = a >> 32, hb = b >> 32;
+    uint64_t la = (uint32_t)a, lb = (uint32_t)b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    return lo ^ hi;
+#endif
+}
+
+/// @brief Reads 8 little-endian bytes
+static inline uint64_t dsc_hash_read64(unsigned char const *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+/// @brief Reads 4 little-endian bytes
+static inline uint64_t dsc_hash_read32(unsigned char const *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap32(v);
+#endif
+    return v;
+}
+
+/// @brief Hashes a byte buffer with a seed
+///
+/// A wyhash-style hash that consumes the input 16 or 48 bytes per step
+/// using 64x64->128-bit multiplies. Different seeds yield independent hash
+/// functions, which can be used to defeat hash flooding or to derive
+/// several hashes of the same key.
+///
+/// @param data Pointer to the bytes to hash (can be NULL if len is 0)
+/// @param len Number of bytes to hash
+/// @param seed Seed selecting the hash function
+/// @return 64-bit hash of the buffer
+static inline uint64_t dsc_hash_bytes(void const *data, size_t len,
+                                      uint64_t seed) {
+    static uint64_t const secret[4] = {
+        0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL,
+        0x4d5a2da51de1aa47ULL};
+    unsigned char const *p = (unsigned char const *)data;
+    uint64_t a, b;
+
+    seed ^= dsc_hash_mum(seed ^ secret[0], secret[1]);
+
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t mid = (len >> 3) << 2;
+            a = (dsc_hash_read32(p) << 32) | dsc_hash_read32(p + mid);
+            b = (dsc_hash_read32(p + len - 4) << 32) |
+                dsc_hash_read32(p + len - 4 - mid);
+        } else if (len > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) |
+                p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i >= 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = dsc_hash_mum(dsc_hash_read64(p) ^ secret[1],
+                                    dsc_hash_read64(p + 8) ^ seed);
+                see1 = dsc_hash_mum(dsc_hash_read64(p + 16) ^ secret[2],
+                                    dsc_hash_read64(p + 24) ^ see1);
+                see2 = dsc_hash_mum(dsc_hash_read64(p + 32) ^ secret[3],
+                                    dsc_hash_read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = dsc_hash_mum(dsc_hash_read64(p) ^ secret[1],
+                                dsc_hash_read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = dsc_hash_read64(p + i - 16);
+        b = dsc_hash_read64(p + i - 8);
+    }
+
+    return dsc_hash_mum(secret[1] ^ len,
+                        dsc_hash_mum(a ^ secret[1], b ^ seed));
+}
+
+/// @brief Hashes a NUL-terminated string with a seed
+///
+/// @param str String to hash (must not be NULL)
+/// @param seed Seed selecting the hash function
+/// @return 64-bit hash of the string
+static inline uint64_t dsc_hash_string_seeded(char const *str, uint64_t seed) {
+    return dsc_hash_bytes(str, strlen(str), seed);
+}
+
+/// @brief Default hash function for integers
+///
+/// Computes a hash value for an integer key. The key should point
+/// to an int value.
+///
+/// @param key Pointer to an int value
+/// @return Hash value for the integer
+static inline size_t dsc_hash_int(void const *key) {
+    return (size_t)dsc_hash_mix64((uint64_t)(int64_t)*(int const *)key);
+}
+
+/// @brief Hash function for 32-bit unsigned integers
+///
+/// @param key Pointer to a uint32_t value
+/// @return Hash value for the integer
+static inline size_t dsc_hash_uint32(void const *key) {
+    return (size_t)dsc_hash_mix64(*(uint32_t const *)key);
+}
+
+/// @brief Hash function for 64-bit unsigned integers
+///
+/// @param key Pointer to a uint64_t value
+/// @return Hash value for the integer
+static inline size_t dsc_hash_uint64(void const *key) {
+    return (size_t)dsc_hash_mix64(*(uint64_t const *)key);
+}
+
+/// @brief Default hash function for strings
+///
+/// Computes a hash value for a string with dsc_hash_bytes() and the
+/// default seed. The key should point to a char* value.
+///
+/// @param key Pointer to a char* value (string)
+/// @return Hash value for the string
+static inline size_t dsc_hash_string(void const *key) {
+    return (size_t)dsc_hash_string_seeded(*(char const **)key,
+                                          DSC_HASH_DEFAULT_SEED);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_HASH_H_
@@ -0,0 +1,385 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/// @file hash_table.h
+/// @brief Control-byte primitives shared by the open-addressing tables
+///
+/// Every slot of a table owns one control byte. A full slot stores the low
+/// seven bits of its hash (the fingerprint, H2), while empty and deleted
+/// slots use byte values with the high bit set. Probing works on groups of
+/// DSC_GROUP_WIDTH consecutive control bytes: a single SIMD (or SWAR)
+/// comparison yields a bitmask of candidate slots, so most lookups touch
+/// one group and call the key comparison function only on fingerprint hits.
+///
+/// The header is installed because the typed containers generated by
+/// typed_hashmap.h are built from the same primitives, but it is not part
+/// of the stable API: layouts and names may change between releases.
+
+#ifndef DSC_HASH_TABLE_H_
+#define DSC_HASH_TABLE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libdsc/common.h"
+#include "libdsc/hash.h"
+
+#if !defined(DSC_HASH_NO_SIMD) &&                                 \
+    (defined(__SSE2__) || defined(_M_X64) ||                      \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define DSC_GROUP_SSE2 1
+#include <emmintrin.h>
+#elif !defined(DSC_HASH_NO_SIMD) && defined(__ARM_NEON) && \
+    defined(__aarch64__)
+#define DSC_GROUP_NEON 1
+#include <arm_neon.h>
+#else
+#define DSC_GROUP_SWAR 1
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/// @brief Control byte of a slot that has never held an element
+#define DSC_CTRL_EMPTY ((int8_t)-128)
+
+/// @brief Control byte of a slot whose element has been erased
+#define DSC_CTRL_DELETED ((int8_t)-2)
+
+#if defined(DSC_GROUP_SSE2) || defined(DSC_GROUP_NEON)
+#define DSC_GROUP_WIDTH 16
+#else
+#define DSC_GROUP_WIDTH 8
+#endif
+
+#if defined(DSC_GROUP_SSE2)
+#define DSC_GROUP_SHIFT 0  ///< One mask bit per slot
+#elif defined(DSC_GROUP_NEON)
+#define DSC_GROUP_SHIFT 2  ///< One mask nibble per slot
+#else
+#define DSC_GROUP_SHIFT 3  ///< One mask byte per slot
+#endif
+
+/// @brief Bitmask of matching slots within a group
+///
+/// Iterate with dsc_mask_index() and dsc_mask_next(); only one bit is set
+/// for every matching slot regardless of the group implementation.
+typedef uint64_t DSCGroupMask;
+
+/// @brief Returns the number of trailing zero bits of a non-zero value
+static inline size_t dsc_ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long idx;
+    _BitScanForward64(&idx, x);
+    return (size_t)idx;
+#else
+    size_t idx = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++idx;
+    }
+    return idx;
+#endif
+}
+
+/// @brief Returns the index of the lowest slot set in a non-zero mask
+static inline size_t dsc_mask_index(DSCGroupMask mask) {
+    return dsc_ctz64(mask) >> DSC_GROUP_SHIFT;
+}
+
+/// @brief Clears the lowest slot set in a non-zero mask
+static inline DSCGroupMask dsc_mask_next(DSCGroupMask mask) {
+    return mask & (mask - 1);
+}
+
+#if defined(DSC_GROUP_SSE2)
+
+static inline DSCGroupMask dsc_group_match(int8_t const *ctrl, int8_t h2) {
+    __m128i group = _mm_loadu_si128((__m128i const *)ctrl);
+    __m128i cmp = _mm_cmpeq_epi8(_mm_set1_epi8(h2), group);
+    return (DSCGroupMask)(unsigned)_mm_movemask_epi8(cmp);
+}
+
+static inline DSCGroupMask dsc_group_match_empty(int8_t const *ctrl) {
+    return dsc_group_match(ctrl, DSC_CTRL_EMPTY);
+}
+
+static inline DSCGroupMask dsc_group_match_empty_or_deleted(
+    int8_t const *ctrl) {
+    __m128i group = _mm_loadu_si128((__m128i const *)ctrl);
+    __m128i cmp = _mm_cmpgt_epi8(_mm_set1_epi8(-1), group);
+    return (DSCGroupMask)(unsigned)_mm_movemask_epi8(cmp);
+}
+
+static inline DSCGroupMask dsc_group_match_full(int8_t const *ctrl) {
+    __m128i group = _mm_loadu_si128((__m128i const *)ctrl);
+    return (DSCGroupMask)(~(unsigned)_mm_movemask_epi8(group) & 0xFFFFu);
+}
+
+// One bit per slot, lowest bit first.
+static inline uint64_t dsc_group_full_bits(int8_t const *ctrl) {
+    return dsc_group_match_full(ctrl);
+}
+
+#elif defined(DSC_GROUP_NEON)
+
+#define DSC_NEON_MSBS 0x8888888888888888ull
+
+static inline DSCGroupMask dsc_neon_mask(uint8x16_t cmp) {
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & DSC_NEON_MSBS;
+}
+
+static inline DSCGroupMask dsc_group_match(int8_t const *ctrl, int8_t h2) {
+    int8x16_t group = vld1q_s8(ctrl);
+    return dsc_neon_mask(vceqq_s8(group, vdupq_n_s8(h2)));
+}
+
+static inline DSCGroupMask dsc_group_match_empty(int8_t const *ctrl) {
+    return dsc_group_match(ctrl, DSC_CTRL_EMPTY);
+}
+
+static inline DSCGroupMask dsc_group_match_empty_or_deleted(
+    int8_t const *ctrl) {
+    int8x16_t group = vld1q_s8(ctrl);
+    return dsc_neon_mask(vcltq_s8(group, vdupq_n_s8(-1)));
+}
+
+static inline DSCGroupMask dsc_group_match_full(int8_t const *ctrl) {
+    int8x16_t group = vld1q_s8(ctrl);
+    return dsc_neon_mask(vcgezq_s8(group));
+}
+
+// One bit per slot, lowest bit first.
+static inline uint64_t dsc_group_full_bits(int8_t const *ctrl) {
+    static uint8_t const weights[16] = {1, 2, 4, 8, 16, 32, 64, 128,
+                                        1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t full = vcgezq_s8(vld1q_s8(ctrl));
+    uint8x16_t bits = vandq_u8(full, vld1q_u8(weights));
+    return (uint64_t)vaddv_u8(vget_low_u8(bits)) |
+           ((uint64_t)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+
+#else
+
+#define DSC_SWAR_LSBS 0x0101010101010101ull
+#define DSC_SWAR_MSBS 0x8080808080808080ull
+
+static inline uint64_t dsc_swar_load(int8_t const *ctrl) {
+    uint64_t word;
+    memcpy(&word, ctrl, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+// May report a false positive in a byte above a true match; callers always
+// confirm candidates with the key comparison function.
+static inline DSCGroupMask dsc_group_match(int8_t const *ctrl, int8_t h2) {
+    uint64_t x = dsc_swar_load(ctrl) ^ (DSC_SWAR_LSBS * (uint8_t)h2);
+    return (x - DSC_SWAR_LSBS) & ~x & DSC_SWAR_MSBS;
+}
+
+static inline DSCGroupMask dsc_group_match_empty(int8_t const *ctrl) {
+    uint64_t word = dsc_swar_load(ctrl);
+    return word & (~word << 6) & DSC_SWAR_MSBS;
+}
+
+static inline DSCGroupMask dsc_group_match_empty_or_deleted(
+    int8_t const *ctrl) {
+    uint64_t word = dsc_swar_load(ctrl);
+    return word & (~word << 7) & DSC_SWAR_MSBS;
+}
+
+static inline DSCGroupMask dsc_group_match_full(int8_t const *ctrl) {
+    return ~dsc_swar_load(ctrl) & DSC_SWAR_MSBS;
+}
+
+// One bit per slot, lowest bit first: the multiply gathers the eight
+// byte flags into the top byte without carries.
+static inline uint64_t dsc_group_full_bits(int8_t const *ctrl) {
+    uint64_t flags = dsc_group_match_full(ctrl) >> 7;
+    return (flags * 0x0102040810204080ull) >> 56;
+}
+
+#endif
+
+/// @brief Cache line size assumed when padding data shared between threads
+#define DSC_CACHE_LINE 64
+
+/// @brief Hints the CPU to start loading the cache line holding addr
+static inline void dsc_prefetch(void const *addr) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(addr, 0, 3);
+#elif defined(DSC_GROUP_SSE2)
+    _mm_prefetch((char const *)addr, _MM_HINT_T0);
+#else
+    (void)addr;
+#endif
+}
+
+/// @brief Number of keys hashed and prefetched ahead by batched lookups
+///
+/// Large enough to keep a dozen or so cache misses in flight, small
+/// enough that the prefetched lines are still cached when probed.
+#define DSC_LOOKUP_BATCH 32
+
+/// @brief Number of slots covered by one occupancy scan step
+#define DSC_SCAN_WIDTH 64
+
+/// @brief Returns a bitmap of the full slots among n control bytes
+///
+/// Bit i is set if slot i is full. Scanning 64 slots per step lets
+/// rehashing and iteration skip empty regions of sparse tables quickly.
+///
+/// @param ctrl First control byte of the window (group aligned)
+/// @param n Window size, a multiple of DSC_GROUP_WIDTH up to DSC_SCAN_WIDTH
+static inline uint64_t dsc_ctrl_full_bits(int8_t const *ctrl, size_t n) {
+    uint64_t bits = 0;
+    for (size_t offset = 0; offset < n; offset += DSC_GROUP_WIDTH) {
+        bits |= dsc_group_full_bits(ctrl + offset) << offset;
+    }
+    return bits;
+}
+
+/// @brief Finds the first full slot at or after start
+///
+/// @return Index of the slot, or capacity if no full slot remains
+static inline size_t dsc_ctrl_next_full(int8_t const *ctrl, size_t capacity,
+                                        size_t start) {
+    size_t base = start & ~(size_t)(DSC_SCAN_WIDTH - 1);
+    while (base < capacity) {
+        size_t n = capacity - base;
+        if (n > DSC_SCAN_WIDTH) {
+            n = DSC_SCAN_WIDTH;
+        }
+
+        uint64_t bits = dsc_ctrl_full_bits(ctrl + base, n);
+        if (start > base) {
+            bits &= ~(uint64_t)0 << (start - base);
+        }
+        if (bits) {
+            return base + dsc_ctz64(bits);
+        }
+        base += DSC_SCAN_WIDTH;
+    }
+    return capacity;
+}
+
+/// @brief Folds a user-supplied hash before it is split
+///
+/// Probing uses the high bits (H1) to select a group and the low seven
+/// bits (H2) as the fingerprint. The hash functions in hash.h already mix
+/// every input bit into every output bit, so this is deliberately cheap:
+/// one multiply spreads low-bit patterns upwards, and folding the high
+/// half down makes H2 depend on the whole hash. That is enough to keep
+/// weak hashes (the identity on integers, for instance) from collapsing
+/// onto a few groups or fingerprints; use dsc_hash_mix() in the hash
+/// function itself for full avalanche.
+static inline size_t dsc_hash_finalize(size_t hash) {
+#if SIZE_MAX > 0xFFFFFFFFu
+    hash *= (size_t)0x9E3779B97F4A7C15ull;
+    return hash ^ (hash >> 32);
+#else
+    hash *= (size_t)0x9E3779B9u;
+    return hash ^ (hash >> 16);
+#endif
+}
+
+/// @brief Group-selecting part of a finalized hash
+static inline size_t dsc_hash_h1(size_t hash) { return hash >> 7; }
+
+/// @brief Fingerprint stored in the control byte of a full slot
+static inline int8_t dsc_hash_h2(size_t hash) {
+    return (int8_t)(hash & 0x7F);
+}
+
+/// @brief Returns true if the control byte marks a full slot
+static inline int dsc_ctrl_is_full(int8_t ctrl) { return ctrl >= 0; }
+
+/// @brief Number of elements a table of the given capacity may hold
+///
+/// Tables grow once three quarters of their slots are in use (including
+/// deleted slots), which keeps at least one empty slot in every probe
+/// sequence.
+static inline size_t dsc_capacity_to_growth(size_t capacity) {
+    return capacity - capacity / 4;
+}
+
+/// @brief Returns the first empty or deleted slot on the probe sequence
+///
+/// Uses the same triangular group sequence as lookups, so a key stored in
+/// the returned slot is found again. The table must have a free slot.
+static inline size_t dsc_ctrl_find_insert_slot(int8_t const *ctrl,
+                                               size_t capacity, size_t hash) {
+    size_t group_mask = capacity / DSC_GROUP_WIDTH - 1;
+    size_t group = dsc_hash_h1(hash) & group_mask;
+
+    for (size_t step = 1;; ++step) {
+        DSCGroupMask mask = dsc_group_match_empty_or_deleted(
+            ctrl + group * DSC_GROUP_WIDTH);
+        if (mask) {
+            return group * DSC_GROUP_WIDTH + dsc_mask_index(mask);
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+/// @brief Marks the full slot idx of a group-probed table as free
+///
+/// A probe only moves past a group that has no empty slot, so if the
+/// slot's group still has one, no probe sequence depends on the slot and
+/// it can become empty again instead of a tombstone.
+///
+/// @return true if the slot became empty, giving back one unit of growth
+static inline bool dsc_ctrl_erase(int8_t *ctrl, size_t idx) {
+    int8_t const *group = ctrl + (idx & ~(size_t)(DSC_GROUP_WIDTH - 1));
+    if (dsc_group_match_empty(group)) {
+        ctrl[idx] = DSC_CTRL_EMPTY;
+        return true;
+    }
+    ctrl[idx] = DSC_CTRL_DELETED;
+    return false;
+}
+
+/// @brief Largest probe distance a Robin Hood table can record
+///
+/// Distances are stored in one byte per slot. Good hash functions keep
+/// them in the single digits even at 0.9 load; only degenerate ones reach
+/// this limit.
+#define DSC_RH_MAX_DIST UINT8_MAX
+
+/// @brief Number of elements a table may hold in the given probe mode
+///
+/// Robin Hood tables keep runs ordered by home slot, so misses stay short
+/// up to a load factor of 0.9 (rounded down, leaving at least two empty
+/// slots in the smallest tables).
+static inline size_t dsc_table_growth(DSCProbeMode mode, size_t capacity) {
+    if (mode == DSC_PROBE_ROBIN_HOOD) {
+        return capacity - (capacity + 9) / 10;
+    }
+    return dsc_capacity_to_growth(capacity);
+}
+
+/// @brief Smallest valid capacity that can hold n elements
+///
+/// Capacities are powers of two and never smaller than min_capacity.
+/// Returns 0 if the capacity would overflow.
+static inline size_t dsc_capacity_for(size_t n, size_t min_capacity,
+                                      DSCProbeMode mode) {
+    size_t capacity = min_capacity;
+    while (dsc_table_growth(mode, capacity) < n) {
+        if (capacity > SIZE_MAX / 2) {
+            return 0;
+        }
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+#endif  // DSC_HASH_TABLE_H_
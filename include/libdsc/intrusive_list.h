@@ -0,0 +1,329 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSC_INTRUSIVE_LIST_H_
+#define DSC_INTRUSIVE_LIST_H_
+
+#include <stddef.h>
+
+#include "libdsc/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Returns the structure that contains a member
+///
+/// @param ptr Pointer to the member
+/// @param type Type of the containing structure
+/// @param member Name of the member within type
+#define DSC_CONTAINER_OF(ptr, type, member) \
+    ((type *)((char *)(ptr) - offsetof(type, member)))
+
+/// @brief Links of an element in a DSCIList
+///
+/// Embed a hook in a structure to make it an element of an intrusive
+/// list, and use DSC_CONTAINER_OF() to get from the hook back to the
+/// structure. A structure can be in several lists at once through several
+/// hooks. A hook is unlinked after ilist_hook_init() and after it is
+/// removed from a list.
+typedef struct DSCIListHook {
+    struct DSCIListHook *prev; ///< Previous hook, or NULL if unlinked
+    struct DSCIListHook *next; ///< Next hook, or NULL if unlinked
+} DSCIListHook;
+
+/// @brief Intrusive doubly-linked list
+///
+/// Links caller-owned elements through their embedded DSCIListHook, so
+/// no operation allocates or copies elements and none can fail for lack
+/// of memory. Elements must stay in place while they are linked, and the
+/// caller keeps ownership of them.
+///
+/// The list is circular around a sentinel hook stored in the list itself,
+/// so a DSCIList must not be copied or moved once initialized.
+///
+/// @example
+/// ```c
+/// typedef struct {
+///     int fd;
+///     DSCIListHook idle_hook;
+/// } Connection;
+///
+/// DSCIList idle;
+/// ilist_init(&idle);
+/// ilist_push_back(&idle, &conn->idle_hook);
+///
+/// DSCIListHook *hook = ilist_pop_front(&idle);
+/// Connection *oldest = DSC_CONTAINER_OF(hook, Connection, idle_hook);
+/// ```
+typedef struct {
+    DSCIListHook head; ///< Sentinel; head.next is the first hook
+    size_t size;       ///< Number of linked hooks
+} DSCIList;
+
+/// @brief Initializes an empty intrusive list
+///
+/// @param list Pointer to the list (must not be NULL)
+void ilist_init(DSCIList *list);
+
+/// @brief Marks a hook as unlinked
+///
+/// @param hook Pointer to the hook (must not be NULL)
+void ilist_hook_init(DSCIListHook *hook);
+
+/// @brief Checks whether a hook is in a list
+///
+/// @param hook Pointer to the hook (must not be NULL)
+/// @return true if the hook is linked into a list
+bool ilist_hook_linked(DSCIListHook const *hook);
+
+/// @brief Returns the number of hooks in the list
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return Number of hooks, or 0 if list is NULL
+/// @note This operation is O(1)
+size_t ilist_size(DSCIList const *list);
+
+/// @brief Checks if the list is empty
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return true if the list is empty or NULL, false otherwise
+bool ilist_empty(DSCIList const *list);
+
+/// @brief Returns the first hook
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return First hook, or NULL if the list is empty or NULL
+DSCIListHook *ilist_front(DSCIList const *list);
+
+/// @brief Returns the last hook
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return Last hook, or NULL if the list is empty or NULL
+DSCIListHook *ilist_back(DSCIList const *list);
+
+/// @brief Returns the hook after the given one
+///
+/// @param list Pointer to the list holding hook (must not be NULL)
+/// @param hook Linked hook (must not be NULL)
+/// @return Next hook, or NULL if hook is the last one
+DSCIListHook *ilist_next(DSCIList const *list, DSCIListHook const *hook);
+
+/// @brief Returns the hook before the given one
+///
+/// @param list Pointer to the list holding hook (must not be NULL)
+/// @param hook Linked hook (must not be NULL)
+/// @return Previous hook, or NULL if hook is the first one
+DSCIListHook *ilist_prev(DSCIList const *list, DSCIListHook const *hook);
+
+/// @brief Links a hook at the front of the list
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param hook Unlinked hook (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list or hook is NULL, or hook is
+///         already linked
+/// @note This operation is O(1)
+DSCError ilist_push_front(DSCIList *list, DSCIListHook *hook);
+
+/// @brief Links a hook at the back of the list
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param hook Unlinked hook (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list or hook is NULL, or hook is
+///         already linked
+/// @note This operation is O(1)
+DSCError ilist_push_back(DSCIList *list, DSCIListHook *hook);
+
+/// @brief Unlinks and returns the first hook
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return The unlinked hook, or NULL if the list is empty or NULL
+/// @note This operation is O(1)
+DSCIListHook *ilist_pop_front(DSCIList *list);
+
+/// @brief Unlinks and returns the last hook
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return The unlinked hook, or NULL if the list is empty or NULL
+/// @note This operation is O(1)
+DSCIListHook *ilist_pop_back(DSCIList *list);
+
+/// @brief Links a hook before the given position
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param pos Hook in list to insert before, or NULL to insert at the back
+/// @param hook Unlinked hook (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list or hook is NULL, or hook is
+///         already linked
+/// @note This operation is O(1)
+DSCError ilist_insert(DSCIList *list, DSCIListHook *pos, DSCIListHook *hook);
+
+/// @brief Unlinks a hook from the list
+///
+/// @param list Pointer to the list holding hook (must not be NULL)
+/// @param hook Hook to unlink (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list or hook is NULL, or hook is
+///         not linked
+/// @note This operation is O(1)
+DSCError ilist_erase(DSCIList *list, DSCIListHook *hook);
+
+/// @brief Moves all hooks of one list into another
+///
+/// The hooks of src are linked before pos in dst, in order, and src
+/// becomes empty.
+///
+/// @param dst Pointer to the destination list (must not be NULL)
+/// @param pos Hook in dst to insert before, or NULL to append
+/// @param src Pointer to the source list (must not be NULL or dst)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT A list is NULL, or src is dst
+/// @note This operation is O(1)
+DSCError ilist_splice(DSCIList *dst, DSCIListHook *pos, DSCIList *src);
+
+/// @brief Moves one hook from one list into another
+///
+/// @param dst Pointer to the destination list (must not be NULL)
+/// @param pos Hook in dst to insert before, or NULL to append
+/// @param src Pointer to the list holding hook (must not be NULL, can be
+///            dst)
+/// @param hook Hook to move (must not be NULL or pos)
+/// @note This operation is O(1)
+void ilist_splice_element(DSCIList *dst, DSCIListHook *pos, DSCIList *src,
+                          DSCIListHook *hook);
+
+/// @brief Unlinks every hook of the list
+///
+/// Leaves every former element with an unlinked hook.
+///
+/// @param list Pointer to the list (can be NULL)
+/// @note This operation is O(n)
+void ilist_clear(DSCIList *list);
+
+/// @brief Link of an element in a DSCISList
+///
+/// Embed a hook in a structure to make it an element of an intrusive
+/// singly-linked list, and use DSC_CONTAINER_OF() to get from the hook
+/// back to the structure. A hook is unlinked after islist_hook_init() and
+/// after it is removed from a list; an unlinked hook points to itself, so
+/// unlike a DSCIListHook it must be initialized before its first use.
+typedef struct DSCISListHook {
+    struct DSCISListHook *next; ///< Next hook, NULL at the end, or the
+                                ///< hook itself if unlinked
+} DSCISListHook;
+
+/// @brief Intrusive singly-linked list
+///
+/// Links caller-owned elements through their embedded DSCISListHook, with
+/// O(1) insertion at both ends and removal at the front, and no
+/// allocation. Unlike DSCIList it can be copied while empty and has one
+/// pointer per element, but it cannot remove an arbitrary element in O(1).
+typedef struct {
+    DSCISListHook *head; ///< First hook, or NULL if empty
+    DSCISListHook *tail; ///< Last hook, or NULL if empty
+    size_t size;         ///< Number of linked hooks
+} DSCISList;
+
+/// @brief Initializes an empty intrusive singly-linked list
+///
+/// @param list Pointer to the list (must not be NULL)
+void islist_init(DSCISList *list);
+
+/// @brief Marks a hook as unlinked
+///
+/// @param hook Pointer to the hook (must not be NULL)
+void islist_hook_init(DSCISListHook *hook);
+
+/// @brief Checks whether a hook is in a list
+///
+/// @param hook Pointer to an initialized hook (must not be NULL)
+/// @return true if the hook is linked into a list
+bool islist_hook_linked(DSCISListHook const *hook);
+
+/// @brief Returns the number of hooks in the list
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return Number of hooks, or 0 if list is NULL
+size_t islist_size(DSCISList const *list);
+
+/// @brief Checks if the list is empty
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return true if the list is empty or NULL, false otherwise
+bool islist_empty(DSCISList const *list);
+
+/// @brief Returns the first hook
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return First hook, or NULL if the list is empty or NULL
+DSCISListHook *islist_front(DSCISList const *list);
+
+/// @brief Returns the last hook
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return Last hook, or NULL if the list is empty or NULL
+DSCISListHook *islist_back(DSCISList const *list);
+
+/// @brief Links a hook at the front of the list
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param hook Unlinked hook (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list or hook is NULL, or hook is
+///         already linked
+DSCError islist_push_front(DSCISList *list, DSCISListHook *hook);
+
+/// @brief Links a hook at the back of the list
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param hook Unlinked hook (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list or hook is NULL, or hook is
+///         already linked
+DSCError islist_push_back(DSCISList *list, DSCISListHook *hook);
+
+/// @brief Unlinks and returns the first hook
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return The unlinked hook, or NULL if the list is empty or NULL
+DSCISListHook *islist_pop_front(DSCISList *list);
+
+/// @brief Links a hook after the given position
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param pos Hook in list to insert after, or NULL to insert at the front
+/// @param hook Unlinked hook (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list or hook is NULL, or hook is
+///         already linked
+DSCError islist_insert_after(DSCISList *list, DSCISListHook *pos,
+                             DSCISListHook *hook);
+
+/// @brief Unlinks and returns the hook after the given position
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param pos Hook in list, or NULL to remove the first hook
+/// @return The unlinked hook, or NULL if there is none after pos
+DSCISListHook *islist_erase_after(DSCISList *list, DSCISListHook *pos);
+
+/// @brief Moves all hooks of one list into another
+///
+/// The hooks of src are linked after pos in dst, in order, and src
+/// becomes empty.
+///
+/// @param dst Pointer to the destination list (must not be NULL)
+/// @param pos Hook in dst to insert after, or NULL to prepend
+/// @param src Pointer to the source list (must not be NULL or dst)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT A list is NULL, or src is dst
+/// @note This operation is O(1)
+DSCError islist_splice_after(DSCISList *dst, DSCISListHook *pos,
+                             DSCISList *src);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_INTRUSIVE_LIST_H_
@@ -4,6 +4,7 @@
 #define DSC_LIST_H_
 
 #include "libdsc/common.h"
+#include "libdsc/pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -11,12 +12,14 @@ extern "C" {
 
 /// @brief Node structure for doubly-linked list
 ///
-/// Each node contains data and pointers to the previous and next nodes.
-/// This structure should be treated as opaque.
+/// Each node contains pointers to the previous and next nodes, followed
+/// by the element itself, so a node is a single allocation and the element
+/// shares a cache line with the links. This structure should be treated as
+/// opaque.
 typedef struct list_node {
-    void *data;             ///< Pointer to the stored data
     struct list_node *prev; ///< Pointer to the previous node
     struct list_node *next; ///< Pointer to the next node
+    max_align_t data[];     ///< Element storage, aligned for any type
 } DSCListNode;
 
 /// @brief Doubly-linked list structure
@@ -28,6 +31,9 @@ typedef struct {
     DSCListNode *tail;   ///< Pointer to the last node
     size_t size;         ///< Number of elements in the list
     size_t element_size; ///< Size of each element in bytes
+    DSCPool *pool;       ///< Source of the nodes
+    bool owns_pool;      ///< Whether the list created pool itself
+    DSCAllocator allocator; ///< Source of the structure and node slabs
 } DSCList;
 
 /// @brief Creates a new doubly-linked list
@@ -35,11 +41,45 @@ typedef struct {
 /// Allocates and initializes a new doubly-linked list that can store
 /// elements of the specified size.
 ///
+/// Nodes come from a DSCPool owned by the list, so pushes and pops reuse
+/// freed nodes instead of calling malloc() and free() once the list has
+/// reached its peak size.
+///
 /// @param element_size Size of each element in bytes (must be > 0)
 /// @return Pointer to the newly created list, or NULL on failure
 /// @note The caller is responsible for calling list_destroy()
 DSCList *list_create(size_t element_size);
 
+/// @brief Creates a new list that allocates through the given allocator
+///
+/// Like list_create(), but the list structure and the slabs of its node
+/// pool are obtained from allocator instead of malloc().
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param allocator Allocator to use, or NULL for the default allocator
+/// @return Pointer to the newly created list, or NULL on failure
+DSCList *list_create_with_allocator(size_t element_size,
+                                    DSCAllocator const *allocator);
+
+/// @brief Creates a new list that takes its nodes from a shared pool
+///
+/// Lists sharing a pool reuse each other's freed nodes. The list
+/// structure is obtained from the pool's allocator.
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param pool Pool to take nodes from (must not be NULL). Its block size
+///             must be at least list_node_size(element_size).
+/// @return Pointer to the newly created list, or NULL on failure
+/// @note The pool must outlive the list
+DSCList *list_create_with_pool(size_t element_size, DSCPool *pool);
+
+/// @brief Returns the size of a list node holding an element
+///
+/// @param element_size Size of each element in bytes
+/// @return Node size in bytes, the minimum block size of a shared pool,
+///         or 0 if element_size is too large
+size_t list_node_size(size_t element_size);
+
 /// @brief Destroys the list and frees its memory
 ///
 /// Deallocates all memory associated with the list, including
@@ -155,9 +195,64 @@ DSCError list_erase(DSCList *list, DSCListNode *pos);
 ///
 /// @param list Pointer to the list (can be NULL)
 /// @note This function is safe to call with a NULL pointer
-/// @note This operation is O(n) where n is the number of elements
+/// @note This operation is O(1) when the list owns its pool, and O(n)
+///       where n is the number of elements when the pool is shared
 void list_clear(DSCList *list);
 
+/// @brief Moves all elements of one list into another
+///
+/// The elements of src are inserted before pos in dst, in order, and src
+/// becomes empty. When both lists take their nodes from the same pool
+/// (see list_create_with_pool()), the nodes are relinked in O(1) and stay
+/// valid. Otherwise the elements are copied into nodes from dst's pool
+/// in O(n), and src's nodes are released.
+///
+/// @param dst Pointer to the destination list (must not be NULL)
+/// @param pos Node of dst to insert before, or NULL to append
+/// @param src Pointer to the source list (must not be NULL or dst)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT A list is NULL, src is dst, or the
+///         element sizes differ
+/// @retval DSC_ERROR_MEMORY Copying failed; both lists are unchanged
+DSCError list_splice(DSCList *dst, DSCListNode *pos, DSCList *src);
+
+/// @brief Merges a sorted list into another sorted list
+///
+/// Moves the elements of src into dst so that dst stays sorted, and src
+/// becomes empty. The merge is stable: of equal elements, those from dst
+/// come first. Nodes are moved as by list_splice().
+///
+/// @param dst Pointer to the destination list, sorted (must not be NULL)
+/// @param src Pointer to the source list, sorted (must not be NULL or dst)
+/// @param compare Comparison function returning <0, 0 or >0 (must not be
+///                NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT An argument is NULL, src is dst, or
+///         the element sizes differ
+/// @retval DSC_ERROR_MEMORY Copying failed; both lists are unchanged
+/// @note This operation is O(n + m)
+DSCError list_merge(DSCList *dst, DSCList *src,
+                    int (*compare)(void const *, void const *));
+
+/// @brief Sorts the list
+///
+/// A stable bottom-up merge sort that relinks the nodes without
+/// allocating or copying elements, so node pointers stay valid.
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param compare Comparison function returning <0, 0 or >0 (must not be
+///                NULL)
+/// @return DSC_ERROR_OK on success, or DSC_ERROR_INVALID_ARGUMENT if list
+///         or compare is NULL
+/// @note This operation is O(n log n)
+DSCError list_sort(DSCList *list, int (*compare)(void const *, void const *));
+
+/// @brief Reverses the order of the elements
+///
+/// @param list Pointer to the list (can be NULL)
+/// @note This operation is O(n) and does not move elements
+void list_reverse(DSCList *list);
+
 /// @brief Returns the first node of the list
 ///
 /// Returns a pointer to the first node for forward iteration.
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSC_MPMC_QUEUE_H_
+#define DSC_MPMC_QUEUE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libdsc/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Lock-free bounded FIFO queue for any number of producers and
+///        consumers
+///
+/// A fixed power-of-two ring of slots, each tagged with a sequence number
+/// that says whether the slot is ready to be written or read in the
+/// current lap. A producer claims a slot by advancing the enqueue position
+/// with one compare-and-swap, copies its element in, and publishes it by
+/// bumping the slot's sequence; consumers do the mirror image. Producers
+/// only contend with producers and consumers with consumers, and no
+/// thread ever waits for another to finish an operation it has started
+/// except on the one slot both want.
+///
+/// mpmc_queue_push() and mpmc_queue_pop() never block. The _wait variants
+/// sleep while the queue is full or empty instead of spinning: on Linux
+/// they park on a futex and are woken by the opposite operation, elsewhere
+/// they poll with short sleeps. Pushes and pops only make a system call
+/// to wake a thread when one is actually waiting.
+///
+/// ```c
+/// // Any number of logging threads
+/// mpmc_queue_push_wait(log_queue, &record, -1);
+///
+/// // Writer thread: flush at least every 100 ms
+/// while (mpmc_queue_pop_wait(log_queue, &record, 100000000) ==
+///        DSC_ERROR_OK) {
+///     write_record(&record);
+/// }
+/// ```
+///
+/// @note This structure is opaque; use the functions below.
+typedef struct DSCMpmcQueue DSCMpmcQueue;
+
+/// @brief Creates a new multi-producer/multi-consumer queue
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param capacity Maximum number of elements (must be > 0), rounded up to
+///                 a power of two of at least 2
+/// @return Pointer to the newly created queue, or NULL on failure
+/// @note The caller is responsible for calling mpmc_queue_destroy()
+DSCMpmcQueue *mpmc_queue_create(size_t element_size, size_t capacity);
+
+/// @brief Destroys the queue and frees its memory
+///
+/// @param queue Pointer to the queue to destroy (can be NULL)
+/// @note No other thread may be using or waiting on the queue
+void mpmc_queue_destroy(DSCMpmcQueue *queue);
+
+/// @brief Returns the capacity of the queue
+///
+/// @param queue Pointer to the queue (can be NULL)
+/// @return Maximum number of elements, or 0 if queue is NULL
+size_t mpmc_queue_capacity(DSCMpmcQueue const *queue);
+
+/// @brief Returns the number of elements in the queue
+///
+/// @param queue Pointer to the queue (can be NULL)
+/// @return Number of elements, or 0 if queue is NULL
+/// @note While other threads are active the result is only a snapshot
+size_t mpmc_queue_size(DSCMpmcQueue const *queue);
+
+/// @brief Checks if the queue is empty
+///
+/// @param queue Pointer to the queue (can be NULL)
+/// @return true if the queue is empty or NULL, false otherwise
+/// @note While other threads are active the result is only a snapshot
+bool mpmc_queue_empty(DSCMpmcQueue const *queue);
+
+/// @brief Copies an element to the back of the queue
+///
+/// @param queue Pointer to the queue (must not be NULL)
+/// @param element Pointer to the element to copy (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT queue or element is NULL
+/// @retval DSC_ERROR_FULL The queue is full
+/// @note Lock-free; never blocks
+DSCError mpmc_queue_push(DSCMpmcQueue *queue, void const *element);
+
+/// @brief Moves the front element out of the queue
+///
+/// @param queue Pointer to the queue (must not be NULL)
+/// @param out Buffer receiving the element (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT queue or out is NULL
+/// @retval DSC_ERROR_EMPTY The queue is empty
+/// @note Lock-free; never blocks
+DSCError mpmc_queue_pop(DSCMpmcQueue *queue, void *out);
+
+/// @brief Copies an element to the back of the queue, waiting for space
+///
+/// @param queue Pointer to the queue (must not be NULL)
+/// @param element Pointer to the element to copy (must not be NULL)
+/// @param timeout_ns Longest time to wait in nanoseconds, 0 to not wait,
+///                   or negative to wait indefinitely
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT queue or element is NULL
+/// @retval DSC_ERROR_FULL The queue was still full when the timeout expired
+DSCError mpmc_queue_push_wait(DSCMpmcQueue *queue, void const *element,
+                              int64_t timeout_ns);
+
+/// @brief Moves the front element out of the queue, waiting for one
+///
+/// @param queue Pointer to the queue (must not be NULL)
+/// @param out Buffer receiving the element (must not be NULL)
+/// @param timeout_ns Longest time to wait in nanoseconds, 0 to not wait,
+///                   or negative to wait indefinitely
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT queue or out is NULL
+/// @retval DSC_ERROR_EMPTY The queue was still empty when the timeout
+///         expired
+DSCError mpmc_queue_pop_wait(DSCMpmcQueue *queue, void *out,
+                             int64_t timeout_ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_MPMC_QUEUE_H_
@@ -0,0 +1,114 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSC_POOL_H_
+#define DSC_POOL_H_
+
+#include <stddef.h>
+
+#include "libdsc/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Number of blocks in a pool's first slab
+#define DSC_POOL_MIN_SLAB_BLOCKS 8
+
+/// Size in bytes past which slabs stop doubling
+#define DSC_POOL_MAX_SLAB_BYTES ((size_t)64 * 1024)
+
+/// @brief Slab of pool blocks (internal)
+typedef struct DSCPoolSlab DSCPoolSlab;
+
+/// @brief Fixed-size block pool
+///
+/// Serves blocks of one size from slabs obtained in bulk from an
+/// allocator. Released blocks go on an intrusive free list and are handed
+/// out again first, so once a pool has reached its peak size, allocating
+/// and releasing blocks never calls the underlying allocator. Slabs start
+/// at DSC_POOL_MIN_SLAB_BLOCKS blocks and double up to
+/// DSC_POOL_MAX_SLAB_BYTES.
+///
+/// DSCList and DSCForwardList allocate their nodes from a pool of their
+/// own, or from a pool shared between lists with list_create_with_pool()
+/// and forward_list_create_with_pool().
+///
+/// @note This structure should be treated as opaque. A pool is not
+///       thread-safe.
+typedef struct DSCPool {
+    DSCPoolSlab *first;      ///< Oldest slab, where a reset restarts
+    DSCPoolSlab *current;    ///< Slab fresh blocks are carved from
+    char *ptr;               ///< Next never-used block in the current slab
+    char *end;               ///< End of the current slab
+    void *free_list;         ///< Released blocks, linked through their first word
+    size_t block_size;       ///< Size of each block in bytes
+    size_t slab_blocks;      ///< Number of blocks in the next new slab
+    size_t capacity;         ///< Total number of blocks in slabs
+    DSCAllocator allocator;  ///< Source of the structure and slabs
+} DSCPool;
+
+/// @brief Creates a new, empty pool
+///
+/// No slab is allocated until the first block is requested.
+///
+/// @param block_size Size of each block in bytes (must be > 0). It is
+///                   rounded up so that every block is aligned like
+///                   malloc().
+/// @return Pointer to the new pool, or NULL on failure
+/// @note The caller is responsible for calling pool_destroy()
+DSCPool *pool_create(size_t block_size);
+
+/// @brief Creates a new pool that obtains its slabs from the given allocator
+///
+/// @param block_size Size of each block in bytes (must be > 0)
+/// @param allocator Allocator to use, or NULL for the default allocator
+/// @return Pointer to the new pool, or NULL on failure
+DSCPool *pool_create_with_allocator(size_t block_size,
+                                    DSCAllocator const *allocator);
+
+/// @brief Destroys a pool and frees all of its slabs
+///
+/// Runs in O(number of slabs). Every block of the pool becomes invalid.
+///
+/// @param pool Pointer to the pool to destroy (can be NULL)
+void pool_destroy(DSCPool *pool);
+
+/// @brief Takes a block from the pool
+///
+/// @param pool Pointer to the pool (must not be NULL)
+/// @return Pointer to a block of pool_block_size() bytes, or NULL on
+///         failure
+void *pool_allocate(DSCPool *pool);
+
+/// @brief Returns a block to the pool
+///
+/// @param pool Pointer to the pool the block came from (must not be NULL)
+/// @param block Pointer to the block (can be NULL)
+void pool_deallocate(DSCPool *pool, void *block);
+
+/// @brief Returns every block to the pool at once
+///
+/// Runs in O(1) and keeps the slabs for reuse.
+///
+/// @param pool Pointer to the pool (can be NULL)
+/// @note Every block of the pool becomes invalid, including blocks used by
+///       other lists sharing the pool
+void pool_reset(DSCPool *pool);
+
+/// @brief Returns the size of the pool's blocks
+///
+/// @param pool Pointer to the pool (can be NULL)
+/// @return Block size in bytes after rounding, or 0 if pool is NULL
+size_t pool_block_size(DSCPool const *pool);
+
+/// @brief Returns the number of blocks the pool holds in slabs
+///
+/// @param pool Pointer to the pool (can be NULL)
+/// @return Number of blocks, in use or free, or 0 if pool is NULL
+size_t pool_capacity(DSCPool const *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_POOL_H_
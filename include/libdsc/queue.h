@@ -16,7 +16,13 @@ extern "C" {
 ///
 /// A circular buffer-based FIFO queue that can store elements of any type.
 /// The queue automatically manages memory allocation and provides efficient
-/// enqueue and dequeue operations.
+/// enqueue and dequeue operations. The capacity is always a power of two,
+/// so positions wrap with a mask rather than a division.
+///
+/// The elements occupy at most two contiguous regions of the buffer, which
+/// queue_front_span() and queue_write_span() expose directly so batches
+/// can be processed or filled in place, for example with readv() and
+/// writev().
 ///
 /// @note This structure should be treated as opaque.
 typedef struct {
@@ -24,10 +30,17 @@ typedef struct {
     size_t front;        ///< Index of the front element
     size_t back;         ///< Index of the back element
     size_t size;         ///< Number of elements currently stored
-    size_t capacity;     ///< Total capacity of the buffer
+    size_t capacity;     ///< Total capacity of the buffer (a power of two)
     size_t element_size; ///< Size of each element in bytes
+    DSCAllocator allocator; ///< Source of the structure and buffer
 } DSCQueue;
 
+/// @brief Contiguous run of elements inside a DSCQueue buffer
+typedef struct {
+    void *data;   ///< First element of the run
+    size_t count; ///< Number of elements in the run
+} DSCQueueSpan;
+
 /// @brief Creates a new queue with the specified element size
 ///
 /// Allocates and initializes a new queue that can store elements of the
@@ -39,6 +52,17 @@ typedef struct {
 /// @note The caller is responsible for calling queue_destroy()
 DSCQueue *queue_create(size_t element_size);
 
+/// @brief Creates a new queue that allocates through the given allocator
+///
+/// Like queue_create(), but the queue structure and its buffer are
+/// obtained from allocator instead of malloc().
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param allocator Allocator to use, or NULL for the default allocator
+/// @return Pointer to the newly created queue, or NULL on failure
+DSCQueue *queue_create_with_allocator(size_t element_size,
+                                      DSCAllocator const *allocator);
+
 /// @brief Destroys the queue and frees its memory
 ///
 /// Deallocates all memory associated with the queue, including the data
@@ -89,6 +113,33 @@ DSCError queue_push(DSCQueue *queue, void const *element);
 /// @note This operation is O(1)
 DSCError queue_pop(DSCQueue *queue);
 
+/// @brief Adds n elements to the back of the queue in one operation
+///
+/// Enqueues elements[0] first and elements[n - 1] last. The queue grows
+/// at most once and the elements are copied with at most two memcpys.
+///
+/// @param queue Pointer to the queue (must not be NULL)
+/// @param elements Array of n elements (can be NULL if n is 0)
+/// @param n Number of elements to add
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT queue is NULL, or elements is NULL
+///         and n is not 0
+/// @retval DSC_ERROR_MEMORY Memory allocation failed during growth
+/// @retval DSC_ERROR_OVERFLOW The capacity would overflow
+/// @note Nothing is added if an error is returned
+DSCError queue_push_n(DSCQueue *queue, void const *elements, size_t n);
+
+/// @brief Removes up to n elements from the front of the queue
+///
+/// Copies the first min(n, size) elements to out, front first, with at
+/// most two memcpys.
+///
+/// @param queue Pointer to the queue (can be NULL)
+/// @param out Buffer with room for n elements (can be NULL if n is 0)
+/// @param n Maximum number of elements to remove
+/// @return Number of elements removed, 0 if the queue is empty or NULL
+size_t queue_pop_n(DSCQueue *queue, void *out, size_t n);
+
 /// @brief Returns a pointer to the front element
 ///
 /// @param queue Pointer to the queue (must not be NULL)
@@ -120,8 +171,9 @@ void queue_clear(DSCQueue *queue);
 /// @brief Reserves space for at least n elements
 ///
 /// Ensures that the queue can hold at least n elements without
-/// requiring reallocation. If n is less than or equal to the current
-/// capacity, this function has no effect.
+/// requiring reallocation, rounding the capacity up to a power of two.
+/// If n is less than or equal to the current capacity, this function has
+/// no effect.
 ///
 /// @param queue Pointer to the queue (must not be NULL)
 /// @param n Minimum capacity to reserve
@@ -129,9 +181,63 @@ void queue_clear(DSCQueue *queue);
 /// @retval DSC_ERROR_OK Successfully reserved space
 /// @retval DSC_ERROR_INVALID_ARGUMENT queue is NULL
 /// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @retval DSC_ERROR_OVERFLOW The capacity would overflow
 /// @note This function never reduces the capacity
 DSCError queue_reserve(DSCQueue *queue, size_t n);
 
+/// @brief Exposes the elements in place, front first
+///
+/// Fills spans with the elements in queue order: spans[0] runs from the
+/// front towards the end of the buffer, and spans[1] holds the elements
+/// that wrapped around to its start. Unused spans have a count of 0.
+/// Process the elements, then drop them with queue_consume().
+///
+/// @param queue Pointer to the queue (can be NULL)
+/// @param spans Array of two spans to fill (must not be NULL)
+/// @return Number of non-empty spans: 0 if the queue is empty or NULL,
+///         otherwise 1 or 2
+/// @note The spans become invalid after any operation that modifies the
+///       queue's capacity (push, reserve, etc.)
+size_t queue_front_span(DSCQueue const *queue, DSCQueueSpan spans[2]);
+
+/// @brief Removes n elements from the front of the queue
+///
+/// @param queue Pointer to the queue (must not be NULL)
+/// @param n Number of elements to remove
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT queue is NULL
+/// @retval DSC_ERROR_EMPTY The queue holds fewer than n elements; nothing
+///         is removed
+/// @note This operation is O(1)
+DSCError queue_consume(DSCQueue *queue, size_t n);
+
+/// @brief Exposes room for n new elements at the back of the queue
+///
+/// Grows the queue if needed, then fills spans with the n slots after the
+/// back, in queue order. Write the elements in place, then append them
+/// with queue_commit(). Until then they are not part of the queue.
+///
+/// @param queue Pointer to the queue (must not be NULL)
+/// @param n Number of slots to expose
+/// @param spans Array of two spans to fill (must not be NULL); spans[1]
+///              has a count of 0 unless the slots wrap around
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT queue or spans is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed during growth
+/// @retval DSC_ERROR_OVERFLOW The capacity would overflow
+DSCError queue_write_span(DSCQueue *queue, size_t n, DSCQueueSpan spans[2]);
+
+/// @brief Appends n elements written through queue_write_span()
+///
+/// @param queue Pointer to the queue (must not be NULL)
+/// @param n Number of elements written, at most the n passed to
+///          queue_write_span()
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT queue is NULL
+/// @retval DSC_ERROR_OVERFLOW n exceeds the free space
+/// @note This operation is O(1)
+DSCError queue_commit(DSCQueue *queue, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
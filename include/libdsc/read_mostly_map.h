@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSC_READ_MOSTLY_MAP_H_
+#define DSC_READ_MOSTLY_MAP_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "libdsc/common.h"
+#include "libdsc/unordered_map.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Hash map with lock-free lookups for read-mostly workloads
+///
+/// Readers look keys up in an immutable DSCUnorderedMap without taking any
+/// lock. Writers are serialized by a mutex: each update copies the current
+/// table, modifies the copy, and publishes it with a single atomic pointer
+/// swap. Replaced tables are reclaimed with epoch-based reclamation once
+/// no reader can still be looking at them.
+///
+/// Every reader thread registers once and brackets its lookups with
+/// read_mostly_map_read_lock() and read_mostly_map_read_unlock(). Entering
+/// a read section stores the current epoch into the reader's own cache
+/// line; readers never write shared memory or perform read-modify-write
+/// atomics, so lookup throughput scales with the number of reader threads.
+///
+/// Updates cost O(capacity) to copy the table, so this map suits tables
+/// that are read constantly and changed rarely, such as configuration or
+/// routing data. Use read_mostly_map_update() to apply many changes with
+/// one copy.
+///
+/// ```c
+/// DSCReadMostlyReader *reader = read_mostly_map_register(map);
+///
+/// read_mostly_map_read_lock(reader);
+/// Route const *route = read_mostly_map_find(reader, &address);
+/// if (route) forward(packet, route);
+/// read_mostly_map_read_unlock(reader);
+///
+/// read_mostly_map_unregister(reader);
+/// ```
+///
+/// @note Writers serialize on a pthread mutex, so this container requires
+///       POSIX threads.
+/// @note This structure is opaque; use the functions below.
+typedef struct DSCReadMostlyMap DSCReadMostlyMap;
+
+/// @brief Per-thread reader registration for a DSCReadMostlyMap
+///
+/// @note A reader must only be used by one thread at a time.
+typedef struct DSCReadMostlyReader DSCReadMostlyReader;
+
+/// @brief Callback that applies a batch of changes to a private table copy
+///
+/// @param table Copy of the current table, not yet visible to readers
+/// @param context User pointer passed through from the caller
+/// @return DSC_ERROR_OK to publish the copy, or an error code to discard it
+typedef DSCError (*DSCReadMostlyUpdateFn)(DSCUnorderedMap *table,
+                                          void *context);
+
+/// @brief Creates a new read-mostly map
+///
+/// @param key_size Size of each key in bytes (must be > 0)
+/// @param value_size Size of each value in bytes (must be > 0)
+/// @param hash_fn Hash function for keys, or NULL to hash the raw key bytes
+/// @param compare_fn Comparison function for keys, or NULL to compare the
+///                   raw key bytes (must be NULL exactly when hash_fn is)
+/// @return Pointer to the newly created map, or NULL on failure
+/// @note The caller is responsible for calling read_mostly_map_destroy()
+DSCReadMostlyMap *read_mostly_map_create(size_t key_size, size_t value_size,
+                                         size_t (*hash_fn)(void const *),
+                                         int (*compare_fn)(void const *,
+                                                           void const *));
+
+/// @brief Destroys the map, its readers, and all retired tables
+///
+/// @param map Pointer to the map to destroy (can be NULL)
+/// @note No other thread may be using the map or any of its readers
+void read_mostly_map_destroy(DSCReadMostlyMap *map);
+
+/// @brief Registers the calling thread as a reader
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @return Reader handle, or NULL on failure
+/// @note Registration takes the writer mutex; do it once per thread, not
+///       per lookup. Slots of unregistered readers are reused.
+DSCReadMostlyReader *read_mostly_map_register(DSCReadMostlyMap *map);
+
+/// @brief Releases a reader registration
+///
+/// @param reader Reader handle (can be NULL; must not be in a read section)
+void read_mostly_map_unregister(DSCReadMostlyReader *reader);
+
+/// @brief Enters a read section
+///
+/// Tables retired after this call are not freed until the matching
+/// read_mostly_map_read_unlock(). Read sections do not nest.
+///
+/// @param reader Reader handle (must not be NULL)
+/// @note Wait-free; never blocks on writers
+void read_mostly_map_read_lock(DSCReadMostlyReader *reader);
+
+/// @brief Leaves a read section
+///
+/// @param reader Reader handle (must not be NULL)
+/// @note Pointers returned by read_mostly_map_find() become invalid
+void read_mostly_map_read_unlock(DSCReadMostlyReader *reader);
+
+/// @brief Looks up a key from inside a read section
+///
+/// @param reader Reader handle inside a read section (must not be NULL)
+/// @param key Pointer to the key to search for (must not be NULL)
+/// @return Pointer to the value, or NULL if the key is not present
+/// @note The value must not be modified. It stays valid until the reader
+///       leaves the read section, even if a writer replaces or erases it
+///       in the meantime.
+void const *read_mostly_map_find(DSCReadMostlyReader *reader,
+                                 void const *key);
+
+/// @brief Returns the number of key-value pairs in the latest table
+///
+/// @param map Pointer to the map (can be NULL)
+/// @return Number of pairs, or 0 if map is NULL
+size_t read_mostly_map_size(DSCReadMostlyMap *map);
+
+/// @brief Inserts or updates a key-value pair
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key to insert (must not be NULL)
+/// @param value Pointer to the value to store (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT map, key, or value is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @note Copies the whole table; batch changes with read_mostly_map_update()
+DSCError read_mostly_map_insert(DSCReadMostlyMap *map, void const *key,
+                                void const *value);
+
+/// @brief Removes a key-value pair
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key to remove (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT map or key is NULL
+/// @retval DSC_ERROR_NOT_FOUND Key not found in map
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+DSCError read_mostly_map_erase(DSCReadMostlyMap *map, void const *key);
+
+/// @brief Applies a batch of changes and publishes them atomically
+///
+/// Copies the current table once, passes the copy to update, and publishes
+/// it if update succeeds. Readers see either none or all of the changes.
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param update Callback that modifies the copy (must not be NULL)
+/// @param context User pointer passed to update
+/// @return DSC_ERROR_OK on success, or the error returned by update
+/// @retval DSC_ERROR_INVALID_ARGUMENT map or update is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @note update must not keep the table pointer or call back into the map
+DSCError read_mostly_map_update(DSCReadMostlyMap *map,
+                                DSCReadMostlyUpdateFn update, void *context);
+
+/// @brief Waits until every retired table has been freed
+///
+/// Blocks until all readers that might still see an old table have left
+/// their read sections. Without it, retired tables are freed lazily by
+/// later updates.
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @note Must not be called from inside a read section
+void read_mostly_map_synchronize(DSCReadMostlyMap *map);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_READ_MOSTLY_MAP_H_
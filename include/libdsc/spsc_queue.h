@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSC_SPSC_QUEUE_H_
+#define DSC_SPSC_QUEUE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "libdsc/common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief Lock-free bounded FIFO queue for one producer and one consumer
+///
+/// A fixed-capacity ring buffer like DSCQueue, for handing elements from
+/// exactly one producer thread to exactly one consumer thread. The
+/// capacity is a power of two so positions wrap with a mask, and the
+/// buffer never grows.
+///
+/// The producer's tail index and the consumer's head index live on
+/// separate cache lines. Each side also keeps a private copy of the
+/// other side's index and only reloads it when the copy says the queue is
+/// full (or empty), so in steady state each side touches the shared line
+/// of the other at most once per wrap of the free space. Synchronization
+/// uses acquire loads and release stores only; there are no locks and no
+/// read-modify-write atomics.
+///
+/// spsc_queue_push_n() and spsc_queue_pop_n() move as many elements as
+/// fit with one index update, which is the fastest way to stream data.
+///
+/// ```c
+/// // I/O thread
+/// while (spsc_queue_push(queue, &packet) == DSC_ERROR_FULL) {
+///     // back off
+/// }
+///
+/// // Worker thread
+/// Packet batch[64];
+/// size_t count = spsc_queue_pop_n(queue, batch, 64);
+/// ```
+///
+/// @note This structure is opaque; use the functions below.
+typedef struct DSCSpscQueue DSCSpscQueue;
+
+/// @brief Creates a new single-producer/single-consumer queue
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param capacity Maximum number of elements (must be > 0), rounded up to
+///                 a power of two
+/// @return Pointer to the newly created queue, or NULL on failure
+/// @note The caller is responsible for calling spsc_queue_destroy()
+DSCSpscQueue *spsc_queue_create(size_t element_size, size_t capacity);
+
+/// @brief Destroys the queue and frees its memory
+///
+/// @param queue Pointer to the queue to destroy (can be NULL)
+/// @note No other thread may be using the queue
+void spsc_queue_destroy(DSCSpscQueue *queue);
+
+/// @brief Returns the capacity of the queue
+///
+/// @param queue Pointer to the queue (can be NULL)
+/// @return Maximum number of elements, or 0 if queue is NULL
+size_t spsc_queue_capacity(DSCSpscQueue const *queue);
+
+/// @brief Returns the number of elements in the queue
+///
+/// @param queue Pointer to the queue (can be NULL)
+/// @return Number of elements, or 0 if queue is NULL
+/// @note While both threads are active the result is only a snapshot
+size_t spsc_queue_size(DSCSpscQueue const *queue);
+
+/// @brief Checks if the queue is empty
+///
+/// @param queue Pointer to the queue (can be NULL)
+/// @return true if the queue is empty or NULL, false otherwise
+/// @note While both threads are active the result is only a snapshot
+bool spsc_queue_empty(DSCSpscQueue const *queue);
+
+/// @brief Copies an element to the back of the queue
+///
+/// @param queue Pointer to the queue (must not be NULL)
+/// @param element Pointer to the element to copy (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT queue or element is NULL
+/// @retval DSC_ERROR_FULL The queue is full
+/// @note Producer thread only. Wait-free.
+DSCError spsc_queue_push(DSCSpscQueue *queue, void const *element);
+
+/// @brief Copies up to count elements to the back of the queue
+///
+/// Pushes the longest prefix of elements that fits and publishes it to
+/// the consumer at once.
+///
+/// @param queue Pointer to the queue (can be NULL)
+/// @param elements Array of count elements (can be NULL if count is 0)
+/// @param count Number of elements to push
+/// @return Number of elements pushed, 0 if the queue is full or queue or
+///         elements is NULL
+/// @note Producer thread only. Wait-free.
+size_t spsc_queue_push_n(DSCSpscQueue *queue, void const *elements,
+                         size_t count);
+
+/// @brief Moves the front element out of the queue
+///
+/// @param queue Pointer to the queue (must not be NULL)
+/// @param out Buffer receiving the element (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT queue or out is NULL
+/// @retval DSC_ERROR_EMPTY The queue is empty
+/// @note Consumer thread only. Wait-free.
+DSCError spsc_queue_pop(DSCSpscQueue *queue, void *out);
+
+/// @brief Moves up to count elements out of the front of the queue
+///
+/// @param queue Pointer to the queue (can be NULL)
+/// @param out Buffer with room for count elements (can be NULL if count
+///            is 0)
+/// @param count Maximum number of elements to pop
+/// @return Number of elements popped, 0 if the queue is empty or queue or
+///         out is NULL
+/// @note Consumer thread only. Wait-free.
+size_t spsc_queue_pop_n(DSCSpscQueue *queue, void *out, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_SPSC_QUEUE_H_
@@ -22,6 +22,7 @@ typedef struct {
     size_t size;         ///< Number of elements currently stored
     size_t capacity;     ///< Total capacity of the data buffer
     size_t element_size; ///< Size of each element in bytes
+    DSCAllocator allocator; ///< Source of the structure and data buffer
 } DSCStack;
 
 /// @brief Creates a new stack with the specified element size
@@ -48,6 +49,17 @@ typedef struct {
 /// @see stack_destroy()
 DSCStack *stack_create(size_t element_size);
 
+/// @brief Creates a new stack that allocates through the given allocator
+///
+/// Like stack_create(), but the stack structure and its data buffer are
+/// obtained from allocator instead of malloc().
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param allocator Allocator to use, or NULL for the default allocator
+/// @return Pointer to the newly created stack, or NULL on failure
+DSCStack *stack_create_with_allocator(size_t element_size,
+                                      DSCAllocator const *allocator);
+
 /// @brief Destroys the stack and frees its memory
 ///
 /// Deallocates all memory associated with the stack, including the data
@@ -126,6 +138,38 @@ DSCError stack_push(DSCStack *stack, const void *element);
 /// @note Use stack_top() to access the element before popping
 DSCError stack_pop(DSCStack *stack);
 
+/// @brief Pushes n elements onto the stack in one operation
+///
+/// Pushes elements[0] first and elements[n - 1] last, so the last one
+/// ends up on top. The stack grows at most once and the elements are
+/// copied with a single memcpy.
+///
+/// @param stack Pointer to the stack (must not be NULL)
+/// @param elements Array of n elements (can be NULL if n is 0)
+/// @param n Number of elements to push
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT stack is NULL, or elements is NULL
+///         and n is not 0
+/// @retval DSC_ERROR_MEMORY Memory allocation failed during growth
+/// @retval DSC_ERROR_OVERFLOW The capacity would overflow
+///
+/// @note Nothing is pushed if an error is returned
+DSCError stack_push_n(DSCStack *stack, void const *elements, size_t n);
+
+/// @brief Pops up to n elements off the stack in one operation
+///
+/// Copies the top min(n, size) elements to out in the order they were
+/// pushed, so stack_pop_n() undoes stack_push_n() with the same array:
+/// the former top element ends up last.
+///
+/// @param stack Pointer to the stack (can be NULL)
+/// @param out Buffer with room for n elements (can be NULL if n is 0)
+/// @param n Maximum number of elements to pop
+/// @return Number of elements popped, 0 if the stack is empty or NULL
+///
+/// @note The elements are copied with a single memcpy
+size_t stack_pop_n(DSCStack *stack, void *out, size_t n);
+
 /// @brief Returns a pointer to the top element of the stack
 ///
 /// @param stack Pointer to the stack (must not be NULL)
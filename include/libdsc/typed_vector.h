@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/// @file typed_vector.h
+/// @brief Generator for type-specialised dynamic arrays
+///
+/// DSC_DEFINE_VECTOR(name, T) defines a vector type `name` storing
+/// elements of type T, together with static inline functions that mirror
+/// the DSCVector API. Elements are passed by value and stored in a T
+/// array, so copies are plain assignments the compiler can inline and
+/// vectorise instead of memcpy() calls of a runtime size.
+///
+/// @example
+/// ```c
+/// #include <libdsc/typed_vector.h>
+///
+/// DSC_DEFINE_VECTOR(int_vector, int)
+///
+/// int_vector *vec = int_vector_create();
+/// int_vector_push_back(vec, 42);
+/// int first = *int_vector_at(vec, 0);
+/// int_vector_destroy(vec);
+/// ```
+
+#ifndef DSC_TYPED_VECTOR_H_
+#define DSC_TYPED_VECTOR_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "libdsc/common.h"
+#include "libdsc/vector.h"
+
+/// @brief Defines the vector type name for elements of type T
+///
+/// Expands to the type and the following static inline functions, each
+/// prefixed with name_ and behaving like its vector_ counterpart:
+///
+/// - create(), destroy(vec)
+/// - size(vec), empty(vec), capacity(vec)
+/// - reserve(vec, n), resize(vec, n), shrink_to_fit(vec)
+/// - push_back(vec, value), pop_back(vec)
+/// - at(vec, index), front(vec), back(vec), returning T pointers
+/// - insert(vec, index, value), erase(vec, index), clear(vec)
+///
+/// Use at file scope, once per name in a translation unit. T must be a
+/// complete type that can be copied by assignment.
+///
+/// @param name Name of the generated type and prefix of its functions
+/// @param T Element type
+#define DSC_DEFINE_VECTOR(name, T)                                           \
+    typedef struct name {                                                    \
+        T *data;         /* Element array */                                 \
+        size_t size;     /* Number of elements currently stored */           \
+        size_t capacity; /* Number of elements data can hold */              \
+    } name;                                                                  \
+                                                                             \
+    static inline DSCError name##_reserve(name *vec, size_t n) {             \
+        if (!vec) return DSC_ERROR_INVALID_ARGUMENT;                         \
+        if (n <= vec->capacity) return DSC_ERROR_OK;                         \
+                                                                             \
+        size_t bytes;                                                        \
+        if (!dsc_safe_multiply(n, sizeof(T), &bytes)) {                      \
+            return DSC_ERROR_OVERFLOW;                                       \
+        }                                                                    \
+        T *data = (T *)dsc_realloc(vec->data, bytes);                        \
+        if (!data) return DSC_ERROR_MEMORY;                                  \
+                                                                             \
+        vec->data = data;                                                    \
+        vec->capacity = n;                                                   \
+        return DSC_ERROR_OK;                                                 \
+    }                                                                        \
+                                                                             \
+    /* Doubles the capacity, starting over after shrink_to_fit(). */         \
+    static inline DSCError name##_grow_(name *vec) {                         \
+        size_t new_capacity = DSC_VECTOR_INITIAL_CAPACITY;                   \
+        if (vec->capacity > 0 &&                                             \
+            !dsc_safe_grow_capacity(vec->capacity, &new_capacity)) {         \
+            return DSC_ERROR_OVERFLOW;                                       \
+        }                                                                    \
+        return name##_reserve(vec, new_capacity);                            \
+    }                                                                        \
+                                                                             \
+    static inline name *name##_create(void) {                                \
+        name *vec = (name *)dsc_malloc(sizeof(name));                        \
+        if (!vec) return NULL;                                               \
+                                                                             \
+        vec->data = NULL;                                                    \
+        vec->size = 0;                                                       \
+        vec->capacity = 0;                                                   \
+        if (name##_reserve(vec, DSC_VECTOR_INITIAL_CAPACITY) !=              \
+            DSC_ERROR_OK) {                                                  \
+            dsc_free(vec);                                                   \
+            return NULL;                                                     \
+        }                                                                    \
+        return vec;                                                          \
+    }                                                                        \
+                                                                             \
+    static inline void name##_destroy(name *vec) {                           \
+        if (!vec) return;                                                    \
+        dsc_free(vec->data);                                                 \
+        dsc_free(vec);                                                       \
+    }                                                                        \
+                                                                             \
+    static inline size_t name##_size(name const *vec) {                      \
+        return vec ? vec->size : 0;                                          \
+    }                                                                        \
+                                                                             \
+    static inline bool name##_empty(name const *vec) {                       \
+        return vec ? vec->size == 0 : true;                                  \
+    }                                                                        \
+                                                                             \
+    static inline size_t name##_capacity(name const *vec) {                  \
+        return vec ? vec->capacity : 0;                                      \
+    }                                                                        \
+                                                                             \
+    /* New elements are zero-filled. */                                      \
+    static inline DSCError name##_resize(name *vec, size_t n) {              \
+        if (!vec) return DSC_ERROR_INVALID_ARGUMENT;                         \
+                                                                             \
+        DSCError err = name##_reserve(vec, n);                               \
+        if (err != DSC_ERROR_OK) return err;                                 \
+                                                                             \
+        if (n > vec->size) {                                                 \
+            memset(vec->data + vec->size, 0, (n - vec->size) * sizeof(T));   \
+        }                                                                    \
+        vec->size = n;                                                       \
+        return DSC_ERROR_OK;                                                 \
+    }                                                                        \
+                                                                             \
+    static inline DSCError name##_push_back(name *vec, T value) {            \
+        if (!vec) return DSC_ERROR_INVALID_ARGUMENT;                         \
+                                                                             \
+        if (vec->size == vec->capacity) {                                    \
+            DSCError err = name##_grow_(vec);                                \
+            if (err != DSC_ERROR_OK) return err;                             \
+        }                                                                    \
+        vec->data[vec->size++] = value;                                      \
+        return DSC_ERROR_OK;                                                 \
+    }                                                                        \
+                                                                             \
+    static inline DSCError name##_pop_back(name *vec) {                      \
+        if (!vec) return DSC_ERROR_INVALID_ARGUMENT;                         \
+        if (vec->size == 0) return DSC_ERROR_EMPTY;                          \
+                                                                             \
+        --(vec->size);                                                       \
+        return DSC_ERROR_OK;                                                 \
+    }                                                                        \
+                                                                             \
+    static inline T *name##_at(name *vec, size_t index) {                    \
+        if (!vec || index >= vec->size) return NULL;                         \
+        return vec->data + index;                                            \
+    }                                                                        \
+                                                                             \
+    static inline T *name##_front(name *vec) { return name##_at(vec, 0); }   \
+                                                                             \
+    static inline T *name##_back(name *vec) {                                \
+        if (!vec || vec->size == 0) return NULL;                             \
+        return vec->data + vec->size - 1;                                    \
+    }                                                                        \
+                                                                             \
+    static inline DSCError name##_insert(name *vec, size_t index, T value) { \
+        if (!vec) return DSC_ERROR_INVALID_ARGUMENT;                         \
+        if (index > vec->size) return DSC_ERROR_INVALID_ARGUMENT;            \
+                                                                             \
+        if (vec->size == vec->capacity) {                                    \
+            DSCError err = name##_grow_(vec);                                \
+            if (err != DSC_ERROR_OK) return err;                             \
+        }                                                                    \
+        memmove(vec->data + index + 1, vec->data + index,                    \
+                (vec->size - index) * sizeof(T));                            \
+        vec->data[index] = value;                                            \
+        ++(vec->size);                                                       \
+        return DSC_ERROR_OK;                                                 \
+    }                                                                        \
+                                                                             \
+    static inline DSCError name##_erase(name *vec, size_t index) {           \
+        if (!vec) return DSC_ERROR_INVALID_ARGUMENT;                         \
+        if (index >= vec->size) return DSC_ERROR_INVALID_ARGUMENT;           \
+                                                                             \
+        memmove(vec->data + index, vec->data + index + 1,                    \
+                (vec->size - index - 1) * sizeof(T));                        \
+        --(vec->size);                                                       \
+        return DSC_ERROR_OK;                                                 \
+    }                                                                        \
+                                                                             \
+    static inline void name##_clear(name *vec) {                             \
+        if (vec) vec->size = 0;                                              \
+    }                                                                        \
+                                                                             \
+    static inline DSCError name##_shrink_to_fit(name *vec) {                 \
+        if (!vec) return DSC_ERROR_INVALID_ARGUMENT;                         \
+        if (vec->size == vec->capacity) return DSC_ERROR_OK;                 \
+                                                                             \
+        if (vec->size == 0) {                                                \
+            dsc_free(vec->data);                                             \
+            vec->data = NULL;                                                \
+            vec->capacity = 0;                                               \
+            return DSC_ERROR_OK;                                             \
+        }                                                                    \
+        T *data = (T *)dsc_realloc(vec->data, vec->size * sizeof(T));        \
+        if (!data) return DSC_ERROR_MEMORY;                                  \
+                                                                             \
+        vec->data = data;                                                    \
+        vec->capacity = vec->size;                                           \
+        return DSC_ERROR_OK;                                                 \
+    }
+
+#endif  // DSC_TYPED_VECTOR_H_
@@ -5,8 +5,10 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "libdsc/common.h"
+#include "libdsc/hash.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,19 +18,35 @@ extern "C" {
 ///
 /// A hash table that stores key-value pairs with O(1) average time
 /// complexity for insertions, lookups, and deletions. Uses open
-/// addressing with linear probing for collision resolution.
+/// addressing with one control byte per slot: lookups compare the 7-bit
+/// hash fingerprints of a whole group of slots at once (SSE2, NEON or a
+/// portable SWAR fallback) and only call compare_fn on fingerprint matches.
+/// Maps can be switched to Robin Hood probing with
+/// unordered_map_set_probe_mode() and to incremental resizing with
+/// unordered_map_set_incremental_rehash(). A map can be written to a file
+/// with unordered_map_save() and mapped back read-only with
+/// unordered_map_open_mapped().
 ///
 /// @note This structure should be treated as opaque.
-typedef struct {
+typedef struct DSCUnorderedMap {
     void *keys;                                    ///< Array of keys
     void *values;                                  ///< Array of values
-    size_t *hashes;                                ///< Array of hash values
+    int8_t *ctrl;                                  ///< Control byte per slot
+    uint8_t *dist;                                 ///< Probe distance per slot (Robin Hood only)
     size_t size;                                   ///< Number of key-value pairs
-    size_t capacity;                               ///< Total capacity
+    size_t capacity;                               ///< Total capacity (power of two)
+    size_t growth_left;                            ///< Inserts left before rehash
+    DSCProbeMode probe_mode;                       ///< Collision resolution strategy
+    struct DSCUnorderedMap *old_table;             ///< Table being migrated, or NULL
+    size_t rehash_pos;                             ///< Next old_table slot to migrate
+    bool incremental_rehash;                       ///< Whether growth migrates lazily
+    void *mapping;                                 ///< Read-only file mapping, or NULL
+    size_t mapping_size;                           ///< Size of mapping in bytes
     size_t key_size;                               ///< Size of each key in bytes
     size_t value_size;                             ///< Size of each value in bytes
     size_t (*hash_fn)(void const *);               ///< Hash function for keys
     int (*compare_fn)(void const *, void const *); ///< Comparison function for keys
+    DSCAllocator allocator;                        ///< Source of the structure and tables
 } DSCUnorderedMap;
 
 /// @brief Creates a new unordered map
@@ -38,15 +56,36 @@ typedef struct {
 ///
 /// @param key_size Size of each key in bytes (must be > 0)
 /// @param value_size Size of each value in bytes (must be > 0)
-/// @param hash_fn Hash function for keys (must not be NULL)
-/// @param compare_fn Comparison function for keys (must not be NULL)
+/// @param hash_fn Hash function for keys, or NULL to hash the raw key bytes
+///                with dsc_hash_bytes()
+/// @param compare_fn Comparison function for keys, or NULL to compare the
+///                   raw key bytes (must be NULL exactly when hash_fn is)
 /// @return Pointer to the newly created map, or NULL on failure
 /// @note The caller is responsible for calling unordered_map_destroy()
+/// @note Hashes from hash_fn are re-mixed before use, but hash functions
+///       from libdsc/hash.h avoid clustering on sequential keys entirely
 DSCUnorderedMap *unordered_map_create(size_t key_size, size_t value_size,
                                        size_t (*hash_fn)(void const *),
                                        int (*compare_fn)(void const *,
                                                          void const *));
 
+/// @brief Creates a new unordered map that allocates through an allocator
+///
+/// Like unordered_map_create(), but the map structure and its tables are
+/// obtained from allocator instead of malloc(). Clones made with
+/// unordered_map_clone() use the same allocator.
+///
+/// @param key_size Size of each key in bytes (must be > 0)
+/// @param value_size Size of each value in bytes (must be > 0)
+/// @param hash_fn As for unordered_map_create()
+/// @param compare_fn As for unordered_map_create()
+/// @param allocator Allocator to use, or NULL for the default allocator
+/// @return Pointer to the newly created map, or NULL on failure
+DSCUnorderedMap *unordered_map_create_with_allocator(
+    size_t key_size, size_t value_size, size_t (*hash_fn)(void const *),
+    int (*compare_fn)(void const *, void const *),
+    DSCAllocator const *allocator);
+
 /// @brief Destroys the unordered map and frees its memory
 ///
 /// Deallocates all memory associated with the map, including the data
@@ -56,6 +95,18 @@ DSCUnorderedMap *unordered_map_create(size_t key_size, size_t value_size,
 /// @note This function is safe to call with a NULL pointer
 void unordered_map_destroy(DSCUnorderedMap *map);
 
+/// @brief Creates an independent copy of the map
+///
+/// Copies the table arrays as they are rather than reinserting every pair,
+/// so no keys are rehashed. The copy has the same hash and compare
+/// functions, probing mode, and rehash settings as the original.
+///
+/// @param map Pointer to the map to copy (can be NULL)
+/// @return Pointer to the new map, or NULL if map is NULL or memory
+///         allocation failed
+/// @note The caller is responsible for calling unordered_map_destroy()
+DSCUnorderedMap *unordered_map_clone(DSCUnorderedMap const *map);
+
 /// @brief Returns the number of key-value pairs in the map
 ///
 /// @param map Pointer to the map (can be NULL)
@@ -86,6 +137,50 @@ bool unordered_map_empty(DSCUnorderedMap const *map);
 DSCError unordered_map_insert(DSCUnorderedMap *map, void const *key,
                                void const *value);
 
+/// @brief Returns the hash the map uses for a key
+///
+/// The result can be passed to the *_hashed() functions to hash a key
+/// once for several operations, or computed ahead of time.
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key (must not be NULL)
+/// @return Hash of the key, or 0 if parameters are invalid
+size_t unordered_map_hash(DSCUnorderedMap const *map, void const *key);
+
+/// @brief Finds a key, inserting it if it is absent
+///
+/// Looks the key up with a single hash and probe and, if it is absent,
+/// inserts it with a zero-filled value. Either way, returns the value
+/// slot so that it can be updated in place, which makes patterns like
+/// counting keys one lookup instead of a find followed by an insert:
+///
+/// ```c
+/// int *count = unordered_map_try_emplace(map, &word, NULL);
+/// if (count) ++*count;
+/// ```
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key (must not be NULL)
+/// @param inserted Receives true if the key was inserted (can be NULL)
+/// @return Pointer to the value of the key, or NULL if parameters are
+///         invalid or memory allocation failed
+/// @note The returned pointer is invalidated like that of
+///       unordered_map_find()
+void *unordered_map_try_emplace(DSCUnorderedMap *map, void const *key,
+                                bool *inserted);
+
+/// @brief Finds a key with a precomputed hash, inserting it if absent
+///
+/// Same as unordered_map_try_emplace(), but skips hashing the key.
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key (must not be NULL)
+/// @param hash Hash of the key; must equal unordered_map_hash(map, key)
+/// @param inserted Receives true if the key was inserted (can be NULL)
+/// @return Pointer to the value of the key, or NULL on failure
+void *unordered_map_try_emplace_hashed(DSCUnorderedMap *map, void const *key,
+                                       size_t hash, bool *inserted);
+
 /// @brief Finds a value by key
 ///
 /// Searches for the specified key and returns a pointer to its associated value.
@@ -98,6 +193,35 @@ DSCError unordered_map_insert(DSCUnorderedMap *map, void const *key,
 ///       modify the map's capacity (insert, reserve, etc.)
 void *unordered_map_find(DSCUnorderedMap *map, void const *key);
 
+/// @brief Finds a value by key with a precomputed hash
+///
+/// Same as unordered_map_find(), but skips hashing the key.
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key to search for (must not be NULL)
+/// @param hash Hash of the key; must equal unordered_map_hash(map, key)
+/// @return Pointer to the value if found, NULL otherwise
+void *unordered_map_find_hashed(DSCUnorderedMap *map, void const *key,
+                                size_t hash);
+
+/// @brief Finds the values of many keys at once
+///
+/// Equivalent to calling unordered_map_find() for each key, but hashes a
+/// batch of keys and prefetches their home slots before probing any of
+/// them, so the cache misses of a batch overlap instead of being paid one
+/// after another. Worthwhile for large tables that do not fit in cache.
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param keys Array of n keys, each key_size bytes
+/// @param n Number of keys to look up
+/// @param values Receives n pointers: the value of each key, or NULL if
+///               the key is not in the map
+/// @return Number of keys found, or 0 if parameters are invalid
+/// @note The returned pointers are invalidated like those of
+///       unordered_map_find()
+size_t unordered_map_find_batch(DSCUnorderedMap *map, void const *keys,
+                                size_t n, void **values);
+
 /// @brief Removes a key-value pair from the map
 ///
 /// Removes the key-value pair with the specified key from the map.
@@ -108,9 +232,23 @@ void *unordered_map_find(DSCUnorderedMap *map, void const *key);
 /// @retval DSC_ERROR_OK Successfully removed key-value pair
 /// @retval DSC_ERROR_INVALID_ARGUMENT map or key is NULL
 /// @retval DSC_ERROR_NOT_FOUND Key not found in map
+/// @retval DSC_ERROR_MEMORY Memory allocation failed while migrating pairs
+///         during an incremental rehash
 /// @note Average time complexity is O(1)
 DSCError unordered_map_erase(DSCUnorderedMap *map, void const *key);
 
+/// @brief Removes a key-value pair with a precomputed hash
+///
+/// Same as unordered_map_erase(), but skips hashing the key.
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param key Pointer to the key to remove (must not be NULL)
+/// @param hash Hash of the key; must equal unordered_map_hash(map, key)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_NOT_FOUND Key not found in map
+DSCError unordered_map_erase_hashed(DSCUnorderedMap *map, void const *key,
+                                    size_t hash);
+
 /// @brief Removes all key-value pairs from the map
 ///
 /// Removes all elements from the map, making it empty. The capacity
@@ -124,8 +262,10 @@ void unordered_map_clear(DSCUnorderedMap *map);
 /// @brief Reserves space for at least n key-value pairs
 ///
 /// Ensures that the map can hold at least n key-value pairs without
-/// requiring reallocation. If n is less than or equal to the current
-/// capacity, this function has no effect.
+/// requiring reallocation. The capacity is rounded up to a power of two
+/// large enough to keep the load factor below the maximum of the map's
+/// probe mode (0.75, or 0.9 with Robin Hood probing). If the map can
+/// already hold n pairs, this function has no effect.
 ///
 /// @param map Pointer to the map (must not be NULL)
 /// @param n Minimum capacity to reserve
@@ -136,6 +276,137 @@ void unordered_map_clear(DSCUnorderedMap *map);
 /// @note This function never reduces the capacity
 DSCError unordered_map_reserve(DSCUnorderedMap *map, size_t n);
 
+/// @brief Selects the collision resolution strategy of the map
+///
+/// With DSC_PROBE_ROBIN_HOOD, every slot records how far its element is
+/// from its home slot and inserts keep elements that are far from home
+/// ahead of those that are close. An unsuccessful lookup can then stop as
+/// soon as it is further from home than the element it is looking at,
+/// which bounds misses even with clustered hashes and lets the map run at
+/// a load factor of 0.9. Erase shifts the rest of the run back by one
+/// slot instead of leaving a tombstone. The map is rebuilt in the new mode.
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param mode DSC_PROBE_GROUP (the default) or DSC_PROBE_ROBIN_HOOD
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_OK Successfully switched (or already in that mode)
+/// @retval DSC_ERROR_INVALID_ARGUMENT map is NULL or mode is unknown
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @note Probe distances are limited to 255 slots. A Robin Hood map whose
+///       hash function is degenerate enough to exceed that falls back to
+///       group probing; see unordered_map_probe_mode().
+/// @note Invalidates pointers into the map and iteration cursors
+DSCError unordered_map_set_probe_mode(DSCUnorderedMap *map,
+                                      DSCProbeMode mode);
+
+/// @brief Returns the collision resolution strategy of the map
+///
+/// @param map Pointer to the map (can be NULL)
+/// @return The current probe mode, or DSC_PROBE_GROUP if map is NULL
+DSCProbeMode unordered_map_probe_mode(DSCUnorderedMap const *map);
+
+/// @brief Enables or disables incremental rehashing
+///
+/// By default, the insert that fills the map migrates every pair into a
+/// larger table before returning, which stalls that one insert for a time
+/// proportional to the size of the map. With incremental rehashing, the
+/// insert only allocates the new table: the old table stays alongside it
+/// and every later insert, find and erase migrates a fixed number of old
+/// slots (128), so no single operation does more than a bounded amount
+/// of migration work. Lookups check the new table, then the old one.
+///
+/// @param map Pointer to the map (must not be NULL)
+/// @param enabled true to resize incrementally, false to resize at once
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_OK Successfully changed the setting
+/// @retval DSC_ERROR_INVALID_ARGUMENT map is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed while completing a
+///         pending migration
+/// @note Disabling finishes any pending migration
+/// @note While a migration is pending, find and erase may also move pairs,
+///       invalidating pointers into the map and iteration cursors
+DSCError unordered_map_set_incremental_rehash(DSCUnorderedMap *map,
+                                              bool enabled);
+
+/// @brief Advances an iteration over the key-value pairs of the map
+///
+/// Finds the first key-value pair stored at or after the position held in
+/// cursor, reports it through key and value, and moves cursor past it.
+/// Start with a cursor of 0 and call repeatedly until it returns false:
+///
+/// ```c
+/// size_t cursor = 0;
+/// void *key, *value;
+/// while (unordered_map_next(map, &cursor, &key, &value)) {
+///     // use key and value
+/// }
+/// ```
+///
+/// @param map Pointer to the map (can be NULL)
+/// @param cursor Iteration position, 0 to start (must not be NULL)
+/// @param key Receives a pointer to the key (can be NULL)
+/// @param value Receives a pointer to the value (can be NULL)
+/// @return true if a key-value pair was found, false at the end of the map
+/// @note Pairs are visited in unspecified order. Inserting into the map
+///       invalidates the cursor; erasing the pair just visited does not,
+///       except with Robin Hood probing, where erase moves later pairs
+///       back into the freed slot, or during an incremental rehash.
+/// @note Empty regions are skipped 64 slots at a time, so a full pass is
+///       O(capacity / 64 + size)
+bool unordered_map_next(DSCUnorderedMap const *map, size_t *cursor,
+                        void **key, void **value);
+
+/// @brief Writes the map to a file that can be memory-mapped
+///
+/// Stores the table arrays verbatim behind a versioned header, with every
+/// array at a 64-byte aligned offset, so unordered_map_open_mapped() can
+/// use them in place. The file is written next to path and renamed over
+/// it, so processes that still map an older file keep a consistent view.
+///
+/// @param map Pointer to the map to save (must not be NULL)
+/// @param path Destination path (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT map or path is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @retval DSC_ERROR_IO The file could not be written, or the platform
+///         does not support table files (only POSIX systems do)
+/// @note Keys and values are written as raw bytes, so they must not
+///       contain pointers (for example, char * string keys)
+/// @note The file can only be opened by builds with the same byte order,
+///       size_t width and control-byte group width (SSE2 and NEON builds
+///       use 16-slot groups, portable builds 8)
+DSCError unordered_map_save(DSCUnorderedMap const *map, char const *path);
+
+/// @brief Opens a saved map by memory-mapping its file
+///
+/// Maps the file read-only and shared, and points the map's arrays into
+/// the mapping without reading or copying them, so opening takes O(1)
+/// time regardless of the table size. Pages are loaded on first access
+/// and shared with every other process mapping the same file.
+///
+/// The returned map supports lookups and iteration. Operations that would
+/// modify it fail with DSC_ERROR_READ_ONLY (try_emplace returns NULL and
+/// clear does nothing); use unordered_map_clone() for a writable copy.
+///
+/// @param path Path of a file written by unordered_map_save()
+/// @param key_size Size of each key in bytes (must match the file)
+/// @param value_size Size of each value in bytes (must match the file)
+/// @param hash_fn Hash function the map was built with, or NULL if it
+///                hashed raw key bytes
+/// @param compare_fn Comparison function for keys, or NULL to compare the
+///                   raw key bytes (must be NULL exactly when hash_fn is)
+/// @return Pointer to the mapped map, or NULL if the file cannot be mapped
+///         (always the case on non-POSIX platforms), was written by an
+///         incompatible build, or does not match the given sizes
+/// @note hash_fn must be the function the saved map used; the file only
+///       records whether one was used
+/// @note The caller is responsible for calling unordered_map_destroy(),
+///       which unmaps the file
+DSCUnorderedMap *unordered_map_open_mapped(
+    char const *path, size_t key_size, size_t value_size,
+    size_t (*hash_fn)(void const *),
+    int (*compare_fn)(void const *, void const *));
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,8 +5,10 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "libdsc/common.h"
+#include "libdsc/hash.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,17 +18,28 @@ extern "C" {
 ///
 /// A hash table that stores unique elements with O(1) average time
 /// complexity for insertions, lookups, and deletions. Uses open
-/// addressing with linear probing for collision resolution.
+/// addressing with one control byte per slot (empty, deleted, or a 7-bit
+/// hash fingerprint) probed a group of slots at a time, so any hash
+/// value, including 0, is valid. Sets can be switched to Robin Hood
+/// probing with unordered_set_set_probe_mode(), and saved to a file that
+/// can be mapped back read-only with unordered_set_save() and
+/// unordered_set_open_mapped().
 ///
 /// @note This structure should be treated as opaque.
 typedef struct {
     void *elements;                                ///< Array of elements
-    size_t *hashes;                                ///< Array of hash values
+    int8_t *ctrl;                                  ///< Control byte per slot
+    uint8_t *dist;                                 ///< Probe distance per slot (Robin Hood only)
     size_t size;                                   ///< Number of elements
-    size_t capacity;                               ///< Total capacity
+    size_t capacity;                               ///< Total capacity (power of two)
+    size_t growth_left;                            ///< Inserts left before rehash
+    DSCProbeMode probe_mode;                       ///< Collision resolution strategy
+    void *mapping;                                 ///< Read-only file mapping, or NULL
+    size_t mapping_size;                           ///< Size of mapping in bytes
     size_t element_size;                           ///< Size of each element in bytes
     size_t (*hash_fn)(void const *);               ///< Hash function for elements
     int (*compare_fn)(void const *, void const *); ///< Comparison function for elements
+    DSCAllocator allocator;                        ///< Source of the structure and table
 } DSCUnorderedSet;
 
 /// @brief Creates a new unordered set
@@ -35,8 +48,11 @@ typedef struct {
 /// of the specified size using the provided hash and comparison functions.
 ///
 /// @param element_size Size of each element in bytes (must be > 0)
-/// @param hash_fn Hash function for elements (must not be NULL)
-/// @param compare_fn Comparison function for elements (must not be NULL)
+/// @param hash_fn Hash function for elements, or NULL to hash the raw
+///                element bytes with dsc_hash_bytes()
+/// @param compare_fn Comparison function for elements, or NULL to compare
+///                   the raw element bytes (must be NULL exactly when
+///                   hash_fn is)
 /// @return Pointer to the newly created set, or NULL on failure
 /// @note The caller is responsible for calling unordered_set_destroy()
 DSCUnorderedSet *unordered_set_create(size_t element_size,
@@ -44,6 +60,21 @@ DSCUnorderedSet *unordered_set_create(size_t element_size,
                                        int (*compare_fn)(void const *,
                                                          void const *));
 
+/// @brief Creates a new unordered set that allocates through an allocator
+///
+/// Like unordered_set_create(), but the set structure and its table are
+/// obtained from allocator instead of malloc().
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param hash_fn As for unordered_set_create()
+/// @param compare_fn As for unordered_set_create()
+/// @param allocator Allocator to use, or NULL for the default allocator
+/// @return Pointer to the newly created set, or NULL on failure
+DSCUnorderedSet *unordered_set_create_with_allocator(
+    size_t element_size, size_t (*hash_fn)(void const *),
+    int (*compare_fn)(void const *, void const *),
+    DSCAllocator const *allocator);
+
 /// @brief Destroys the unordered set and frees its memory
 ///
 /// Deallocates all memory associated with the set, including the data
@@ -94,6 +125,21 @@ DSCError unordered_set_insert(DSCUnorderedSet *set, void const *element);
 ///       modify the set's capacity (insert, reserve, etc.)
 void *unordered_set_find(DSCUnorderedSet *set, void const *element);
 
+/// @brief Tests many elements for membership at once
+///
+/// Hashes a batch of elements and prefetches their home slots before
+/// probing any of them, so the cache misses of a batch overlap. See
+/// unordered_map_find_batch().
+///
+/// @param set Pointer to the set (must not be NULL)
+/// @param elements Array of n elements, each element_size bytes
+/// @param n Number of elements to test
+/// @param results Receives n flags, true for each element in the set
+/// @return Number of elements found, or 0 if parameters are invalid
+size_t unordered_set_contains_batch(DSCUnorderedSet const *set,
+                                    void const *elements, size_t n,
+                                    bool *results);
+
 /// @brief Removes an element from the set
 ///
 /// Removes the specified element from the set.
@@ -120,8 +166,10 @@ void unordered_set_clear(DSCUnorderedSet *set);
 /// @brief Reserves space for at least n elements
 ///
 /// Ensures that the set can hold at least n elements without
-/// requiring reallocation. If n is less than or equal to the current
-/// capacity, this function has no effect.
+/// requiring reallocation. The capacity is rounded up to a power of two
+/// large enough to keep the load factor below the maximum of the set's
+/// probe mode (0.75, or 0.9 with Robin Hood probing). If the set can
+/// already hold n elements, this function has no effect.
 ///
 /// @param set Pointer to the set (must not be NULL)
 /// @param n Minimum capacity to reserve
@@ -132,6 +180,81 @@ void unordered_set_clear(DSCUnorderedSet *set);
 /// @note This function never reduces the capacity
 DSCError unordered_set_reserve(DSCUnorderedSet *set, size_t n);
 
+/// @brief Selects the collision resolution strategy of the set
+///
+/// See unordered_map_set_probe_mode(). The set is rebuilt in the new mode.
+///
+/// @param set Pointer to the set (must not be NULL)
+/// @param mode DSC_PROBE_GROUP (the default) or DSC_PROBE_ROBIN_HOOD
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_OK Successfully switched (or already in that mode)
+/// @retval DSC_ERROR_INVALID_ARGUMENT set is NULL or mode is unknown
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @note Invalidates pointers into the set and iteration cursors
+DSCError unordered_set_set_probe_mode(DSCUnorderedSet *set,
+                                      DSCProbeMode mode);
+
+/// @brief Returns the collision resolution strategy of the set
+///
+/// @param set Pointer to the set (can be NULL)
+/// @return The current probe mode, or DSC_PROBE_GROUP if set is NULL
+DSCProbeMode unordered_set_probe_mode(DSCUnorderedSet const *set);
+
+/// @brief Advances an iteration over the elements of the set
+///
+/// Finds the first element stored at or after the position held in
+/// cursor, reports it through element, and moves cursor past it. Start
+/// with a cursor of 0 and call repeatedly until it returns false.
+///
+/// @param set Pointer to the set (can be NULL)
+/// @param cursor Iteration position, 0 to start (must not be NULL)
+/// @param element Receives a pointer to the element (can be NULL)
+/// @return true if an element was found, false at the end of the set
+/// @note Elements are visited in unspecified order. Inserting into the set
+///       invalidates the cursor; erasing the element just visited does
+///       not, except with Robin Hood probing.
+/// @note Empty regions are skipped 64 slots at a time, so a full pass is
+///       O(capacity / 64 + size)
+bool unordered_set_next(DSCUnorderedSet const *set, size_t *cursor,
+                        void **element);
+
+/// @brief Writes the set to a file that can be memory-mapped
+///
+/// Uses the same versioned, relocatable layout as unordered_map_save().
+///
+/// @param set Pointer to the set to save (must not be NULL)
+/// @param path Destination path (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT set or path is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @retval DSC_ERROR_IO The file could not be written, or the platform
+///         does not support table files (only POSIX systems do)
+/// @note Elements are written as raw bytes, so they must not contain
+///       pointers
+DSCError unordered_set_save(DSCUnorderedSet const *set, char const *path);
+
+/// @brief Opens a saved set by memory-mapping its file
+///
+/// Opening takes O(1) time and shares pages with other processes mapping
+/// the same file. The returned set supports lookups and iteration;
+/// insert, erase, reserve and probe mode changes fail with
+/// DSC_ERROR_READ_ONLY, and clear does nothing.
+///
+/// @param path Path of a file written by unordered_set_save()
+/// @param element_size Size of each element in bytes (must match the file)
+/// @param hash_fn Hash function the set was built with, or NULL if it
+///                hashed raw element bytes
+/// @param compare_fn Comparison function for elements, or NULL to compare
+///                   the raw bytes (must be NULL exactly when hash_fn is)
+/// @return Pointer to the mapped set, or NULL if the file cannot be
+///         mapped (always the case on non-POSIX platforms), was written by
+///         an incompatible build, or does not match the given size
+/// @note The caller is responsible for calling unordered_set_destroy(),
+///       which unmaps the file
+DSCUnorderedSet *unordered_set_open_mapped(
+    char const *path, size_t element_size, size_t (*hash_fn)(void const *),
+    int (*compare_fn)(void const *, void const *));
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,264 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DSC_UNROLLED_LIST_H_
+#define DSC_UNROLLED_LIST_H_
+
+#include "libdsc/common.h"
+#include "libdsc/pool.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Target size of an unrolled list node in bytes, four cache lines
+#define DSC_UNROLLED_LIST_NODE_BYTES 256
+
+/// Minimum number of elements per node, for elements too large to fit
+/// several in DSC_UNROLLED_LIST_NODE_BYTES
+#define DSC_UNROLLED_LIST_MIN_NODE_ELEMENTS 4
+
+/// @brief Node of an unrolled list
+///
+/// Holds up to the list's node_capacity elements in a contiguous array.
+/// The used slots are [begin, begin + count), so a node can grow at
+/// either end. This structure should be treated as opaque.
+typedef struct unrolled_list_node {
+    struct unrolled_list_node *prev; ///< Pointer to the previous node
+    struct unrolled_list_node *next; ///< Pointer to the next node
+    size_t begin;                    ///< Slot of the first element
+    size_t count;                    ///< Number of elements in the node
+    max_align_t data[];              ///< Element slots
+} DSCUnrolledListNode;
+
+/// @brief Position of an element in an unrolled list
+///
+/// The end position, one past the last element, has a NULL node.
+/// Iterators are invalidated by any insertion or removal except through
+/// the iterator itself.
+typedef struct {
+    DSCUnrolledListNode *node; ///< Node holding the element
+    size_t index;              ///< Index of the element within the node
+} DSCUnrolledListIterator;
+
+/// @brief Unrolled doubly-linked list
+///
+/// A doubly-linked list of nodes that each hold many elements in a
+/// contiguous array sized to a few cache lines. Scans touch one node
+/// header per node_capacity elements instead of one per element, so
+/// iteration runs close to vector speed, while insertion and removal in
+/// the middle only move elements within one node.
+///
+/// Nodes come from a DSCPool owned by the list. A full node is split in
+/// half on insertion, and a node left less than a quarter full by an
+/// erase is merged with a neighbour when the two fit in one node.
+///
+/// @note This structure should be treated as opaque.
+typedef struct {
+    DSCUnrolledListNode *head; ///< Pointer to the first node
+    DSCUnrolledListNode *tail; ///< Pointer to the last node
+    size_t size;               ///< Number of elements in the list
+    size_t element_size;       ///< Size of each element in bytes
+    size_t node_capacity;      ///< Number of element slots per node
+    DSCPool *pool;             ///< Source of the nodes
+    DSCAllocator allocator;    ///< Source of the structure and node slabs
+} DSCUnrolledList;
+
+/// @brief Creates a new unrolled list
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @return Pointer to the newly created list, or NULL on failure
+/// @note The caller is responsible for calling unrolled_list_destroy()
+DSCUnrolledList *unrolled_list_create(size_t element_size);
+
+/// @brief Creates a new unrolled list that allocates through an allocator
+///
+/// Like unrolled_list_create(), but the list structure and the slabs of
+/// its node pool are obtained from allocator instead of malloc().
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param allocator Allocator to use, or NULL for the default allocator
+/// @return Pointer to the newly created list, or NULL on failure
+DSCUnrolledList *unrolled_list_create_with_allocator(
+    size_t element_size, DSCAllocator const *allocator);
+
+/// @brief Destroys the list and frees its memory
+///
+/// @param list Pointer to the list to destroy (can be NULL)
+void unrolled_list_destroy(DSCUnrolledList *list);
+
+/// @brief Returns the number of elements in the list
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return Number of elements, or 0 if list is NULL
+/// @note This operation is O(1)
+size_t unrolled_list_size(DSCUnrolledList const *list);
+
+/// @brief Checks if the list is empty
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return true if the list is empty or NULL, false otherwise
+bool unrolled_list_empty(DSCUnrolledList const *list);
+
+/// @brief Inserts an element at the front of the list
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param element Pointer to the element to add (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list or element is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @note This operation is O(1)
+DSCError unrolled_list_push_front(DSCUnrolledList *list, void const *element);
+
+/// @brief Inserts an element at the back of the list
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param element Pointer to the element to add (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list or element is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+/// @note This operation is O(1)
+DSCError unrolled_list_push_back(DSCUnrolledList *list, void const *element);
+
+/// @brief Removes the first element from the list
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list is NULL
+/// @retval DSC_ERROR_EMPTY List is empty
+/// @note This operation is O(1)
+DSCError unrolled_list_pop_front(DSCUnrolledList *list);
+
+/// @brief Removes the last element from the list
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list is NULL
+/// @retval DSC_ERROR_EMPTY List is empty
+/// @note This operation is O(1)
+DSCError unrolled_list_pop_back(DSCUnrolledList *list);
+
+/// @brief Returns a pointer to the first element
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return Pointer to the first element, or NULL if list is empty or NULL
+void *unrolled_list_front(DSCUnrolledList const *list);
+
+/// @brief Returns a pointer to the last element
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return Pointer to the last element, or NULL if list is empty or NULL
+void *unrolled_list_back(DSCUnrolledList const *list);
+
+/// @brief Returns a pointer to the element at the given index
+///
+/// @param list Pointer to the list (can be NULL)
+/// @param index Index of the element
+/// @return Pointer to the element, or NULL if index is out of range
+/// @note This operation is O(n / node_capacity)
+void *unrolled_list_at(DSCUnrolledList const *list, size_t index);
+
+/// @brief Returns an iterator to the first element
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return Iterator to the first element, or the end iterator if the list
+///         is empty or NULL
+DSCUnrolledListIterator unrolled_list_begin(DSCUnrolledList const *list);
+
+/// @brief Returns the end iterator, one past the last element
+///
+/// @param list Pointer to the list (can be NULL)
+/// @return Iterator with a NULL node
+DSCUnrolledListIterator unrolled_list_end(DSCUnrolledList const *list);
+
+/// @brief Returns an iterator to the element at the given index
+///
+/// @param list Pointer to the list (can be NULL)
+/// @param index Index of the element
+/// @return Iterator to the element, or the end iterator if index is out
+///         of range
+/// @note This operation is O(n / node_capacity)
+DSCUnrolledListIterator unrolled_list_iterator_at(DSCUnrolledList const *list,
+                                                  size_t index);
+
+/// @brief Returns the element an iterator refers to
+///
+/// @param list Pointer to the list (can be NULL)
+/// @param it Iterator into list
+/// @return Pointer to the element, or NULL for the end iterator
+void *unrolled_list_get(DSCUnrolledList const *list,
+                        DSCUnrolledListIterator it);
+
+/// @brief Moves an iterator to the next element
+///
+/// @param it Iterator to advance (must not be NULL or the end iterator)
+void unrolled_list_advance(DSCUnrolledListIterator *it);
+
+/// @brief Inserts an element before the given position
+///
+/// Moves at most half a node of elements. A full node is first split in
+/// two, so the operation is amortised O(node_capacity).
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param pos Position to insert before, possibly the end iterator (must
+///            not be NULL). On success it refers to the new element.
+/// @param element Pointer to the element to insert (must not be NULL)
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list, pos or element is NULL
+/// @retval DSC_ERROR_MEMORY Memory allocation failed
+DSCError unrolled_list_insert(DSCUnrolledList *list,
+                              DSCUnrolledListIterator *pos,
+                              void const *element);
+
+/// @brief Removes the element at the given position
+///
+/// Moves at most half a node of elements, plus a merge with a neighbouring
+/// node when this one becomes sparse.
+///
+/// @param list Pointer to the list (must not be NULL)
+/// @param pos Position of the element to remove (must not be NULL or the
+///            end iterator). On success it refers to the element that
+///            followed the removed one.
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_INVALID_ARGUMENT list or pos is NULL, or pos is the
+///         end iterator
+DSCError unrolled_list_erase(DSCUnrolledList *list,
+                             DSCUnrolledListIterator *pos);
+
+/// @brief Removes all elements from the list
+///
+/// @param list Pointer to the list (can be NULL)
+/// @note This operation is O(1); the nodes are kept for reuse
+void unrolled_list_clear(DSCUnrolledList *list);
+
+/// @brief Advances a node-wise iteration over the list
+///
+/// Yields the elements of one node at a time as a contiguous array, for
+/// loops that the compiler can vectorise. Start with *node set to NULL
+/// and call repeatedly until it returns false:
+///
+/// ```c
+/// DSCUnrolledListNode *node = NULL;
+/// void *elements;
+/// size_t count;
+/// while (unrolled_list_next_block(list, &node, &elements, &count)) {
+///     int *values = elements;
+///     for (size_t i = 0; i < count; ++i) sum += values[i];
+/// }
+/// ```
+///
+/// @param list Pointer to the list (can be NULL)
+/// @param node Iteration position, NULL to start (must not be NULL)
+/// @param elements Receives a pointer to the node's first element
+///                 (must not be NULL)
+/// @param count Receives the number of elements in the node (must not be
+///              NULL)
+/// @return true if a node was found, false at the end of the list
+bool unrolled_list_next_block(DSCUnrolledList const *list,
+                              DSCUnrolledListNode **node, void **elements,
+                              size_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // DSC_UNROLLED_LIST_H_
@@ -38,6 +38,12 @@
 extern "C" {
 #endif
 
+/// @brief Capacity of a newly created vector
+///
+/// Shared with the typed vectors of typed_vector.h. Full vectors double
+/// their capacity.
+#define DSC_VECTOR_INITIAL_CAPACITY 16
+
 /// @brief Dynamic array structure
 ///
 /// A generic dynamic array that can store elements of any type.
@@ -51,6 +57,7 @@ typedef struct dsc_vector {
     size_t size;         ///< Number of elements currently stored
     size_t capacity;     ///< Total capacity of the data buffer
     size_t element_size; ///< Size of each element in bytes
+    DSCAllocator allocator; ///< Source of the structure and data buffer
 } DSCVector;
 
 /// @brief Creates a new vector with the specified element size
@@ -78,6 +85,17 @@ typedef struct dsc_vector {
 /// @see vector_destroy()
 DSCVector *vector_create(size_t element_size);
 
+/// @brief Creates a new vector that allocates through the given allocator
+///
+/// Like vector_create(), but the vector structure and its data buffer are
+/// obtained from allocator instead of malloc().
+///
+/// @param element_size Size of each element in bytes (must be > 0)
+/// @param allocator Allocator to use, or NULL for the default allocator
+/// @return Pointer to the newly created vector, or NULL on failure
+DSCVector *vector_create_with_allocator(size_t element_size,
+                                        DSCAllocator const *allocator);
+
 /// @brief Destroys the vector and frees its memory
 ///
 /// Deallocates all memory associated with the vector, including the data
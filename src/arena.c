@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "libdsc/arena.h"
+
+#include <stdint.h>
+#include <string.h>
+
+// Every block is aligned like malloc(), and every block size is rounded up
+// to a multiple of this, so the bump pointer stays aligned.
+#define DSC_ARENA_ALIGNMENT _Alignof(max_align_t)
+
+struct DSCArenaChunk {
+    DSCArenaChunk *next;  // Next chunk, in use or kept for reuse
+    size_t capacity;      // Bytes in data
+    max_align_t data[];
+};
+
+// Rounds size up to the alignment. Zero-byte blocks still get a distinct
+// address, like most malloc() implementations give them.
+static bool align_size(size_t size, size_t *result) {
+    if (size == 0) size = 1;
+    if (size > SIZE_MAX - (DSC_ARENA_ALIGNMENT - 1)) return false;
+
+    *result = (size + DSC_ARENA_ALIGNMENT - 1) & ~(DSC_ARENA_ALIGNMENT - 1);
+    return true;
+}
+
+static char *chunk_begin(DSCArenaChunk *chunk) { return (char *)chunk->data; }
+
+static char *chunk_end(DSCArenaChunk *chunk) {
+    return (char *)chunk->data + chunk->capacity;
+}
+
+static void use_chunk(DSCArena *arena, DSCArenaChunk *chunk, char *ptr) {
+    arena->current = chunk;
+    arena->ptr = ptr;
+    arena->end = chunk_end(chunk);
+}
+
+static size_t remaining(DSCArena const *arena) {
+    return (size_t)((uintptr_t)arena->end - (uintptr_t)arena->ptr);
+}
+
+// Moves to the chunk after the current one, reusing a kept chunk if it is
+// large enough and inserting a new one in front of it otherwise.
+static bool next_chunk(DSCArena *arena, size_t size) {
+    DSCArenaChunk *next =
+        arena->current ? arena->current->next : arena->first;
+    if (next && next->capacity >= size) {
+        use_chunk(arena, next, chunk_begin(next));
+        return true;
+    }
+
+    size_t capacity = size > arena->chunk_size ? size : arena->chunk_size;
+    size_t bytes;
+    if (!dsc_safe_add(sizeof(DSCArenaChunk), capacity, &bytes)) {
+        return false;
+    }
+    DSCArenaChunk *chunk = dsc_malloc(bytes);
+    if (!chunk) return false;
+
+    chunk->capacity = capacity;
+    chunk->next = next;
+    if (arena->current) {
+        arena->current->next = chunk;
+    } else {
+        arena->first = chunk;
+    }
+    arena->reserved += capacity;
+    use_chunk(arena, chunk, chunk_begin(chunk));
+    return true;
+}
+
+DSCArena *arena_create(size_t chunk_size) {
+    DSCArena *arena = dsc_malloc(sizeof(DSCArena));
+    if (!arena) return NULL;
+
+    if (chunk_size == 0) chunk_size = DSC_ARENA_DEFAULT_CHUNK_SIZE;
+    if (!align_size(chunk_size, &arena->chunk_size)) {
+        dsc_free(arena);
+        return NULL;
+    }
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->ptr = NULL;
+    arena->end = NULL;
+    arena->reserved = 0;
+    return arena;
+}
+
+void arena_destroy(DSCArena *arena) {
+    if (!arena) return;
+
+    DSCArenaChunk *chunk = arena->first;
+    while (chunk) {
+        DSCArenaChunk *next = chunk->next;
+        dsc_free(chunk);
+        chunk = next;
+    }
+    dsc_free(arena);
+}
+
+void *arena_allocate(DSCArena *arena, size_t size) {
+    if (!arena || !align_size(size, &size)) return NULL;
+
+    if (size > remaining(arena) && !next_chunk(arena, size)) {
+        return NULL;
+    }
+    void *block = arena->ptr;
+    arena->ptr += size;
+    return block;
+}
+
+void arena_reset(DSCArena *arena) {
+    if (!arena || !arena->first) return;
+    use_chunk(arena, arena->first, chunk_begin(arena->first));
+}
+
+DSCArenaCheckpoint arena_checkpoint(DSCArena const *arena) {
+    DSCArenaCheckpoint checkpoint = {NULL, NULL};
+    if (!arena) return checkpoint;
+
+    checkpoint.chunk = arena->current;
+    checkpoint.ptr = arena->ptr;
+    return checkpoint;
+}
+
+void arena_rollback(DSCArena *arena, DSCArenaCheckpoint checkpoint) {
+    if (!arena) return;
+
+    // A checkpoint taken before the first allocation has no chunk.
+    if (!checkpoint.chunk) {
+        arena_reset(arena);
+        return;
+    }
+    use_chunk(arena, checkpoint.chunk, checkpoint.ptr);
+}
+
+void arena_trim(DSCArena *arena) {
+    if (!arena || !arena->current) return;
+
+    DSCArenaChunk *chunk = arena->current->next;
+    while (chunk) {
+        DSCArenaChunk *next = chunk->next;
+        arena->reserved -= chunk->capacity;
+        dsc_free(chunk);
+        chunk = next;
+    }
+    arena->current->next = NULL;
+}
+
+size_t arena_reserved(DSCArena const *arena) {
+    return arena ? arena->reserved : 0;
+}
+
+static void *arena_allocator_allocate(void *context, size_t size) {
+    return arena_allocate(context, size);
+}
+
+// True if block is the most recent allocation, which ends at the bump
+// pointer. Blocks never span chunks, so such a block lies in the current
+// chunk.
+static bool is_last_block(DSCArena const *arena, char const *block,
+                          size_t size) {
+    return block && block + size == arena->ptr;
+}
+
+static void *arena_allocator_reallocate(void *context, void *ptr,
+                                        size_t old_size, size_t new_size) {
+    DSCArena *arena = context;
+    size_t old_aligned, new_aligned;
+    if (!align_size(old_size, &old_aligned) ||
+        !align_size(new_size, &new_aligned)) {
+        return NULL;
+    }
+
+    if (is_last_block(arena, ptr, old_aligned) &&
+        new_aligned <= (size_t)(arena->end - (char *)ptr)) {
+        arena->ptr = (char *)ptr + new_aligned;
+        return ptr;
+    }
+
+    void *block = arena_allocate(arena, new_size);
+    if (block && ptr) {
+        memcpy(block, ptr, old_size < new_size ? old_size : new_size);
+    }
+    return block;
+}
+
+static void arena_allocator_deallocate(void *context, void *ptr,
+                                       size_t size) {
+    DSCArena *arena = context;
+    size_t aligned;
+    if (align_size(size, &aligned) && is_last_block(arena, ptr, aligned)) {
+        arena->ptr = ptr;
+    }
+}
+
+DSCAllocator arena_allocator(DSCArena *arena) {
+    DSCAllocator allocator = {arena_allocator_allocate,
+                              arena_allocator_reallocate,
+                              arena_allocator_deallocate, arena};
+    return allocator;
+}
@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "libdsc/concurrent_map.h"
+
+#include <limits.h>
+#include <pthread.h>
+#include <stdalign.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libdsc/hash_table.h"
+#include "libdsc/unordered_map.h"
+
+#define DSC_CONCURRENT_MAP_DEFAULT_SHARDS 64
+#define DSC_CONCURRENT_MAP_MAX_SHARDS 4096
+
+// Each shard starts on its own cache line and is padded to a whole number
+// of lines, so locking one shard never invalidates a neighbour's line.
+typedef struct {
+    alignas(DSC_CACHE_LINE) pthread_rwlock_t lock;
+    DSCUnorderedMap *table;
+} DSCConcurrentShard;
+
+struct DSCConcurrentMap {
+    DSCConcurrentShard *shards;
+    size_t shard_count;
+    unsigned shard_bits;
+};
+
+// Every block of a shard's table, including the small DSCUnorderedMap
+// header whose size and growth_left change on each insert, starts on its
+// own cache line and is padded to whole lines. Otherwise malloc() packs
+// the headers of different shards next to each other, and writers to
+// different shards contend for the same line.
+static void *line_allocate(void *context, size_t size) {
+    (void)context;
+    size_t padded;
+    if (!dsc_safe_add(size, DSC_CACHE_LINE - 1, &padded)) {
+        return NULL;
+    }
+    return aligned_alloc(DSC_CACHE_LINE,
+                         padded & ~(size_t)(DSC_CACHE_LINE - 1));
+}
+
+static void line_deallocate(void *context, void *ptr, size_t size) {
+    (void)context;
+    (void)size;
+    free(ptr);
+}
+
+// realloc() would not keep the alignment, so resizing copies instead.
+static DSCAllocator const line_allocator = {line_allocate, NULL,
+                                            line_deallocate, NULL};
+
+// Shards are picked by the top bits of the hash; the tables index their
+// slots by the low bits, so the two choices stay independent.
+static DSCConcurrentShard *shard_for(DSCConcurrentMap *map, size_t hash) {
+    if (map->shard_bits == 0) {
+        return &map->shards[0];
+    }
+    return &map->shards[hash >> (sizeof(size_t) * CHAR_BIT - map->shard_bits)];
+}
+
+static size_t hash_key(DSCConcurrentMap *map, void const *key) {
+    // Every shard hashes the same way, so any of them can compute it.
+    return unordered_map_hash(map->shards[0].table, key);
+}
+
+static void destroy_shards(DSCConcurrentShard *shards, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        pthread_rwlock_destroy(&shards[i].lock);
+        unordered_map_destroy(shards[i].table);
+    }
+    free(shards);
+}
+
+DSCConcurrentMap *concurrent_map_create(size_t key_size, size_t value_size,
+                                        size_t (*hash_fn)(void const *),
+                                        int (*compare_fn)(void const *,
+                                                          void const *),
+                                        size_t shard_count) {
+    if (shard_count == 0) {
+        shard_count = DSC_CONCURRENT_MAP_DEFAULT_SHARDS;
+    }
+    if (shard_count > DSC_CONCURRENT_MAP_MAX_SHARDS) {
+        return NULL;
+    }
+
+    unsigned shard_bits = 0;
+    while (((size_t)1 << shard_bits) < shard_count) {
+        ++shard_bits;
+    }
+    shard_count = (size_t)1 << shard_bits;
+
+    DSCConcurrentMap *map = malloc(sizeof(DSCConcurrentMap));
+    if (!map) {
+        return NULL;
+    }
+
+    // sizeof(DSCConcurrentShard) is a multiple of its alignment, as
+    // aligned_alloc requires.
+    DSCConcurrentShard *shards =
+        aligned_alloc(alignof(DSCConcurrentShard),
+                      shard_count * sizeof(DSCConcurrentShard));
+    if (!shards) {
+        free(map);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < shard_count; ++i) {
+        shards[i].table = unordered_map_create_with_allocator(
+            key_size, value_size, hash_fn, compare_fn, &line_allocator);
+        if (!shards[i].table) {
+            destroy_shards(shards, i);
+            free(map);
+            return NULL;
+        }
+        if (pthread_rwlock_init(&shards[i].lock, NULL) != 0) {
+            unordered_map_destroy(shards[i].table);
+            destroy_shards(shards, i);
+            free(map);
+            return NULL;
+        }
+    }
+
+    map->shards = shards;
+    map->shard_count = shard_count;
+    map->shard_bits = shard_bits;
+    return map;
+}
+
+void concurrent_map_destroy(DSCConcurrentMap *map) {
+    if (!map) {
+        return;
+    }
+
+    destroy_shards(map->shards, map->shard_count);
+    free(map);
+}
+
+size_t concurrent_map_size(DSCConcurrentMap *map) {
+    if (!map) {
+        return 0;
+    }
+
+    size_t size = 0;
+    for (size_t i = 0; i < map->shard_count; ++i) {
+        DSCConcurrentShard *shard = &map->shards[i];
+        pthread_rwlock_rdlock(&shard->lock);
+        size += unordered_map_size(shard->table);
+        pthread_rwlock_unlock(&shard->lock);
+    }
+    return size;
+}
+
+DSCError concurrent_map_insert(DSCConcurrentMap *map, void const *key,
+                               void const *value) {
+    if (!map || !key || !value) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t hash = hash_key(map, key);
+    DSCConcurrentShard *shard = shard_for(map, hash);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    bool inserted;
+    void *slot =
+        unordered_map_try_emplace_hashed(shard->table, key, hash, &inserted);
+    if (slot) {
+        memcpy(slot, value, shard->table->value_size);
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    return slot ? DSC_ERROR_OK : DSC_ERROR_MEMORY;
+}
+
+DSCError concurrent_map_find(DSCConcurrentMap *map, void const *key,
+                             void *value) {
+    if (!map || !key) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t hash = hash_key(map, key);
+    DSCConcurrentShard *shard = shard_for(map, hash);
+
+    // Shard tables never rehash incrementally, so lookups do not modify
+    // them and a shared lock suffices.
+    pthread_rwlock_rdlock(&shard->lock);
+    void *found = unordered_map_find_hashed(shard->table, key, hash);
+    if (found && value) {
+        memcpy(value, found, shard->table->value_size);
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    return found ? DSC_ERROR_OK : DSC_ERROR_NOT_FOUND;
+}
+
+DSCError concurrent_map_erase(DSCConcurrentMap *map, void const *key) {
+    if (!map || !key) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t hash = hash_key(map, key);
+    DSCConcurrentShard *shard = shard_for(map, hash);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    DSCError err = unordered_map_erase_hashed(shard->table, key, hash);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return err;
+}
+
+DSCError concurrent_map_try_emplace(DSCConcurrentMap *map, void const *key,
+                                    DSCConcurrentUpdateFn update,
+                                    void *context, bool *inserted) {
+    if (!map || !key) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t hash = hash_key(map, key);
+    DSCConcurrentShard *shard = shard_for(map, hash);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    bool was_inserted;
+    void *slot = unordered_map_try_emplace_hashed(shard->table, key, hash,
+                                                  &was_inserted);
+    if (slot && update) {
+        update(slot, context);
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    if (!slot) {
+        return DSC_ERROR_MEMORY;
+    }
+    if (inserted) {
+        *inserted = was_inserted;
+    }
+    return DSC_ERROR_OK;
+}
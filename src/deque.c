@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "libdsc/deque.h"
+
+#include <string.h>
+
+#define DSC_DEQUE_MIN_MAP_CAPACITY 8
+
+// Invariant: the deque holds blocks only while it holds elements, and the
+// first and last mapped blocks each hold at least one element. Position p,
+// counted from the start of the first block, lives in block p >> shift at
+// offset p & (block_elements - 1). block_elements * element_size was
+// checked at creation, so offsets within a block cannot overflow.
+
+static inline size_t block_bytes(DSCDeque const *deque) {
+    return deque->block_elements * deque->element_size;
+}
+
+static inline char *position(DSCDeque const *deque, size_t pos) {
+    char *block = deque->map[deque->map_begin + (pos >> deque->block_shift)];
+    return block + (pos & (deque->block_elements - 1)) * deque->element_size;
+}
+
+// Takes a block from the spare list, or allocates one.
+static void *get_block(DSCDeque *deque) {
+    void *block = deque->spare;
+    if (block) {
+        // The link to the next spare block is kept in its first bytes.
+        memcpy(&deque->spare, block, sizeof(void *));
+        deque->spare_count--;
+        return block;
+    }
+    return dsc_allocate(&deque->allocator, block_bytes(deque));
+}
+
+// Keeps an emptied block for reuse while the spare list has room.
+static void release_block(DSCDeque *deque, void *block) {
+    if (deque->spare_count < DSC_DEQUE_MAX_SPARE_BLOCKS) {
+        memcpy(block, &deque->spare, sizeof(void *));
+        deque->spare = block;
+        deque->spare_count++;
+        return;
+    }
+    dsc_deallocate(&deque->allocator, block, block_bytes(deque));
+}
+
+// Releases every block and recentres the map for pushes at either end.
+static void release_all(DSCDeque *deque) {
+    for (size_t i = 0; i < deque->block_count; ++i) {
+        release_block(deque, deque->map[deque->map_begin + i]);
+    }
+    deque->block_count = 0;
+    deque->map_begin = deque->map_capacity / 2;
+    deque->start = 0;
+    deque->size = 0;
+}
+
+// Makes room in the map for one more block at the front or the back.
+// Only block pointers move; the blocks themselves stay where they are.
+static DSCError reserve_map(DSCDeque *deque, bool front) {
+    if (front ? deque->map_begin > 0
+              : deque->map_begin + deque->block_count < deque->map_capacity) {
+        return DSC_ERROR_OK;
+    }
+
+    size_t needed;
+    if (!dsc_safe_multiply(deque->block_count + 1, 2, &needed)) {
+        return DSC_ERROR_OVERFLOW;
+    }
+
+    // With at least half the map free, recentring leaves room at both ends.
+    size_t new_capacity = deque->map_capacity;
+    void **new_map = deque->map;
+    if (new_capacity < needed) {
+        new_capacity = needed < DSC_DEQUE_MIN_MAP_CAPACITY
+                           ? DSC_DEQUE_MIN_MAP_CAPACITY
+                           : needed;
+        size_t map_size;
+        if (!dsc_safe_multiply(new_capacity, sizeof(void *), &map_size)) {
+            return DSC_ERROR_OVERFLOW;
+        }
+        new_map = dsc_allocate(&deque->allocator, map_size);
+        if (!new_map) return DSC_ERROR_MEMORY;
+    }
+
+    size_t new_begin = (new_capacity - deque->block_count) / 2;
+    if (deque->block_count > 0) {
+        memmove(new_map + new_begin, deque->map + deque->map_begin,
+                deque->block_count * sizeof(void *));
+    }
+
+    if (new_map != deque->map) {
+        dsc_deallocate(&deque->allocator, deque->map,
+                       deque->map_capacity * sizeof(void *));
+        deque->map = new_map;
+        deque->map_capacity = new_capacity;
+    }
+    deque->map_begin = new_begin;
+
+    return DSC_ERROR_OK;
+}
+
+DSCDeque *deque_create(size_t element_size) {
+    return deque_create_with_allocator(element_size, NULL);
+}
+
+DSCDeque *deque_create_with_allocator(size_t element_size,
+                                      DSCAllocator const *allocator) {
+    if (element_size == 0 || !dsc_allocator_valid(allocator)) {
+        return NULL;
+    }
+
+    // Round the number of elements that fit in a block down to a power of
+    // two, so positions split into a block and an offset with a shift.
+    size_t per_block = DSC_DEQUE_BLOCK_BYTES / element_size;
+    if (per_block < DSC_DEQUE_MIN_BLOCK_ELEMENTS) {
+        per_block = DSC_DEQUE_MIN_BLOCK_ELEMENTS;
+    }
+    unsigned shift = 0;
+    while (((size_t)2 << shift) <= per_block) {
+        ++shift;
+    }
+
+    size_t bytes;
+    if (!dsc_safe_multiply((size_t)1 << shift, element_size, &bytes)) {
+        return NULL;
+    }
+
+    DSCAllocator alloc = dsc_allocator_or_default(allocator);
+    DSCDeque *deque = dsc_allocate(&alloc, sizeof(DSCDeque));
+    if (!deque) return NULL;
+
+    deque->map = NULL;
+    deque->map_capacity = 0;
+    deque->map_begin = 0;
+    deque->block_count = 0;
+    deque->start = 0;
+    deque->size = 0;
+    deque->element_size = element_size;
+    deque->block_elements = (size_t)1 << shift;
+    deque->block_shift = shift;
+    deque->spare = NULL;
+    deque->spare_count = 0;
+    deque->allocator = alloc;
+
+    return deque;
+}
+
+void deque_destroy(DSCDeque *deque) {
+    if (!deque) return;
+
+    DSCAllocator alloc = deque->allocator;
+    for (size_t i = 0; i < deque->block_count; ++i) {
+        dsc_deallocate(&alloc, deque->map[deque->map_begin + i],
+                       block_bytes(deque));
+    }
+    deque_shrink_to_fit(deque);
+    dsc_deallocate(&alloc, deque->map, deque->map_capacity * sizeof(void *));
+    dsc_deallocate(&alloc, deque, sizeof(DSCDeque));
+}
+
+size_t deque_size(DSCDeque const *deque) { return deque ? deque->size : 0; }
+
+bool deque_empty(DSCDeque const *deque) { return !deque || deque->size == 0; }
+
+DSCError deque_push_back(DSCDeque *deque, void const *element) {
+    if (!deque || !element) return DSC_ERROR_INVALID_ARGUMENT;
+
+    size_t pos = deque->start + deque->size;
+    if (pos == deque->block_count << deque->block_shift) {
+        DSCError err = reserve_map(deque, false);
+        if (err != DSC_ERROR_OK) return err;
+
+        void *block = get_block(deque);
+        if (!block) return DSC_ERROR_MEMORY;
+        deque->map[deque->map_begin + deque->block_count] = block;
+        deque->block_count++;
+    }
+
+    memcpy(position(deque, pos), element, deque->element_size);
+    deque->size++;
+
+    return DSC_ERROR_OK;
+}
+
+DSCError deque_push_front(DSCDeque *deque, void const *element) {
+    if (!deque || !element) return DSC_ERROR_INVALID_ARGUMENT;
+
+    if (deque->start == 0) {
+        DSCError err = reserve_map(deque, true);
+        if (err != DSC_ERROR_OK) return err;
+
+        void *block = get_block(deque);
+        if (!block) return DSC_ERROR_MEMORY;
+        deque->map[--deque->map_begin] = block;
+        deque->block_count++;
+        deque->start = deque->block_elements;
+    }
+
+    deque->start--;
+    deque->size++;
+    memcpy(position(deque, deque->start), element, deque->element_size);
+
+    return DSC_ERROR_OK;
+}
+
+DSCError deque_pop_back(DSCDeque *deque) {
+    if (!deque) return DSC_ERROR_INVALID_ARGUMENT;
+    if (deque->size == 0) return DSC_ERROR_EMPTY;
+
+    deque->size--;
+    if (deque->size == 0) {
+        release_all(deque);
+    } else if (((deque->start + deque->size) &
+                (deque->block_elements - 1)) == 0) {
+        // The removed element was the only one in the last block.
+        deque->block_count--;
+        release_block(deque,
+                      deque->map[deque->map_begin + deque->block_count]);
+    }
+
+    return DSC_ERROR_OK;
+}
+
+DSCError deque_pop_front(DSCDeque *deque) {
+    if (!deque) return DSC_ERROR_INVALID_ARGUMENT;
+    if (deque->size == 0) return DSC_ERROR_EMPTY;
+
+    deque->start++;
+    deque->size--;
+    if (deque->size == 0) {
+        release_all(deque);
+    } else if (deque->start == deque->block_elements) {
+        release_block(deque, deque->map[deque->map_begin]);
+        deque->map_begin++;
+        deque->block_count--;
+        deque->start = 0;
+    }
+
+    return DSC_ERROR_OK;
+}
+
+void *deque_at(DSCDeque const *deque, size_t index) {
+    if (!deque || index >= deque->size) return NULL;
+    return position(deque, deque->start + index);
+}
+
+void *deque_front(DSCDeque const *deque) { return deque_at(deque, 0); }
+
+void *deque_back(DSCDeque const *deque) {
+    if (!deque || deque->size == 0) return NULL;
+    return position(deque, deque->start + deque->size - 1);
+}
+
+void deque_clear(DSCDeque *deque) {
+    if (!deque) return;
+    release_all(deque);
+}
+
+void deque_shrink_to_fit(DSCDeque *deque) {
+    if (!deque) return;
+
+    while (deque->spare) {
+        void *block = deque->spare;
+        memcpy(&deque->spare, block, sizeof(void *));
+        dsc_deallocate(&deque->allocator, block, block_bytes(deque));
+    }
+    deque->spare_count = 0;
+}
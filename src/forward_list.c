@@ -2,35 +2,34 @@
 
 #include "libdsc/forward_list.h"
 
-#include <stdlib.h>
 #include <string.h>
 
-static DSCForwardListNode *create_node(void const *element,
-                                        size_t element_size)
-{
-    DSCForwardListNode *node = malloc(sizeof(DSCForwardListNode));
+static DSCForwardListNode *create_node(DSCForwardList *list,
+                                       void const *element) {
+    DSCForwardListNode *node = pool_allocate(list->pool);
     if (node == NULL) {
         return NULL;
     }
 
-    node->data = malloc(element_size);
-    if (node->data == NULL) {
-        free(node);
-        return NULL;
-    }
-
-    memcpy(node->data, element, element_size);
+    memcpy(node->data, element, list->element_size);
     node->next = NULL;
 
     return node;
 }
 
+static void destroy_node(DSCForwardList *list, DSCForwardListNode *node) {
+    pool_deallocate(list->pool, node);
+}
+
 DSCForwardList *forward_list_create(size_t element_size) {
-    if (element_size == 0) {
-        return NULL;
-    }
+    return forward_list_create_with_allocator(element_size, NULL);
+}
 
-    DSCForwardList *list = malloc(sizeof(DSCForwardList));
+// Allocates and initializes the list structure around a node pool.
+static DSCForwardList *create_list(size_t element_size, DSCPool *pool,
+                                   bool owns_pool) {
+    DSCForwardList *list =
+        dsc_allocate(&pool->allocator, sizeof(DSCForwardList));
     if (list == NULL) {
         return NULL;
     }
@@ -38,18 +37,69 @@ DSCForwardList *forward_list_create(size_t element_size) {
     list->head = NULL;
     list->size = 0;
     list->element_size = element_size;
+    list->pool = pool;
+    list->owns_pool = owns_pool;
+    list->allocator = pool->allocator;
+
+    return list;
+}
+
+DSCForwardList *forward_list_create_with_allocator(
+    size_t element_size, DSCAllocator const *allocator) {
+    if (element_size == 0) {
+        return NULL;
+    }
+
+    size_t node_size = forward_list_node_size(element_size);
+    if (node_size == 0) {
+        return NULL;
+    }
+
+    DSCPool *pool = pool_create_with_allocator(node_size, allocator);
+    if (pool == NULL) {
+        return NULL;
+    }
 
+    DSCForwardList *list = create_list(element_size, pool, true);
+    if (list == NULL) {
+        pool_destroy(pool);
+    }
     return list;
 }
 
+DSCForwardList *forward_list_create_with_pool(size_t element_size,
+                                              DSCPool *pool) {
+    size_t node_size = forward_list_node_size(element_size);
+    if (element_size == 0 || node_size == 0 || !pool ||
+        pool_block_size(pool) < node_size) {
+        return NULL;
+    }
+
+    return create_list(element_size, pool, false);
+}
+
+size_t forward_list_node_size(size_t element_size) {
+    if (element_size > SIZE_MAX - sizeof(DSCForwardListNode)) {
+        return 0;
+    }
+    return sizeof(DSCForwardListNode) + element_size;
+}
+
 void forward_list_destroy(DSCForwardList *list)
 {
     if (list == NULL) {
         return;
     }
 
-    forward_list_clear(list);
-    free(list);
+    // An owned pool takes every node with it, one slab at a time.
+    if (list->owns_pool) {
+        pool_destroy(list->pool);
+    } else {
+        forward_list_clear(list);
+    }
+
+    DSCAllocator alloc = list->allocator;
+    dsc_deallocate(&alloc, list, sizeof(DSCForwardList));
 }
 
 size_t forward_list_size(DSCForwardList const *list) {
@@ -65,7 +115,7 @@ DSCError forward_list_push_front(DSCForwardList *list, void const *element) {
         return DSC_ERROR_INVALID_ARGUMENT;
     }
 
-    DSCForwardListNode *node = create_node(element, list->element_size);
+    DSCForwardListNode *node = create_node(list, element);
     if (!node) {
         return DSC_ERROR_MEMORY;
     }
@@ -88,8 +138,7 @@ DSCError forward_list_pop_front(DSCForwardList *list) {
 
     DSCForwardListNode *old_head = list->head;
     list->head = old_head->next;
-    free(old_head->data);
-    free(old_head);
+    destroy_node(list, old_head);
     list->size--;
 
     return DSC_ERROR_OK;
@@ -114,7 +163,7 @@ DSCError forward_list_insert_after(DSCForwardList *list,
         return DSC_ERROR_INVALID_ARGUMENT;
     }
 
-    DSCForwardListNode *node = create_node(element, list->element_size);
+    DSCForwardListNode *node = create_node(list, element);
     if (!node) {
         return DSC_ERROR_MEMORY;
     }
@@ -157,8 +206,7 @@ DSCError forward_list_erase_after(DSCForwardList *list,
         pos->next = to_delete->next;
     }
 
-    free(to_delete->data);
-    free(to_delete);
+    destroy_node(list, to_delete);
     list->size--;
 
     return DSC_ERROR_OK;
@@ -169,18 +217,199 @@ void forward_list_clear(DSCForwardList *list) {
         return;
     }
 
-    DSCForwardListNode *current = list->head;
-    while (current) {
-        DSCForwardListNode *next = current->next;
-        free(current->data);
-        free(current);
-        current = next;
+    if (list->owns_pool) {
+        pool_reset(list->pool);
+    } else {
+        DSCForwardListNode *current = list->head;
+        while (current) {
+            DSCForwardListNode *next = current->next;
+            destroy_node(list, current);
+            current = next;
+        }
     }
 
     list->head = NULL;
     list->size = 0;
 }
 
+// Moves the nodes of src into a NULL-terminated chain from first to last
+// that dst can own: src's own nodes if the lists share a pool, otherwise
+// copies from dst's pool. Leaves src empty on success and unchanged on
+// failure.
+static DSCError take_nodes(DSCForwardList *dst, DSCForwardList *src,
+                           DSCForwardListNode **first,
+                           DSCForwardListNode **last) {
+    if (src->pool == dst->pool) {
+        DSCForwardListNode *tail = src->head;
+        while (tail->next) {
+            tail = tail->next;
+        }
+        *first = src->head;
+        *last = tail;
+        src->head = NULL;
+        src->size = 0;
+        return DSC_ERROR_OK;
+    }
+
+    DSCForwardListNode *head = NULL;
+    DSCForwardListNode **link = &head;
+    DSCForwardListNode *tail = NULL;
+    for (DSCForwardListNode *node = src->head; node; node = node->next) {
+        DSCForwardListNode *copy = create_node(dst, node->data);
+        if (!copy) {
+            while (head) {
+                DSCForwardListNode *next = head->next;
+                destroy_node(dst, head);
+                head = next;
+            }
+            return DSC_ERROR_MEMORY;
+        }
+
+        *link = copy;
+        link = &copy->next;
+        tail = copy;
+    }
+
+    forward_list_clear(src);
+    *first = head;
+    *last = tail;
+    return DSC_ERROR_OK;
+}
+
+// Merges two sorted chains, taking from a on ties.
+static DSCForwardListNode *merge_runs(
+    DSCForwardListNode *a, DSCForwardListNode *b,
+    int (*compare)(void const *, void const *)) {
+    DSCForwardListNode *head = NULL;
+    DSCForwardListNode **link = &head;
+    while (a && b) {
+        if (compare(b->data, a->data) < 0) {
+            *link = b;
+            link = &b->next;
+            b = b->next;
+        } else {
+            *link = a;
+            link = &a->next;
+            a = a->next;
+        }
+    }
+    *link = a ? a : b;
+    return head;
+}
+
+static bool compatible(DSCForwardList const *dst, DSCForwardList const *src) {
+    return dst && src && dst != src &&
+           dst->element_size == src->element_size;
+}
+
+DSCError forward_list_splice_after(DSCForwardList *dst,
+                                   DSCForwardListNode *pos,
+                                   DSCForwardList *src) {
+    if (!compatible(dst, src)) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    if (src->size == 0) {
+        return DSC_ERROR_OK;
+    }
+
+    size_t count = src->size;
+    DSCForwardListNode *first;
+    DSCForwardListNode *last;
+    DSCError err = take_nodes(dst, src, &first, &last);
+    if (err != DSC_ERROR_OK) {
+        return err;
+    }
+
+    DSCForwardListNode **link = pos ? &pos->next : &dst->head;
+    last->next = *link;
+    *link = first;
+    dst->size += count;
+
+    return DSC_ERROR_OK;
+}
+
+DSCError forward_list_merge(DSCForwardList *dst, DSCForwardList *src,
+                            int (*compare)(void const *, void const *)) {
+    if (!compatible(dst, src) || !compare) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    if (src->size == 0) {
+        return DSC_ERROR_OK;
+    }
+
+    size_t count = src->size;
+    DSCForwardListNode *first;
+    DSCForwardListNode *last;
+    DSCError err = take_nodes(dst, src, &first, &last);
+    if (err != DSC_ERROR_OK) {
+        return err;
+    }
+
+    dst->head = merge_runs(dst->head, first, compare);
+    dst->size += count;
+
+    return DSC_ERROR_OK;
+}
+
+DSCError forward_list_sort(DSCForwardList *list,
+                           int (*compare)(void const *, void const *)) {
+    if (!list || !compare) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    if (list->size < 2) {
+        return DSC_ERROR_OK;
+    }
+
+    // runs[i] is empty or a sorted run of 2^i nodes, holding nodes that
+    // came before those of runs[i - 1]. Each node is merged up like a
+    // binary counter increment.
+    DSCForwardListNode *runs[sizeof(size_t) * 8] = {NULL};
+    size_t top = 0;
+
+    DSCForwardListNode *node = list->head;
+    while (node) {
+        DSCForwardListNode *run = node;
+        node = node->next;
+        run->next = NULL;
+
+        size_t i = 0;
+        for (; runs[i]; ++i) {
+            run = merge_runs(runs[i], run, compare);
+            runs[i] = NULL;
+        }
+        runs[i] = run;
+        if (i > top) {
+            top = i;
+        }
+    }
+
+    DSCForwardListNode *sorted = NULL;
+    for (size_t i = 0; i <= top; ++i) {
+        if (runs[i]) {
+            sorted = sorted ? merge_runs(runs[i], sorted, compare) : runs[i];
+        }
+    }
+    list->head = sorted;
+
+    return DSC_ERROR_OK;
+}
+
+void forward_list_reverse(DSCForwardList *list) {
+    if (!list) {
+        return;
+    }
+
+    DSCForwardListNode *reversed = NULL;
+    DSCForwardListNode *node = list->head;
+    while (node) {
+        DSCForwardListNode *next = node->next;
+        node->next = reversed;
+        reversed = node;
+        node = next;
+    }
+    list->head = reversed;
+}
+
 DSCForwardListNode *forward_list_begin(DSCForwardList const *list) {
     return list ? list->head : NULL;
 }
@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "libdsc/frozen_map.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libdsc/hash_table.h"
+
+// PTHash's c: the map uses c * n / log2(n) buckets. Larger values speed up
+// construction at the cost of a bigger pilot table.
+#define DSC_FROZEN_MAP_BUCKET_FACTOR 5
+
+// Keys whose top 32 hash bits fall below this threshold (60% of the range)
+// go to the first 30% of buckets. The skew makes a few large buckets that
+// are placed first, while the table is still empty, and many small ones
+// that fill the remaining gaps easily.
+#define DSC_FROZEN_MAP_DENSE_THRESHOLD 0x9999999Aull
+
+typedef struct {
+    uint64_t hash;
+    size_t bucket;
+    void const *key;
+    void const *value;
+} DSCFrozenEntry;
+
+typedef struct {
+    size_t bucket;
+    size_t begin;
+    size_t size;
+} DSCFrozenBucket;
+
+// Bucket and slot selection consume a full 64-bit hash on every target.
+// Maps without hash_fn hash the key bytes with the 64-bit byte hash; a
+// user hash is widened and mixed, so on 32-bit targets its own 32 bits
+// are all the entropy there is.
+static uint64_t hash_key(DSCFrozenMap const *map, void const *key) {
+    if (map->hash_fn) {
+        return dsc_hash_mix64((uint64_t)map->hash_fn(key));
+    }
+    return dsc_hash_bytes(key, map->key_size, DSC_HASH_DEFAULT_SEED);
+}
+
+// Maps x uniformly onto [0, n) with a multiply instead of a division.
+static uint64_t fastrange64(uint64_t x, uint64_t n) {
+#if defined(__SIZEOF_INT128__)
+    return (uint64_t)(((__uint128_t)x * n) >> 64);
+#else
+    uint64_t xl = (uint32_t)x, xh = x >> 32;
+    uint64_t nl = (uint32_t)n, nh = n >> 32;
+    uint64_t lh = xl * nh, hl = xh * nl;
+    uint64_t mid = ((xl * nl) >> 32) + (uint32_t)lh + (uint32_t)hl;
+    return xh * nh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+}
+
+static size_t bucket_of(DSCFrozenMap const *map, uint64_t hash) {
+    uint64_t low = (uint32_t)hash;
+    if ((hash >> 32) < DSC_FROZEN_MAP_DENSE_THRESHOLD) {
+        return (size_t)((low * map->dense_buckets) >> 32);
+    }
+    return map->dense_buckets +
+           (size_t)((low * (map->bucket_count - map->dense_buckets)) >> 32);
+}
+
+// Each pilot offsets the hash by a distinct multiple of an odd constant
+// before mixing, so successive pilots send a key to unrelated slots.
+static size_t slot_of(DSCFrozenMap const *map, uint64_t hash,
+                      uint32_t pilot) {
+    uint64_t mixed = dsc_hash_mix64(hash + pilot * DSC_HASH_DEFAULT_SEED);
+    return (size_t)fastrange64(mixed, map->size);
+}
+
+static int compare_entries(void const *a, void const *b) {
+    DSCFrozenEntry const *x = a;
+    DSCFrozenEntry const *y = b;
+    if (x->bucket != y->bucket) return x->bucket < y->bucket ? -1 : 1;
+    if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+    return 0;
+}
+
+// Largest buckets first; ties in bucket order to keep builds reproducible.
+static int compare_buckets(void const *a, void const *b) {
+    DSCFrozenBucket const *x = a;
+    DSCFrozenBucket const *y = b;
+    if (x->size != y->size) return x->size > y->size ? -1 : 1;
+    return x->bucket < y->bucket ? -1 : 1;
+}
+
+static bool bit_test(uint64_t const *bits, size_t i) {
+    return (bits[i / 64] >> (i % 64)) & 1;
+}
+
+static void bit_flip(uint64_t *bits, size_t i) {
+    bits[i / 64] ^= (uint64_t)1 << (i % 64);
+}
+
+// Finds a pilot that sends every key of the bucket to a distinct free
+// slot, marks those slots taken and records them in slots.
+static bool place_bucket(DSCFrozenMap *map, DSCFrozenEntry const *entries,
+                         DSCFrozenBucket const *bucket, uint64_t *taken,
+                         size_t *slots) {
+    for (uint64_t pilot = 0; pilot <= UINT32_MAX; ++pilot) {
+        size_t placed = 0;
+        for (; placed < bucket->size; ++placed) {
+            size_t slot = slot_of(map, entries[bucket->begin + placed].hash,
+                                  (uint32_t)pilot);
+            // Marking as we go also catches two keys of this bucket
+            // landing on the same slot.
+            if (bit_test(taken, slot)) break;
+            bit_flip(taken, slot);
+            slots[placed] = slot;
+        }
+
+        if (placed == bucket->size) {
+            map->pilots[bucket->bucket] = (uint32_t)pilot;
+            return true;
+        }
+
+        while (placed > 0) {
+            bit_flip(taken, slots[--placed]);
+        }
+    }
+
+    return false;
+}
+
+// Assigns every entry a slot. Returns false if some bucket cannot be
+// placed, which only happens when two keys share a hash.
+static bool build(DSCFrozenMap *map, DSCFrozenEntry *entries) {
+    size_t n = map->size;
+
+    for (size_t i = 0; i < n; ++i) {
+        entries[i].bucket = bucket_of(map, entries[i].hash);
+    }
+    qsort(entries, n, sizeof(DSCFrozenEntry), compare_entries);
+
+    size_t nonempty = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i > 0 && entries[i].hash == entries[i - 1].hash) return false;
+        if (i == 0 || entries[i].bucket != entries[i - 1].bucket) ++nonempty;
+    }
+
+    size_t buckets_size, taken_size, slots_size;
+    if (!dsc_safe_multiply(nonempty, sizeof(DSCFrozenBucket),
+                           &buckets_size) ||
+        !dsc_safe_multiply(n / 64 + 1, sizeof(uint64_t), &taken_size) ||
+        !dsc_safe_multiply(n, sizeof(size_t), &slots_size)) {
+        return false;
+    }
+
+    DSCFrozenBucket *buckets = dsc_malloc(buckets_size ? buckets_size : 1);
+    uint64_t *taken = dsc_malloc(taken_size);
+    size_t *slots = dsc_malloc(slots_size ? slots_size : 1);
+    bool ok = buckets && taken && slots;
+    if (taken) memset(taken, 0, taken_size);
+
+    if (ok) {
+        size_t count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (i == 0 || entries[i].bucket != entries[i - 1].bucket) {
+                buckets[count].bucket = entries[i].bucket;
+                buckets[count].begin = i;
+                buckets[count].size = 0;
+                ++count;
+            }
+            ++buckets[count - 1].size;
+        }
+        qsort(buckets, nonempty, sizeof(DSCFrozenBucket), compare_buckets);
+
+        // Each bucket writes the slots of its own entries, so slots ends
+        // up indexed like entries.
+        for (size_t b = 0; ok && b < nonempty; ++b) {
+            ok = place_bucket(map, entries, &buckets[b], taken,
+                              slots + buckets[b].begin);
+        }
+    }
+
+    if (ok) {
+        for (size_t i = 0; i < n; ++i) {
+            memcpy((char *)map->keys + slots[i] * map->key_size,
+                   entries[i].key, map->key_size);
+            memcpy((char *)map->values + slots[i] * map->value_size,
+                   entries[i].value, map->value_size);
+        }
+    }
+
+    dsc_free(buckets);
+    dsc_free(taken);
+    dsc_free(slots);
+    return ok;
+}
+
+DSCFrozenMap *unordered_map_freeze(DSCUnorderedMap const *map) {
+    if (!map) return NULL;
+
+    size_t n = unordered_map_size(map);
+
+    size_t log2n = 1;
+    while (log2n < sizeof(size_t) * 8 && (n >> log2n) != 0) ++log2n;
+    size_t bucket_count = n / log2n * DSC_FROZEN_MAP_BUCKET_FACTOR +
+                          DSC_FROZEN_MAP_BUCKET_FACTOR;
+
+    // Bucket selection scales 32-bit hash halves by the bucket counts.
+    if (bucket_count > UINT32_MAX) return NULL;
+
+    size_t keys_size, values_size, entries_size;
+    if (!dsc_safe_multiply(n, map->key_size, &keys_size) ||
+        !dsc_safe_multiply(n, map->value_size, &values_size) ||
+        !dsc_safe_multiply(n, sizeof(DSCFrozenEntry), &entries_size)) {
+        return NULL;
+    }
+
+    DSCFrozenMap *frozen = dsc_malloc(sizeof(DSCFrozenMap));
+    if (!frozen) return NULL;
+
+    frozen->size = n;
+    frozen->bucket_count = bucket_count;
+    frozen->dense_buckets = bucket_count * 3 / 10;
+    frozen->key_size = map->key_size;
+    frozen->value_size = map->value_size;
+    frozen->hash_fn = map->hash_fn;
+    frozen->compare_fn = map->compare_fn;
+    frozen->keys = dsc_malloc(keys_size ? keys_size : 1);
+    frozen->values = dsc_malloc(values_size ? values_size : 1);
+    frozen->pilots = dsc_malloc(bucket_count * sizeof(uint32_t));
+
+    DSCFrozenEntry *entries = dsc_malloc(entries_size ? entries_size : 1);
+
+    if (!frozen->keys || !frozen->values || !frozen->pilots || !entries) {
+        dsc_free(entries);
+        frozen_map_destroy(frozen);
+        return NULL;
+    }
+
+    // Buckets no key hashes to keep pilot 0.
+    memset(frozen->pilots, 0, bucket_count * sizeof(uint32_t));
+
+    size_t cursor = 0, count = 0;
+    void *key, *value;
+    while (unordered_map_next(map, &cursor, &key, &value)) {
+        entries[count].hash = hash_key(frozen, key);
+        entries[count].key = key;
+        entries[count].value = value;
+        ++count;
+    }
+
+    bool ok = build(frozen, entries);
+    dsc_free(entries);
+
+    if (!ok) {
+        frozen_map_destroy(frozen);
+        return NULL;
+    }
+
+    return frozen;
+}
+
+void frozen_map_destroy(DSCFrozenMap *map) {
+    if (!map) return;
+    dsc_free(map->keys);
+    dsc_free(map->values);
+    dsc_free(map->pilots);
+    dsc_free(map);
+}
+
+size_t frozen_map_size(DSCFrozenMap const *map) {
+    return map ? map->size : 0;
+}
+
+void const *frozen_map_find(DSCFrozenMap const *map, void const *key) {
+    if (!map || !key || map->size == 0) return NULL;
+
+    uint64_t hash = hash_key(map, key);
+    size_t slot = slot_of(map, hash, map->pilots[bucket_of(map, hash)]);
+
+    void const *stored = (char const *)map->keys + slot * map->key_size;
+    bool equal = map->compare_fn ? map->compare_fn(stored, key) == 0
+                                 : memcmp(stored, key, map->key_size) == 0;
+
+    return equal ? (char const *)map->values + slot * map->value_size : NULL;
+}
+
+bool frozen_map_next(DSCFrozenMap const *map, size_t *cursor,
+                     void const **key, void const **value) {
+    if (!map || !cursor || *cursor >= map->size) return false;
+
+    if (key) *key = (char const *)map->keys + *cursor * map->key_size;
+    if (value) *value = (char const *)map->values + *cursor * map->value_size;
+    ++*cursor;
+
+    return true;
+}
@@ -0,0 +1,266 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "libdsc/intrusive_list.h"
+
+// Links hook between two adjacent hooks.
+static void link_between(DSCIListHook *prev, DSCIListHook *next,
+                         DSCIListHook *hook) {
+    hook->prev = prev;
+    hook->next = next;
+    prev->next = hook;
+    next->prev = hook;
+}
+
+static void unlink_hook(DSCIListHook *hook) {
+    hook->prev->next = hook->next;
+    hook->next->prev = hook->prev;
+    hook->prev = NULL;
+    hook->next = NULL;
+}
+
+// The position to insert before: pos itself, or the sentinel for the back.
+static DSCIListHook *position(DSCIList *list, DSCIListHook *pos) {
+    return pos ? pos : &list->head;
+}
+
+void ilist_init(DSCIList *list) {
+    list->head.prev = &list->head;
+    list->head.next = &list->head;
+    list->size = 0;
+}
+
+void ilist_hook_init(DSCIListHook *hook) {
+    hook->prev = NULL;
+    hook->next = NULL;
+}
+
+bool ilist_hook_linked(DSCIListHook const *hook) {
+    return hook->next != NULL;
+}
+
+size_t ilist_size(DSCIList const *list) {
+    return list ? list->size : 0;
+}
+
+bool ilist_empty(DSCIList const *list) {
+    return !list || list->size == 0;
+}
+
+DSCIListHook *ilist_front(DSCIList const *list) {
+    if (!list || list->size == 0) {
+        return NULL;
+    }
+    return list->head.next;
+}
+
+DSCIListHook *ilist_back(DSCIList const *list) {
+    if (!list || list->size == 0) {
+        return NULL;
+    }
+    return list->head.prev;
+}
+
+DSCIListHook *ilist_next(DSCIList const *list, DSCIListHook const *hook) {
+    return hook->next == &list->head ? NULL : hook->next;
+}
+
+DSCIListHook *ilist_prev(DSCIList const *list, DSCIListHook const *hook) {
+    return hook->prev == &list->head ? NULL : hook->prev;
+}
+
+DSCError ilist_push_front(DSCIList *list, DSCIListHook *hook) {
+    if (!list) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    return ilist_insert(list, ilist_front(list), hook);
+}
+
+DSCError ilist_push_back(DSCIList *list, DSCIListHook *hook) {
+    return ilist_insert(list, NULL, hook);
+}
+
+DSCIListHook *ilist_pop_front(DSCIList *list) {
+    DSCIListHook *hook = ilist_front(list);
+    if (hook) {
+        unlink_hook(hook);
+        --(list->size);
+    }
+    return hook;
+}
+
+DSCIListHook *ilist_pop_back(DSCIList *list) {
+    DSCIListHook *hook = ilist_back(list);
+    if (hook) {
+        unlink_hook(hook);
+        --(list->size);
+    }
+    return hook;
+}
+
+DSCError ilist_insert(DSCIList *list, DSCIListHook *pos, DSCIListHook *hook) {
+    if (!list || !hook || ilist_hook_linked(hook)) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    DSCIListHook *next = position(list, pos);
+    link_between(next->prev, next, hook);
+    ++(list->size);
+    return DSC_ERROR_OK;
+}
+
+DSCError ilist_erase(DSCIList *list, DSCIListHook *hook) {
+    if (!list || !hook || !ilist_hook_linked(hook)) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    unlink_hook(hook);
+    --(list->size);
+    return DSC_ERROR_OK;
+}
+
+DSCError ilist_splice(DSCIList *dst, DSCIListHook *pos, DSCIList *src) {
+    if (!dst || !src || dst == src) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    if (src->size == 0) {
+        return DSC_ERROR_OK;
+    }
+
+    DSCIListHook *first = src->head.next;
+    DSCIListHook *last = src->head.prev;
+    DSCIListHook *next = position(dst, pos);
+    DSCIListHook *prev = next->prev;
+
+    prev->next = first;
+    first->prev = prev;
+    last->next = next;
+    next->prev = last;
+    dst->size += src->size;
+
+    ilist_init(src);
+    return DSC_ERROR_OK;
+}
+
+void ilist_splice_element(DSCIList *dst, DSCIListHook *pos, DSCIList *src,
+                          DSCIListHook *hook) {
+    DSCIListHook *next = position(dst, pos);
+    unlink_hook(hook);
+    --(src->size);
+    link_between(next->prev, next, hook);
+    ++(dst->size);
+}
+
+void ilist_clear(DSCIList *list) {
+    if (!list) {
+        return;
+    }
+
+    DSCIListHook *hook = list->head.next;
+    while (hook != &list->head) {
+        DSCIListHook *next = hook->next;
+        ilist_hook_init(hook);
+        hook = next;
+    }
+    ilist_init(list);
+}
+
+void islist_init(DSCISList *list) {
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+}
+
+void islist_hook_init(DSCISListHook *hook) {
+    hook->next = hook;
+}
+
+bool islist_hook_linked(DSCISListHook const *hook) {
+    return hook->next != hook;
+}
+
+size_t islist_size(DSCISList const *list) {
+    return list ? list->size : 0;
+}
+
+bool islist_empty(DSCISList const *list) {
+    return !list || list->size == 0;
+}
+
+DSCISListHook *islist_front(DSCISList const *list) {
+    return list ? list->head : NULL;
+}
+
+DSCISListHook *islist_back(DSCISList const *list) {
+    return list ? list->tail : NULL;
+}
+
+DSCError islist_push_front(DSCISList *list, DSCISListHook *hook) {
+    return islist_insert_after(list, NULL, hook);
+}
+
+DSCError islist_push_back(DSCISList *list, DSCISListHook *hook) {
+    if (!list) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    return islist_insert_after(list, list->tail, hook);
+}
+
+DSCISListHook *islist_pop_front(DSCISList *list) {
+    if (!list) {
+        return NULL;
+    }
+    return islist_erase_after(list, NULL);
+}
+
+DSCError islist_insert_after(DSCISList *list, DSCISListHook *pos,
+                             DSCISListHook *hook) {
+    if (!list || !hook || islist_hook_linked(hook)) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    DSCISListHook **link = pos ? &pos->next : &list->head;
+    hook->next = *link;
+    *link = hook;
+    if (!hook->next) {
+        list->tail = hook;
+    }
+    ++(list->size);
+    return DSC_ERROR_OK;
+}
+
+DSCISListHook *islist_erase_after(DSCISList *list, DSCISListHook *pos) {
+    DSCISListHook **link = pos ? &pos->next : &list->head;
+    DSCISListHook *hook = *link;
+    if (!hook) {
+        return NULL;
+    }
+
+    *link = hook->next;
+    if (list->tail == hook) {
+        list->tail = pos;
+    }
+    islist_hook_init(hook);
+    --(list->size);
+    return hook;
+}
+
+DSCError islist_splice_after(DSCISList *dst, DSCISListHook *pos,
+                             DSCISList *src) {
+    if (!dst || !src || dst == src) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    if (src->size == 0) {
+        return DSC_ERROR_OK;
+    }
+
+    DSCISListHook **link = pos ? &pos->next : &dst->head;
+    src->tail->next = *link;
+    if (!*link) {
+        dst->tail = src->tail;
+    }
+    *link = src->head;
+    dst->size += src->size;
+
+    islist_init(src);
+    return DSC_ERROR_OK;
+}
@@ -2,33 +2,32 @@
 
 #include "libdsc/list.h"
 
-#include <stdlib.h>
 #include <string.h>
 
-static DSCListNode *create_node(void const *element, size_t element_size) {
-    DSCListNode *node = malloc(sizeof(DSCListNode));
+static DSCListNode *create_node(DSCList *list, void const *element) {
+    DSCListNode *node = pool_allocate(list->pool);
     if (!node) {
         return NULL;
     }
 
-    node->data = malloc(element_size);
-    if (!node->data) {
-        free(node);
-        return NULL;
-    }
-
-    memcpy(node->data, element, element_size);
+    memcpy(node->data, element, list->element_size);
     node->prev = NULL;
     node->next = NULL;
     return node;
 }
 
+static void destroy_node(DSCList *list, DSCListNode *node) {
+    pool_deallocate(list->pool, node);
+}
+
 DSCList *list_create(size_t element_size) {
-    if (element_size == 0) {
-        return NULL;
-    }
+    return list_create_with_allocator(element_size, NULL);
+}
 
-    DSCList *list = malloc(sizeof(DSCList));
+// Allocates and initializes the list structure around a node pool.
+static DSCList *create_list(size_t element_size, DSCPool *pool,
+                            bool owns_pool) {
+    DSCList *list = dsc_allocate(&pool->allocator, sizeof(DSCList));
     if (list == NULL) {
         return NULL;
     }
@@ -37,17 +36,67 @@ DSCList *list_create(size_t element_size) {
     list->tail = NULL;
     list->size = 0;
     list->element_size = element_size;
+    list->pool = pool;
+    list->owns_pool = owns_pool;
+    list->allocator = pool->allocator;
+
+    return list;
+}
 
+DSCList *list_create_with_allocator(size_t element_size,
+                                    DSCAllocator const *allocator) {
+    if (element_size == 0) {
+        return NULL;
+    }
+
+    size_t node_size = list_node_size(element_size);
+    if (node_size == 0) {
+        return NULL;
+    }
+
+    DSCPool *pool = pool_create_with_allocator(node_size, allocator);
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    DSCList *list = create_list(element_size, pool, true);
+    if (list == NULL) {
+        pool_destroy(pool);
+    }
     return list;
 }
 
+DSCList *list_create_with_pool(size_t element_size, DSCPool *pool) {
+    size_t node_size = list_node_size(element_size);
+    if (element_size == 0 || node_size == 0 || !pool ||
+        pool_block_size(pool) < node_size) {
+        return NULL;
+    }
+
+    return create_list(element_size, pool, false);
+}
+
+size_t list_node_size(size_t element_size) {
+    if (element_size > SIZE_MAX - sizeof(DSCListNode)) {
+        return 0;
+    }
+    return sizeof(DSCListNode) + element_size;
+}
+
 void list_destroy(DSCList *list) {
     if (list == NULL) {
         return;
     }
 
-    list_clear(list);
-    free(list);
+    // An owned pool takes every node with it, one slab at a time.
+    if (list->owns_pool) {
+        pool_destroy(list->pool);
+    } else {
+        list_clear(list);
+    }
+
+    DSCAllocator alloc = list->allocator;
+    dsc_deallocate(&alloc, list, sizeof(DSCList));
 }
 
 size_t list_size(const DSCList *list) {
@@ -63,7 +112,7 @@ DSCError list_push_front(DSCList *list, const void *element) {
         return DSC_ERROR_INVALID_ARGUMENT;
     }
 
-    DSCListNode *node = create_node(element, list->element_size);
+    DSCListNode *node = create_node(list, element);
     if (!node) {
         return DSC_ERROR_MEMORY;
     }
@@ -87,7 +136,7 @@ DSCError list_push_back(DSCList *list, const void *element) {
         return DSC_ERROR_INVALID_ARGUMENT;
     }
 
-    DSCListNode *node = create_node(element, list->element_size);
+    DSCListNode *node = create_node(list, element);
     if (!node) {
         return DSC_ERROR_MEMORY;
     }
@@ -124,8 +173,7 @@ DSCError list_pop_front(DSCList *list) {
         list->head->prev = NULL;
     }
 
-    free(old_head->data);
-    free(old_head);
+    destroy_node(list, old_head);
     --(list->size);
 
     return DSC_ERROR_OK;
@@ -149,8 +197,7 @@ DSCError list_pop_back(DSCList *list) {
         list->tail->next = NULL;
     }
 
-    free(old_tail->data);
-    free(old_tail);
+    destroy_node(list, old_tail);
     --(list->size);
 
     return DSC_ERROR_OK;
@@ -181,7 +228,7 @@ DSCError list_insert(DSCList *list, DSCListNode *pos, void const *element) {
         return list_push_front(list, element);
     }
 
-    DSCListNode *node = create_node(element, list->element_size);
+    DSCListNode *node = create_node(list, element);
     if (!node) {
         return DSC_ERROR_MEMORY;
     }
@@ -216,8 +263,7 @@ DSCError list_erase(DSCList *list, DSCListNode *pos) {
     pos->prev->next = pos->next;
     pos->next->prev = pos->prev;
 
-    free(pos->data);
-    free(pos);
+    destroy_node(list, pos);
     --(list->size);
 
     return DSC_ERROR_OK;
@@ -228,12 +274,15 @@ void list_clear(DSCList *list) {
         return;
     }
 
-    DSCListNode *current = list->head;
-    while (current) {
-        DSCListNode *next = current->next;
-        free(current->data);
-        free(current);
-        current = next;
+    if (list->owns_pool) {
+        pool_reset(list->pool);
+    } else {
+        DSCListNode *current = list->head;
+        while (current) {
+            DSCListNode *next = current->next;
+            destroy_node(list, current);
+            current = next;
+        }
     }
 
     list->head = NULL;
@@ -241,6 +290,203 @@ void list_clear(DSCList *list) {
     list->size = 0;
 }
 
+// Moves the nodes of src into a NULL-terminated chain from first to last
+// that dst can own: src's own nodes if the lists share a pool, otherwise
+// copies from dst's pool. Leaves src empty on success and unchanged on
+// failure.
+static DSCError take_nodes(DSCList *dst, DSCList *src, DSCListNode **first,
+                           DSCListNode **last) {
+    if (src->pool == dst->pool) {
+        *first = src->head;
+        *last = src->tail;
+        src->head = NULL;
+        src->tail = NULL;
+        src->size = 0;
+        return DSC_ERROR_OK;
+    }
+
+    DSCListNode *head = NULL;
+    DSCListNode *tail = NULL;
+    for (DSCListNode *node = src->head; node; node = node->next) {
+        DSCListNode *copy = create_node(dst, node->data);
+        if (!copy) {
+            while (head) {
+                DSCListNode *next = head->next;
+                destroy_node(dst, head);
+                head = next;
+            }
+            return DSC_ERROR_MEMORY;
+        }
+
+        copy->prev = tail;
+        if (tail) {
+            tail->next = copy;
+        } else {
+            head = copy;
+        }
+        tail = copy;
+    }
+
+    list_clear(src);
+    *first = head;
+    *last = tail;
+    return DSC_ERROR_OK;
+}
+
+// Merges two sorted chains linked through next, taking from a on ties.
+static DSCListNode *merge_runs(DSCListNode *a, DSCListNode *b,
+                               int (*compare)(void const *, void const *)) {
+    DSCListNode *head = NULL;
+    DSCListNode **link = &head;
+    while (a && b) {
+        if (compare(b->data, a->data) < 0) {
+            *link = b;
+            link = &b->next;
+            b = b->next;
+        } else {
+            *link = a;
+            link = &a->next;
+            a = a->next;
+        }
+    }
+    *link = a ? a : b;
+    return head;
+}
+
+// Makes the chain starting at head the list's nodes, restoring the prev
+// links and the tail.
+static void relink(DSCList *list, DSCListNode *head) {
+    DSCListNode *prev = NULL;
+    for (DSCListNode *node = head; node; node = node->next) {
+        node->prev = prev;
+        prev = node;
+    }
+    list->head = head;
+    list->tail = prev;
+}
+
+static bool compatible(DSCList const *dst, DSCList const *src) {
+    return dst && src && dst != src &&
+           dst->element_size == src->element_size;
+}
+
+DSCError list_splice(DSCList *dst, DSCListNode *pos, DSCList *src) {
+    if (!compatible(dst, src)) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    if (src->size == 0) {
+        return DSC_ERROR_OK;
+    }
+
+    size_t count = src->size;
+    DSCListNode *first;
+    DSCListNode *last;
+    DSCError err = take_nodes(dst, src, &first, &last);
+    if (err != DSC_ERROR_OK) {
+        return err;
+    }
+
+    DSCListNode *prev = pos ? pos->prev : dst->tail;
+    first->prev = prev;
+    last->next = pos;
+    if (prev) {
+        prev->next = first;
+    } else {
+        dst->head = first;
+    }
+    if (pos) {
+        pos->prev = last;
+    } else {
+        dst->tail = last;
+    }
+    dst->size += count;
+
+    return DSC_ERROR_OK;
+}
+
+DSCError list_merge(DSCList *dst, DSCList *src,
+                    int (*compare)(void const *, void const *)) {
+    if (!compatible(dst, src) || !compare) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    if (src->size == 0) {
+        return DSC_ERROR_OK;
+    }
+
+    size_t count = src->size;
+    DSCListNode *first;
+    DSCListNode *last;
+    DSCError err = take_nodes(dst, src, &first, &last);
+    if (err != DSC_ERROR_OK) {
+        return err;
+    }
+
+    relink(dst, merge_runs(dst->head, first, compare));
+    dst->size += count;
+
+    return DSC_ERROR_OK;
+}
+
+DSCError list_sort(DSCList *list, int (*compare)(void const *, void const *)) {
+    if (!list || !compare) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    if (list->size < 2) {
+        return DSC_ERROR_OK;
+    }
+
+    // runs[i] is empty or a sorted run of 2^i nodes, holding nodes that
+    // came before those of runs[i - 1]. Each node is merged up like a
+    // binary counter increment.
+    DSCListNode *runs[sizeof(size_t) * 8] = {NULL};
+    size_t top = 0;
+
+    DSCListNode *node = list->head;
+    while (node) {
+        DSCListNode *run = node;
+        node = node->next;
+        run->next = NULL;
+
+        size_t i = 0;
+        for (; runs[i]; ++i) {
+            run = merge_runs(runs[i], run, compare);
+            runs[i] = NULL;
+        }
+        runs[i] = run;
+        if (i > top) {
+            top = i;
+        }
+    }
+
+    DSCListNode *sorted = NULL;
+    for (size_t i = 0; i <= top; ++i) {
+        if (runs[i]) {
+            sorted = sorted ? merge_runs(runs[i], sorted, compare) : runs[i];
+        }
+    }
+    relink(list, sorted);
+
+    return DSC_ERROR_OK;
+}
+
+void list_reverse(DSCList *list) {
+    if (!list) {
+        return;
+    }
+
+    DSCListNode *node = list->head;
+    while (node) {
+        DSCListNode *next = node->next;
+        node->next = node->prev;
+        node->prev = next;
+        node = next;
+    }
+
+    DSCListNode *head = list->head;
+    list->head = list->tail;
+    list->tail = head;
+}
+
 DSCListNode *list_begin(DSCList const *list) {
     return list ? list->head : NULL;
 }
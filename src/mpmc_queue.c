@@ -0,0 +1,328 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define _GNU_SOURCE
+
+#include "libdsc/mpmc_queue.h"
+
+#include <limits.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "libdsc/hash_table.h"
+
+// Each slot is a sequence number followed by the element. Slot i & mask
+// is free for the producer of position i when its sequence equals i, and
+// holds the element for the consumer of position i when it equals i + 1;
+// the consumer then frees it for the next lap by setting it to
+// i + capacity.
+
+// Lets threads sleep until the opposite operation makes progress: a
+// waiter snapshots events, announces itself in waiters and retries the
+// operation before sleeping on events, and a notifier that sees a waiter
+// bumps events so that the sleep returns. The full fences on both sides
+// ensure that either the notifier sees the waiter or the waiter's retry
+// sees the notifier's change.
+typedef struct {
+    _Atomic uint32_t events;
+    _Atomic uint32_t waiters;
+} DSCMpmcSignal;
+
+struct DSCMpmcQueue {
+    // Producers contend on enqueue_pos and consumers on dequeue_pos, so
+    // each gets a cache line of its own.
+    alignas(DSC_CACHE_LINE) _Atomic size_t enqueue_pos;
+    alignas(DSC_CACHE_LINE) _Atomic size_t dequeue_pos;
+
+    alignas(DSC_CACHE_LINE) DSCMpmcSignal not_empty;
+    alignas(DSC_CACHE_LINE) DSCMpmcSignal not_full;
+
+    // Read-only after creation.
+    alignas(DSC_CACHE_LINE) unsigned char *slots;
+    size_t mask;
+    size_t stride;
+    size_t element_size;
+};
+
+// The element follows the sequence number at max_align_t alignment.
+#define DSC_MPMC_ELEMENT_OFFSET                                   \
+    ((sizeof(_Atomic size_t) + alignof(max_align_t) - 1) /        \
+     alignof(max_align_t) * alignof(max_align_t))
+
+static inline _Atomic size_t *slot_sequence(DSCMpmcQueue const *queue,
+                                            size_t position) {
+    return (_Atomic size_t *)(queue->slots +
+                              (position & queue->mask) * queue->stride);
+}
+
+static inline void *slot_element(DSCMpmcQueue const *queue,
+                                 size_t position) {
+    return queue->slots + (position & queue->mask) * queue->stride +
+           DSC_MPMC_ELEMENT_OFFSET;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Sleeps until events may have changed from expected, or for at most
+// timeout_ns if it is not negative. Spurious returns are fine.
+static void signal_sleep(DSCMpmcSignal *signal, uint32_t expected,
+                         int64_t timeout_ns) {
+#ifdef __linux__
+    struct timespec ts;
+    struct timespec *timeout = NULL;
+    if (timeout_ns >= 0) {
+        ts.tv_sec = (time_t)(timeout_ns / 1000000000);
+        ts.tv_nsec = (long)(timeout_ns % 1000000000);
+        timeout = &ts;
+    }
+    syscall(SYS_futex, (uint32_t *)&signal->events, FUTEX_WAIT_PRIVATE,
+            expected, timeout, NULL, 0);
+#else
+    // Without futexes, poll the queue every 50 microseconds.
+    (void)signal;
+    (void)expected;
+    int64_t sleep_ns = 50000;
+    if (timeout_ns >= 0 && timeout_ns < sleep_ns) sleep_ns = timeout_ns;
+    struct timespec ts = {0, (long)sleep_ns};
+    nanosleep(&ts, NULL);
+#endif
+}
+
+static void signal_notify(DSCMpmcSignal *signal) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&signal->waiters, memory_order_relaxed) == 0) {
+        return;
+    }
+
+    atomic_fetch_add_explicit(&signal->events, 1, memory_order_relaxed);
+#ifdef __linux__
+    // Wake everyone: a woken waiter may time out without taking the
+    // element, which must not strand a waiter that would have taken it.
+    syscall(SYS_futex, (uint32_t *)&signal->events, FUTEX_WAKE_PRIVATE,
+            INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+static DSCError try_push(DSCMpmcQueue *queue, void const *element) {
+    size_t pos = atomic_load_explicit(&queue->enqueue_pos,
+                                      memory_order_relaxed);
+    for (;;) {
+        size_t seq = atomic_load_explicit(slot_sequence(queue, pos),
+                                          memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &queue->enqueue_pos, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The slot still holds the element from the previous lap.
+            return DSC_ERROR_FULL;
+        } else {
+            pos = atomic_load_explicit(&queue->enqueue_pos,
+                                       memory_order_relaxed);
+        }
+    }
+
+    memcpy(slot_element(queue, pos), element, queue->element_size);
+    atomic_store_explicit(slot_sequence(queue, pos), pos + 1,
+                          memory_order_release);
+    signal_notify(&queue->not_empty);
+    return DSC_ERROR_OK;
+}
+
+static DSCError try_pop(DSCMpmcQueue *queue, void *out) {
+    size_t pos = atomic_load_explicit(&queue->dequeue_pos,
+                                      memory_order_relaxed);
+    for (;;) {
+        size_t seq = atomic_load_explicit(slot_sequence(queue, pos),
+                                          memory_order_acquire);
+        intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &queue->dequeue_pos, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // No producer has filled the slot for this lap yet.
+            return DSC_ERROR_EMPTY;
+        } else {
+            pos = atomic_load_explicit(&queue->dequeue_pos,
+                                       memory_order_relaxed);
+        }
+    }
+
+    memcpy(out, slot_element(queue, pos), queue->element_size);
+    atomic_store_explicit(slot_sequence(queue, pos), pos + queue->mask + 1,
+                          memory_order_release);
+    signal_notify(&queue->not_full);
+    return DSC_ERROR_OK;
+}
+
+// Pushes element, or pops into out if element is NULL, until it succeeds,
+// sleeping on signal in between and for at most timeout_ns if it is not
+// negative. Returns the last result.
+static DSCError wait_for(DSCMpmcQueue *queue, void const *element, void *out,
+                         DSCMpmcSignal *signal, int64_t timeout_ns) {
+    DSCError error =
+        element ? try_push(queue, element) : try_pop(queue, out);
+    if (error == DSC_ERROR_OK || timeout_ns == 0) {
+        return error;
+    }
+
+    uint64_t deadline = timeout_ns > 0 ? now_ns() + (uint64_t)timeout_ns : 0;
+    for (;;) {
+        uint32_t events =
+            atomic_load_explicit(&signal->events, memory_order_acquire);
+        atomic_fetch_add_explicit(&signal->waiters, 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+
+        error = element ? try_push(queue, element) : try_pop(queue, out);
+        int64_t remaining = -1;
+        if (error != DSC_ERROR_OK && timeout_ns > 0) {
+            uint64_t now = now_ns();
+            remaining = now < deadline ? (int64_t)(deadline - now) : 0;
+        }
+        if (error != DSC_ERROR_OK && remaining != 0) {
+            signal_sleep(signal, events, remaining);
+        }
+
+        atomic_fetch_sub_explicit(&signal->waiters, 1, memory_order_relaxed);
+        if (error == DSC_ERROR_OK || remaining == 0) {
+            return error;
+        }
+    }
+}
+
+DSCMpmcQueue *mpmc_queue_create(size_t element_size, size_t capacity) {
+    if (element_size == 0 || capacity == 0 || capacity > SIZE_MAX / 2 + 1) {
+        return NULL;
+    }
+
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+
+    size_t align = alignof(max_align_t);
+    size_t stride, bytes;
+    if (!dsc_safe_add(element_size, DSC_MPMC_ELEMENT_OFFSET + align - 1,
+                      &stride)) {
+        return NULL;
+    }
+    stride -= stride % align;
+
+    // Pad the slots to whole cache lines, as aligned_alloc requires.
+    if (!dsc_safe_multiply(rounded, stride, &bytes) ||
+        !dsc_safe_add(bytes, DSC_CACHE_LINE - 1, &bytes)) {
+        return NULL;
+    }
+    bytes &= ~(size_t)(DSC_CACHE_LINE - 1);
+
+    // sizeof(DSCMpmcQueue) is a multiple of its alignment, as
+    // aligned_alloc requires.
+    DSCMpmcQueue *queue =
+        aligned_alloc(alignof(DSCMpmcQueue), sizeof(DSCMpmcQueue));
+    if (!queue) {
+        return NULL;
+    }
+
+    queue->slots = aligned_alloc(DSC_CACHE_LINE, bytes);
+    if (!queue->slots) {
+        free(queue);
+        return NULL;
+    }
+
+    queue->mask = rounded - 1;
+    queue->stride = stride;
+    queue->element_size = element_size;
+    for (size_t i = 0; i < rounded; ++i) {
+        atomic_init(slot_sequence(queue, i), i);
+    }
+    atomic_init(&queue->enqueue_pos, 0);
+    atomic_init(&queue->dequeue_pos, 0);
+    atomic_init(&queue->not_empty.events, 0);
+    atomic_init(&queue->not_empty.waiters, 0);
+    atomic_init(&queue->not_full.events, 0);
+    atomic_init(&queue->not_full.waiters, 0);
+    return queue;
+}
+
+void mpmc_queue_destroy(DSCMpmcQueue *queue) {
+    if (!queue) {
+        return;
+    }
+
+    free(queue->slots);
+    free(queue);
+}
+
+size_t mpmc_queue_capacity(DSCMpmcQueue const *queue) {
+    return queue ? queue->mask + 1 : 0;
+}
+
+size_t mpmc_queue_size(DSCMpmcQueue const *queue) {
+    if (!queue) {
+        return 0;
+    }
+
+    // Consumers may have claimed positions past the enqueue position read
+    // a moment earlier, so clamp the difference to the valid range.
+    size_t head =
+        atomic_load_explicit(&queue->dequeue_pos, memory_order_acquire);
+    size_t tail =
+        atomic_load_explicit(&queue->enqueue_pos, memory_order_acquire);
+    if ((intptr_t)(tail - head) <= 0) {
+        return 0;
+    }
+    size_t size = tail - head;
+    return size > queue->mask + 1 ? queue->mask + 1 : size;
+}
+
+bool mpmc_queue_empty(DSCMpmcQueue const *queue) {
+    return mpmc_queue_size(queue) == 0;
+}
+
+DSCError mpmc_queue_push(DSCMpmcQueue *queue, void const *element) {
+    if (!queue || !element) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    return try_push(queue, element);
+}
+
+DSCError mpmc_queue_pop(DSCMpmcQueue *queue, void *out) {
+    if (!queue || !out) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    return try_pop(queue, out);
+}
+
+DSCError mpmc_queue_push_wait(DSCMpmcQueue *queue, void const *element,
+                              int64_t timeout_ns) {
+    if (!queue || !element) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    return wait_for(queue, element, NULL, &queue->not_full, timeout_ns);
+}
+
+DSCError mpmc_queue_pop_wait(DSCMpmcQueue *queue, void *out,
+                             int64_t timeout_ns) {
+    if (!queue || !out) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    return wait_for(queue, NULL, out, &queue->not_empty, timeout_ns);
+}
@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "libdsc/pool.h"
+
+#include <stdint.h>
+
+// Blocks are aligned like malloc() and large enough to hold the free list
+// link.
+#define DSC_POOL_ALIGNMENT _Alignof(max_align_t)
+
+struct DSCPoolSlab {
+    DSCPoolSlab *next;  // Next slab, in use or kept after a reset
+    size_t capacity;    // Number of blocks in data
+    max_align_t data[];
+};
+
+static size_t slab_bytes(DSCPool const *pool, size_t blocks) {
+    return sizeof(DSCPoolSlab) + blocks * pool->block_size;
+}
+
+static void use_slab(DSCPool *pool, DSCPoolSlab *slab) {
+    pool->current = slab;
+    pool->ptr = (char *)slab->data;
+    pool->end = (char *)slab->data + slab->capacity * pool->block_size;
+}
+
+// Moves on to the slab after the current one, allocating it if the pool
+// has not been this large before.
+static bool next_slab(DSCPool *pool) {
+    DSCPoolSlab *next = pool->current ? pool->current->next : pool->first;
+    if (next) {
+        use_slab(pool, next);
+        return true;
+    }
+
+    size_t blocks = pool->slab_blocks;
+    DSCPoolSlab *slab = dsc_allocate(&pool->allocator, slab_bytes(pool, blocks));
+    if (!slab) return false;
+
+    slab->next = NULL;
+    slab->capacity = blocks;
+    if (pool->current) {
+        pool->current->next = slab;
+    } else {
+        pool->first = slab;
+    }
+    pool->capacity += blocks;
+
+    if (blocks * pool->block_size <=
+        (DSC_POOL_MAX_SLAB_BYTES - sizeof(DSCPoolSlab)) / 2) {
+        pool->slab_blocks = blocks * 2;
+    }
+    use_slab(pool, slab);
+    return true;
+}
+
+DSCPool *pool_create(size_t block_size) {
+    return pool_create_with_allocator(block_size, NULL);
+}
+
+DSCPool *pool_create_with_allocator(size_t block_size,
+                                    DSCAllocator const *allocator) {
+    size_t slab_size;
+    if (block_size == 0 || !dsc_allocator_valid(allocator) ||
+        block_size > SIZE_MAX - DSC_POOL_ALIGNMENT) {
+        return NULL;
+    }
+    block_size = (block_size + DSC_POOL_ALIGNMENT - 1) &
+                 ~(DSC_POOL_ALIGNMENT - 1);
+    if (!dsc_safe_multiply(block_size, DSC_POOL_MIN_SLAB_BLOCKS,
+                           &slab_size) ||
+        !dsc_safe_add(slab_size, sizeof(DSCPoolSlab), &slab_size)) {
+        return NULL;
+    }
+
+    DSCAllocator alloc = dsc_allocator_or_default(allocator);
+    DSCPool *pool = dsc_allocate(&alloc, sizeof(DSCPool));
+    if (!pool) return NULL;
+
+    pool->first = NULL;
+    pool->current = NULL;
+    pool->ptr = NULL;
+    pool->end = NULL;
+    pool->free_list = NULL;
+    pool->block_size = block_size;
+    pool->slab_blocks = DSC_POOL_MIN_SLAB_BLOCKS;
+    pool->capacity = 0;
+    pool->allocator = alloc;
+    return pool;
+}
+
+void pool_destroy(DSCPool *pool) {
+    if (!pool) return;
+
+    DSCAllocator alloc = pool->allocator;
+    DSCPoolSlab *slab = pool->first;
+    while (slab) {
+        DSCPoolSlab *next = slab->next;
+        dsc_deallocate(&alloc, slab, slab_bytes(pool, slab->capacity));
+        slab = next;
+    }
+    dsc_deallocate(&alloc, pool, sizeof(DSCPool));
+}
+
+void *pool_allocate(DSCPool *pool) {
+    if (!pool) return NULL;
+
+    void *block = pool->free_list;
+    if (block) {
+        pool->free_list = *(void **)block;
+        return block;
+    }
+
+    if (pool->ptr == pool->end && !next_slab(pool)) {
+        return NULL;
+    }
+    block = pool->ptr;
+    pool->ptr += pool->block_size;
+    return block;
+}
+
+void pool_deallocate(DSCPool *pool, void *block) {
+    if (!pool || !block) return;
+
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+}
+
+void pool_reset(DSCPool *pool) {
+    if (!pool) return;
+
+    pool->free_list = NULL;
+    if (pool->first) {
+        use_slab(pool, pool->first);
+    }
+}
+
+size_t pool_block_size(DSCPool const *pool) {
+    return pool ? pool->block_size : 0;
+}
+
+size_t pool_capacity(DSCPool const *pool) {
+    return pool ? pool->capacity : 0;
+}
@@ -2,59 +2,55 @@
 
 #include "libdsc/queue.h"
 
-#include <stdlib.h>
 #include <string.h>
 
 #define DSC_QUEUE_INITIAL_CAPACITY 16
 
-static DSCError grow(DSCQueue *queue) {
-    size_t new_capacity;
-    if (!dsc_safe_grow_capacity(queue->capacity, &new_capacity)) {
-        return DSC_ERROR_OVERFLOW;
-    }
+// The capacity is always a power of two, so positions wrap with a mask.
+// capacity * element_size was checked when the buffer was allocated, so
+// offsets within it cannot overflow.
+
+static inline char *slot(DSCQueue const *queue, size_t index) {
+    return (char *)queue->elements +
+           (index & (queue->capacity - 1)) * queue->element_size;
+}
 
+// Splits count elements starting at index into the part before the end
+// of the buffer and the part wrapped around to its start.
+static size_t split(DSCQueue const *queue, size_t index, size_t count,
+                    DSCQueueSpan spans[2]) {
+    index &= queue->capacity - 1;
+    size_t first = queue->capacity - index;
+    if (first > count) first = count;
+
+    spans[0].data = slot(queue, index);
+    spans[0].count = first;
+    spans[1].data = queue->elements;
+    spans[1].count = count - first;
+    return (first > 0) + (count > first);
+}
+
+// Moves the elements, in order, to the start of a new buffer.
+static DSCError relocate(DSCQueue *queue, size_t new_capacity) {
     size_t new_size;
     if (!dsc_safe_multiply(new_capacity, queue->element_size, &new_size)) {
         return DSC_ERROR_OVERFLOW;
     }
 
-    void *new_elements = dsc_malloc(new_size);
-
+    char *new_elements = dsc_allocate(&queue->allocator, new_size);
     if (!new_elements) return DSC_ERROR_MEMORY;
 
-    // Copy elements from front to back
-    if (queue->front <= queue->back) {
-        size_t front_offset, copy_size;
-        if (!dsc_safe_multiply(queue->front, queue->element_size,
-                               &front_offset) ||
-            !dsc_safe_multiply(queue->size, queue->element_size, &copy_size)) {
-            dsc_free(new_elements);
-            return DSC_ERROR_OVERFLOW;
-        }
-        memcpy(new_elements, (char *)queue->elements + front_offset, copy_size);
-    } else {
-        // Copy elements from front to end
-        size_t first_part = queue->capacity - queue->front;
-        size_t front_offset, first_part_size, first_part_offset, back_size;
-        if (!dsc_safe_multiply(queue->front, queue->element_size,
-                               &front_offset) ||
-            !dsc_safe_multiply(first_part, queue->element_size,
-                               &first_part_size) ||
-            !dsc_safe_multiply(first_part, queue->element_size,
-                               &first_part_offset) ||
-            !dsc_safe_multiply(queue->back, queue->element_size, &back_size)) {
-            dsc_free(new_elements);
-            return DSC_ERROR_OVERFLOW;
-        }
-        memcpy(new_elements, (char *)queue->elements + front_offset,
-               first_part_size);
-
-        // Copy elements from start to back
-        memcpy((char *)new_elements + first_part_offset, queue->elements,
-               back_size);
+    DSCQueueSpan spans[2];
+    size_t count = queue_front_span(queue, spans);
+    char *dst = new_elements;
+    for (size_t i = 0; i < count; ++i) {
+        size_t bytes = spans[i].count * queue->element_size;
+        memcpy(dst, spans[i].data, bytes);
+        dst += bytes;
     }
 
-    dsc_free(queue->elements);
+    dsc_deallocate(&queue->allocator, queue->elements,
+                   queue->capacity * queue->element_size);
     queue->elements = new_elements;
     queue->capacity = new_capacity;
     queue->front = 0;
@@ -63,12 +59,36 @@ static DSCError grow(DSCQueue *queue) {
     return DSC_ERROR_OK;
 }
 
+// Grows the buffer to the smallest power of two holding n elements.
+static DSCError ensure_capacity(DSCQueue *queue, size_t n) {
+    if (n <= queue->capacity) return DSC_ERROR_OK;
+
+    size_t new_capacity = queue->capacity;
+    while (new_capacity < n) {
+        if (new_capacity > SIZE_MAX / 2) return DSC_ERROR_OVERFLOW;
+        new_capacity *= 2;
+    }
+    return relocate(queue, new_capacity);
+}
+
 DSCQueue *queue_create(size_t element_size) {
-    if (element_size == 0) {
+    return queue_create_with_allocator(element_size, NULL);
+}
+
+DSCQueue *queue_create_with_allocator(size_t element_size,
+                                      DSCAllocator const *allocator) {
+    if (element_size == 0 || !dsc_allocator_valid(allocator)) {
+        return NULL;
+    }
+
+    size_t initial_size;
+    if (!dsc_safe_multiply(DSC_QUEUE_INITIAL_CAPACITY, element_size,
+                           &initial_size)) {
         return NULL;
     }
 
-    DSCQueue *queue = dsc_malloc(sizeof(DSCQueue));
+    DSCAllocator alloc = dsc_allocator_or_default(allocator);
+    DSCQueue *queue = dsc_allocate(&alloc, sizeof(DSCQueue));
     if (!queue) return NULL;
 
     queue->capacity = DSC_QUEUE_INITIAL_CAPACITY;
@@ -76,16 +96,11 @@ DSCQueue *queue_create(size_t element_size) {
     queue->front = 0;
     queue->back = 0;
     queue->element_size = element_size;
+    queue->allocator = alloc;
 
-    size_t initial_size;
-    if (!dsc_safe_multiply(queue->capacity, element_size, &initial_size)) {
-        dsc_free(queue);
-        return NULL;
-    }
-
-    queue->elements = dsc_malloc(initial_size);
+    queue->elements = dsc_allocate(&alloc, initial_size);
     if (!queue->elements) {
-        dsc_free(queue);
+        dsc_deallocate(&alloc, queue, sizeof(DSCQueue));
         return NULL;
     }
 
@@ -94,8 +109,11 @@ DSCQueue *queue_create(size_t element_size) {
 
 void queue_destroy(DSCQueue *queue) {
     if (!queue) return;
-    dsc_free(queue->elements);
-    dsc_free(queue);
+
+    DSCAllocator alloc = queue->allocator;
+    dsc_deallocate(&alloc, queue->elements,
+                   queue->capacity * queue->element_size);
+    dsc_deallocate(&alloc, queue, sizeof(DSCQueue));
 }
 
 size_t queue_size(DSCQueue const *queue) { return queue ? queue->size : 0; }
@@ -106,17 +124,13 @@ DSCError queue_push(DSCQueue *queue, void const *element) {
     if (!queue || !element) return DSC_ERROR_INVALID_ARGUMENT;
 
     if (queue->size == queue->capacity) {
-        DSCError err = grow(queue);
+        if (queue->capacity > SIZE_MAX / 2) return DSC_ERROR_OVERFLOW;
+        DSCError err = relocate(queue, queue->capacity * 2);
         if (err != DSC_ERROR_OK) return err;
     }
 
-    size_t back_offset;
-    if (!dsc_safe_multiply(queue->back, queue->element_size, &back_offset)) {
-        return DSC_ERROR_OVERFLOW;
-    }
-    memcpy((char *)queue->elements + back_offset, element, queue->element_size);
-
-    queue->back = (queue->back + 1) % queue->capacity;
+    memcpy(slot(queue, queue->back), element, queue->element_size);
+    queue->back = (queue->back + 1) & (queue->capacity - 1);
     ++(queue->size);
 
     return DSC_ERROR_OK;
@@ -126,29 +140,50 @@ DSCError queue_pop(DSCQueue *queue) {
     if (!queue) return DSC_ERROR_INVALID_ARGUMENT;
     if (queue->size == 0) return DSC_ERROR_EMPTY;
 
-    queue->front = (queue->front + 1) % queue->capacity;
+    queue->front = (queue->front + 1) & (queue->capacity - 1);
     queue->size--;
 
     return DSC_ERROR_OK;
 }
 
+DSCError queue_push_n(DSCQueue *queue, void const *elements, size_t n) {
+    if (!queue || (!elements && n > 0)) return DSC_ERROR_INVALID_ARGUMENT;
+    if (n == 0) return DSC_ERROR_OK;
+
+    DSCQueueSpan spans[2];
+    DSCError err = queue_write_span(queue, n, spans);
+    if (err != DSC_ERROR_OK) return err;
+
+    size_t first = spans[0].count * queue->element_size;
+    memcpy(spans[0].data, elements, first);
+    memcpy(spans[1].data, (char const *)elements + first,
+           spans[1].count * queue->element_size);
+    return queue_commit(queue, n);
+}
+
+size_t queue_pop_n(DSCQueue *queue, void *out, size_t n) {
+    if (!queue || !out) return 0;
+    if (n > queue->size) n = queue->size;
+
+    DSCQueueSpan spans[2];
+    split(queue, queue->front, n, spans);
+    size_t first = spans[0].count * queue->element_size;
+    memcpy(out, spans[0].data, first);
+    memcpy((char *)out + first, spans[1].data,
+           spans[1].count * queue->element_size);
+
+    queue_consume(queue, n);
+    return n;
+}
+
 void *queue_front(DSCQueue const *queue) {
     if (!queue || queue->size == 0) return NULL;
-    size_t front_offset;
-    if (!dsc_safe_multiply(queue->front, queue->element_size, &front_offset)) {
-        return NULL;
-    }
-    return (char *)queue->elements + front_offset;
+    return slot(queue, queue->front);
 }
 
 void *queue_back(DSCQueue const *queue) {
     if (!queue || queue->size == 0) return NULL;
-    size_t back = (queue->back + queue->capacity - 1) % queue->capacity;
-    size_t back_offset;
-    if (!dsc_safe_multiply(back, queue->element_size, &back_offset)) {
-        return NULL;
-    }
-    return (char *)queue->elements + back_offset;
+    return slot(queue, queue->back - 1);
 }
 
 void queue_clear(DSCQueue *queue) {
@@ -160,53 +195,42 @@ void queue_clear(DSCQueue *queue) {
 
 DSCError queue_reserve(DSCQueue *queue, size_t n) {
     if (!queue) return DSC_ERROR_INVALID_ARGUMENT;
-    if (n <= queue->capacity) return DSC_ERROR_OK;
+    return ensure_capacity(queue, n);
+}
 
-    size_t new_size;
-    if (!dsc_safe_multiply(n, queue->element_size, &new_size)) {
-        return DSC_ERROR_OVERFLOW;
-    }
+size_t queue_front_span(DSCQueue const *queue, DSCQueueSpan spans[2]) {
+    if (!queue || !spans) return 0;
+    return split(queue, queue->front, queue->size, spans);
+}
 
-    void *new_elements = dsc_malloc(new_size);
-    if (!new_elements) return DSC_ERROR_MEMORY;
+DSCError queue_consume(DSCQueue *queue, size_t n) {
+    if (!queue) return DSC_ERROR_INVALID_ARGUMENT;
+    if (n > queue->size) return DSC_ERROR_EMPTY;
 
-    // Copy elements from front to back
-    if (queue->front <= queue->back) {
-        size_t front_offset, copy_size;
-        if (!dsc_safe_multiply(queue->front, queue->element_size,
-                               &front_offset) ||
-            !dsc_safe_multiply(queue->size, queue->element_size, &copy_size)) {
-            dsc_free(new_elements);
-            return DSC_ERROR_OVERFLOW;
-        }
-        memcpy(new_elements, (char *)queue->elements + front_offset, copy_size);
-    } else {
-        // Copy elements from front to end
-        size_t first_part = queue->capacity - queue->front;
-        size_t front_offset, first_part_size, first_part_offset, back_size;
-        if (!dsc_safe_multiply(queue->front, queue->element_size,
-                               &front_offset) ||
-            !dsc_safe_multiply(first_part, queue->element_size,
-                               &first_part_size) ||
-            !dsc_safe_multiply(first_part, queue->element_size,
-                               &first_part_offset) ||
-            !dsc_safe_multiply(queue->back, queue->element_size, &back_size)) {
-            dsc_free(new_elements);
-            return DSC_ERROR_OVERFLOW;
-        }
-        memcpy(new_elements, (char *)queue->elements + front_offset,
-               first_part_size);
-
-        // Copy elements from start to back
-        memcpy((char *)new_elements + first_part_offset, queue->elements,
-               back_size);
-    }
+    queue->front = (queue->front + n) & (queue->capacity - 1);
+    queue->size -= n;
 
-    dsc_free(queue->elements);
-    queue->elements = new_elements;
-    queue->capacity = n;
-    queue->front = 0;
-    queue->back = queue->size;
+    return DSC_ERROR_OK;
+}
+
+DSCError queue_write_span(DSCQueue *queue, size_t n, DSCQueueSpan spans[2]) {
+    if (!queue || !spans) return DSC_ERROR_INVALID_ARGUMENT;
+
+    size_t total;
+    if (!dsc_safe_add(queue->size, n, &total)) return DSC_ERROR_OVERFLOW;
+    DSCError err = ensure_capacity(queue, total);
+    if (err != DSC_ERROR_OK) return err;
+
+    split(queue, queue->back, n, spans);
+    return DSC_ERROR_OK;
+}
+
+DSCError queue_commit(DSCQueue *queue, size_t n) {
+    if (!queue) return DSC_ERROR_INVALID_ARGUMENT;
+    if (n > queue->capacity - queue->size) return DSC_ERROR_OVERFLOW;
+
+    queue->back = (queue->back + n) & (queue->capacity - 1);
+    queue->size += n;
 
     return DSC_ERROR_OK;
 }
@@ -0,0 +1,307 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "libdsc/read_mostly_map.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "libdsc/hash_table.h"
+
+// Epoch-based reclamation: the global epoch advances on every publish,
+// and each replaced table is tagged with the epoch it was retired in. A
+// reader inside a read section advertises the epoch it entered at, and
+// can only be looking at tables retired at that epoch or later, so a
+// table is freed once its tag is below every advertised epoch. Epoch 0
+// marks a reader outside any read section.
+
+struct DSCReadMostlyReader {
+    // Written only by the owning thread; scanned by writers.
+    alignas(DSC_CACHE_LINE) _Atomic uint64_t epoch;
+    DSCReadMostlyMap *map;
+    DSCReadMostlyReader *next;
+    bool in_use;
+};
+
+typedef struct DSCRetiredTable {
+    DSCUnorderedMap *table;
+    uint64_t epoch;
+    struct DSCRetiredTable *next;
+} DSCRetiredTable;
+
+struct DSCReadMostlyMap {
+    // Read by every lookup and written only on publish, so they get a
+    // cache line of their own away from the writer state below.
+    alignas(DSC_CACHE_LINE) _Atomic(DSCUnorderedMap *) current;
+    _Atomic uint64_t epoch;
+    _Atomic size_t size;
+
+    alignas(DSC_CACHE_LINE) pthread_mutex_t write_lock;
+    DSCReadMostlyReader *readers;
+    DSCRetiredTable *retired;
+};
+
+typedef struct {
+    void const *key;
+    void const *value;
+} DSCReadMostlyPair;
+
+// Frees every retired table no reader can still see. Called with the
+// write lock held.
+static void reclaim(DSCReadMostlyMap *map) {
+    uint64_t oldest = UINT64_MAX;
+    for (DSCReadMostlyReader *r = map->readers; r; r = r->next) {
+        if (!r->in_use) continue;
+        uint64_t epoch = atomic_load(&r->epoch);
+        if (epoch != 0 && epoch < oldest) oldest = epoch;
+    }
+
+    DSCRetiredTable **link = &map->retired;
+    while (*link) {
+        DSCRetiredTable *node = *link;
+        if (node->epoch < oldest) {
+            *link = node->next;
+            unordered_map_destroy(node->table);
+            free(node);
+        } else {
+            link = &node->next;
+        }
+    }
+}
+
+// Makes table the current one and retires its predecessor. Called with
+// the write lock held; takes ownership of table.
+static DSCError publish(DSCReadMostlyMap *map, DSCUnorderedMap *table) {
+    DSCRetiredTable *node = malloc(sizeof(DSCRetiredTable));
+    if (!node) {
+        unordered_map_destroy(table);
+        return DSC_ERROR_MEMORY;
+    }
+
+    node->table = atomic_exchange(&map->current, table);
+    node->epoch = atomic_fetch_add(&map->epoch, 1);
+    node->next = map->retired;
+    map->retired = node;
+    atomic_store_explicit(&map->size, unordered_map_size(table),
+                          memory_order_relaxed);
+
+    // Pairs with the fence in read_mostly_map_read_lock(): either the
+    // scan in reclaim() sees the reader's epoch, or the reader's next
+    // load of current sees the new table.
+    atomic_thread_fence(memory_order_seq_cst);
+    reclaim(map);
+
+    return DSC_ERROR_OK;
+}
+
+static DSCError copy_and_publish(DSCReadMostlyMap *map,
+                                 DSCReadMostlyUpdateFn update, void *context) {
+    DSCUnorderedMap *current =
+        atomic_load_explicit(&map->current, memory_order_relaxed);
+    DSCUnorderedMap *copy = unordered_map_clone(current);
+    if (!copy) return DSC_ERROR_MEMORY;
+
+    DSCError err = update(copy, context);
+
+    // Lookups on a table with a pending migration move pairs, so readers
+    // may only ever see fully migrated tables.
+    if (err == DSC_ERROR_OK) {
+        err = unordered_map_set_incremental_rehash(copy, false);
+    }
+    if (err != DSC_ERROR_OK) {
+        unordered_map_destroy(copy);
+        return err;
+    }
+
+    return publish(map, copy);
+}
+
+static DSCError insert_pair(DSCUnorderedMap *table, void *context) {
+    DSCReadMostlyPair const *pair = context;
+    return unordered_map_insert(table, pair->key, pair->value);
+}
+
+static DSCError erase_key(DSCUnorderedMap *table, void *context) {
+    DSCReadMostlyPair const *pair = context;
+    return unordered_map_erase(table, pair->key);
+}
+
+DSCReadMostlyMap *read_mostly_map_create(size_t key_size, size_t value_size,
+                                         size_t (*hash_fn)(void const *),
+                                         int (*compare_fn)(void const *,
+                                                           void const *)) {
+    DSCUnorderedMap *table =
+        unordered_map_create(key_size, value_size, hash_fn, compare_fn);
+    if (!table) return NULL;
+
+    // sizeof(DSCReadMostlyMap) is a multiple of its alignment, as
+    // aligned_alloc requires.
+    DSCReadMostlyMap *map =
+        aligned_alloc(alignof(DSCReadMostlyMap), sizeof(DSCReadMostlyMap));
+    if (!map) {
+        unordered_map_destroy(table);
+        return NULL;
+    }
+
+    if (pthread_mutex_init(&map->write_lock, NULL) != 0) {
+        free(map);
+        unordered_map_destroy(table);
+        return NULL;
+    }
+
+    atomic_init(&map->current, table);
+    atomic_init(&map->epoch, 1);
+    atomic_init(&map->size, 0);
+    map->readers = NULL;
+    map->retired = NULL;
+
+    return map;
+}
+
+void read_mostly_map_destroy(DSCReadMostlyMap *map) {
+    if (!map) return;
+
+    while (map->retired) {
+        DSCRetiredTable *node = map->retired;
+        map->retired = node->next;
+        unordered_map_destroy(node->table);
+        free(node);
+    }
+    while (map->readers) {
+        DSCReadMostlyReader *reader = map->readers;
+        map->readers = reader->next;
+        free(reader);
+    }
+
+    unordered_map_destroy(atomic_load(&map->current));
+    pthread_mutex_destroy(&map->write_lock);
+    free(map);
+}
+
+DSCReadMostlyReader *read_mostly_map_register(DSCReadMostlyMap *map) {
+    if (!map) return NULL;
+
+    pthread_mutex_lock(&map->write_lock);
+
+    DSCReadMostlyReader *reader = map->readers;
+    while (reader && reader->in_use) {
+        reader = reader->next;
+    }
+
+    if (!reader) {
+        reader = aligned_alloc(alignof(DSCReadMostlyReader),
+                               sizeof(DSCReadMostlyReader));
+        if (reader) {
+            atomic_init(&reader->epoch, 0);
+            reader->map = map;
+            reader->next = map->readers;
+            map->readers = reader;
+        }
+    }
+    if (reader) reader->in_use = true;
+
+    pthread_mutex_unlock(&map->write_lock);
+
+    return reader;
+}
+
+void read_mostly_map_unregister(DSCReadMostlyReader *reader) {
+    if (!reader) return;
+
+    DSCReadMostlyMap *map = reader->map;
+    pthread_mutex_lock(&map->write_lock);
+    atomic_store_explicit(&reader->epoch, 0, memory_order_relaxed);
+    reader->in_use = false;
+    pthread_mutex_unlock(&map->write_lock);
+}
+
+void read_mostly_map_read_lock(DSCReadMostlyReader *reader) {
+    uint64_t epoch =
+        atomic_load_explicit(&reader->map->epoch, memory_order_acquire);
+    atomic_store_explicit(&reader->epoch, epoch, memory_order_relaxed);
+
+    // Orders the advertisement before any load of the current table; see
+    // publish().
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+void read_mostly_map_read_unlock(DSCReadMostlyReader *reader) {
+    atomic_store_explicit(&reader->epoch, 0, memory_order_release);
+}
+
+void const *read_mostly_map_find(DSCReadMostlyReader *reader,
+                                 void const *key) {
+    if (!reader || !key) return NULL;
+
+    // Published tables are never modified, and lookups on a table with
+    // no pending migration only read it, so readers can share it freely.
+    DSCUnorderedMap *table =
+        atomic_load_explicit(&reader->map->current, memory_order_acquire);
+    return unordered_map_find(table, key);
+}
+
+size_t read_mostly_map_size(DSCReadMostlyMap *map) {
+    if (!map) return 0;
+    return atomic_load_explicit(&map->size, memory_order_relaxed);
+}
+
+DSCError read_mostly_map_insert(DSCReadMostlyMap *map, void const *key,
+                                void const *value) {
+    if (!map || !key || !value) return DSC_ERROR_INVALID_ARGUMENT;
+
+    DSCReadMostlyPair pair = {key, value};
+    pthread_mutex_lock(&map->write_lock);
+    DSCError err = copy_and_publish(map, insert_pair, &pair);
+    pthread_mutex_unlock(&map->write_lock);
+
+    return err;
+}
+
+DSCError read_mostly_map_erase(DSCReadMostlyMap *map, void const *key) {
+    if (!map || !key) return DSC_ERROR_INVALID_ARGUMENT;
+
+    DSCReadMostlyPair pair = {key, NULL};
+    pthread_mutex_lock(&map->write_lock);
+
+    // Skip the copy when there is nothing to erase.
+    DSCError err = DSC_ERROR_NOT_FOUND;
+    if (unordered_map_find(atomic_load_explicit(&map->current,
+                                                memory_order_relaxed),
+                           key)) {
+        err = copy_and_publish(map, erase_key, &pair);
+    }
+
+    pthread_mutex_unlock(&map->write_lock);
+
+    return err;
+}
+
+DSCError read_mostly_map_update(DSCReadMostlyMap *map,
+                                DSCReadMostlyUpdateFn update, void *context) {
+    if (!map || !update) return DSC_ERROR_INVALID_ARGUMENT;
+
+    pthread_mutex_lock(&map->write_lock);
+    DSCError err = copy_and_publish(map, update, context);
+    pthread_mutex_unlock(&map->write_lock);
+
+    return err;
+}
+
+void read_mostly_map_synchronize(DSCReadMostlyMap *map) {
+    if (!map) return;
+
+    for (;;) {
+        pthread_mutex_lock(&map->write_lock);
+        reclaim(map);
+        bool done = map->retired == NULL;
+        pthread_mutex_unlock(&map->write_lock);
+
+        if (done) return;
+        sched_yield();
+    }
+}
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "libdsc/spsc_queue.h"
+
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "libdsc/hash_table.h"
+
+// head and tail count every element ever popped and pushed; they are
+// never wrapped, so tail - head is the size even after size_t overflow,
+// and the slot of position i is i & mask.
+struct DSCSpscQueue {
+    // Written by the producer. cached_head is its private copy of head.
+    alignas(DSC_CACHE_LINE) _Atomic size_t tail;
+    size_t cached_head;
+
+    // Written by the consumer. cached_tail is its private copy of tail.
+    alignas(DSC_CACHE_LINE) _Atomic size_t head;
+    size_t cached_tail;
+
+    // Read-only after creation.
+    alignas(DSC_CACHE_LINE) unsigned char *elements;
+    size_t mask;
+    size_t element_size;
+};
+
+// Copies count elements into the ring starting at position, in at most
+// two pieces around the end of the buffer.
+static void copy_in(DSCSpscQueue *queue, size_t position, void const *src,
+                    size_t count) {
+    size_t index = position & queue->mask;
+    size_t first = queue->mask + 1 - index;
+    if (first > count) first = count;
+
+    memcpy(queue->elements + index * queue->element_size, src,
+           first * queue->element_size);
+    memcpy(queue->elements, (unsigned char const *)src +
+                                first * queue->element_size,
+           (count - first) * queue->element_size);
+}
+
+static void copy_out(DSCSpscQueue const *queue, size_t position, void *dst,
+                     size_t count) {
+    size_t index = position & queue->mask;
+    size_t first = queue->mask + 1 - index;
+    if (first > count) first = count;
+
+    memcpy(dst, queue->elements + index * queue->element_size,
+           first * queue->element_size);
+    memcpy((unsigned char *)dst + first * queue->element_size,
+           queue->elements, (count - first) * queue->element_size);
+}
+
+DSCSpscQueue *spsc_queue_create(size_t element_size, size_t capacity) {
+    if (element_size == 0 || capacity == 0 || capacity > SIZE_MAX / 2 + 1) {
+        return NULL;
+    }
+
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+
+    // Pad the buffer to whole cache lines, as aligned_alloc requires and
+    // so that no other allocation shares its last line.
+    size_t bytes;
+    if (!dsc_safe_multiply(rounded, element_size, &bytes) ||
+        !dsc_safe_add(bytes, DSC_CACHE_LINE - 1, &bytes)) {
+        return NULL;
+    }
+    bytes &= ~(size_t)(DSC_CACHE_LINE - 1);
+
+    // sizeof(DSCSpscQueue) is a multiple of its alignment, as
+    // aligned_alloc requires.
+    DSCSpscQueue *queue =
+        aligned_alloc(alignof(DSCSpscQueue), sizeof(DSCSpscQueue));
+    if (!queue) {
+        return NULL;
+    }
+
+    queue->elements = aligned_alloc(DSC_CACHE_LINE, bytes);
+    if (!queue->elements) {
+        free(queue);
+        return NULL;
+    }
+
+    atomic_init(&queue->tail, 0);
+    atomic_init(&queue->head, 0);
+    queue->cached_head = 0;
+    queue->cached_tail = 0;
+    queue->mask = rounded - 1;
+    queue->element_size = element_size;
+    return queue;
+}
+
+void spsc_queue_destroy(DSCSpscQueue *queue) {
+    if (!queue) {
+        return;
+    }
+
+    free(queue->elements);
+    free(queue);
+}
+
+size_t spsc_queue_capacity(DSCSpscQueue const *queue) {
+    return queue ? queue->mask + 1 : 0;
+}
+
+size_t spsc_queue_size(DSCSpscQueue const *queue) {
+    if (!queue) {
+        return 0;
+    }
+
+    // Load head first: it only grows, so it cannot pass the later tail.
+    size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+    return tail - head;
+}
+
+bool spsc_queue_empty(DSCSpscQueue const *queue) {
+    return spsc_queue_size(queue) == 0;
+}
+
+DSCError spsc_queue_push(DSCSpscQueue *queue, void const *element) {
+    if (!queue || !element) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    if (tail - queue->cached_head > queue->mask) {
+        queue->cached_head =
+            atomic_load_explicit(&queue->head, memory_order_acquire);
+        if (tail - queue->cached_head > queue->mask) {
+            return DSC_ERROR_FULL;
+        }
+    }
+
+    memcpy(queue->elements + (tail & queue->mask) * queue->element_size,
+           element, queue->element_size);
+    atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+    return DSC_ERROR_OK;
+}
+
+size_t spsc_queue_push_n(DSCSpscQueue *queue, void const *elements,
+                         size_t count) {
+    if (!queue || !elements || count == 0) {
+        return 0;
+    }
+
+    size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+    size_t capacity = queue->mask + 1;
+    size_t space = capacity - (tail - queue->cached_head);
+    if (space < count) {
+        queue->cached_head =
+            atomic_load_explicit(&queue->head, memory_order_acquire);
+        space = capacity - (tail - queue->cached_head);
+    }
+    if (count > space) count = space;
+    if (count == 0) {
+        return 0;
+    }
+
+    copy_in(queue, tail, elements, count);
+    atomic_store_explicit(&queue->tail, tail + count, memory_order_release);
+    return count;
+}
+
+DSCError spsc_queue_pop(DSCSpscQueue *queue, void *out) {
+    if (!queue || !out) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    if (head == queue->cached_tail) {
+        queue->cached_tail =
+            atomic_load_explicit(&queue->tail, memory_order_acquire);
+        if (head == queue->cached_tail) {
+            return DSC_ERROR_EMPTY;
+        }
+    }
+
+    memcpy(out, queue->elements + (head & queue->mask) * queue->element_size,
+           queue->element_size);
+    atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+    return DSC_ERROR_OK;
+}
+
+size_t spsc_queue_pop_n(DSCSpscQueue *queue, void *out, size_t count) {
+    if (!queue || !out || count == 0) {
+        return 0;
+    }
+
+    size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+    size_t available = queue->cached_tail - head;
+    if (available < count) {
+        queue->cached_tail =
+            atomic_load_explicit(&queue->tail, memory_order_acquire);
+        available = queue->cached_tail - head;
+    }
+    if (count > available) count = available;
+    if (count == 0) {
+        return 0;
+    }
+
+    copy_out(queue, head, out, count);
+    atomic_store_explicit(&queue->head, head + count, memory_order_release);
+    return count;
+}
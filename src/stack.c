@@ -2,7 +2,6 @@
 
 #include "libdsc/stack.h"
 
-#include <stdlib.h>
 #include <string.h>
 
 #define DSC_STACK_INITIAL_CAPACITY 16
@@ -18,7 +17,9 @@ static DSCError grow_stack(DSCStack *stack) {
         return DSC_ERROR_OVERFLOW;
     }
 
-    void *new_data = dsc_realloc(stack->data, new_size);
+    void *new_data = dsc_reallocate(&stack->allocator, stack->data,
+                                    stack->capacity * stack->element_size,
+                                    new_size);
     if (!new_data) {
         return DSC_ERROR_MEMORY;
     }
@@ -29,30 +30,36 @@ static DSCError grow_stack(DSCStack *stack) {
 }
 
 DSCStack *stack_create(size_t element_size) {
-    if (element_size == 0) {
-        return NULL;
-    }
+    return stack_create_with_allocator(element_size, NULL);
+}
 
-    DSCStack *stack = dsc_malloc(sizeof(DSCStack));
-    if (!stack) {
+DSCStack *stack_create_with_allocator(size_t element_size,
+                                      DSCAllocator const *allocator) {
+    if (element_size == 0 || !dsc_allocator_valid(allocator)) {
         return NULL;
     }
 
     size_t initial_size;
     if (!dsc_safe_multiply(DSC_STACK_INITIAL_CAPACITY, element_size, &initial_size)) {
-        dsc_free(stack);
         return NULL;
     }
 
-    stack->data = dsc_malloc(initial_size);
+    DSCAllocator alloc = dsc_allocator_or_default(allocator);
+    DSCStack *stack = dsc_allocate(&alloc, sizeof(DSCStack));
+    if (!stack) {
+        return NULL;
+    }
+
+    stack->data = dsc_allocate(&alloc, initial_size);
     if (!stack->data) {
-        dsc_free(stack);
+        dsc_deallocate(&alloc, stack, sizeof(DSCStack));
         return NULL;
     }
 
     stack->size = 0;
     stack->capacity = DSC_STACK_INITIAL_CAPACITY;
     stack->element_size = element_size;
+    stack->allocator = alloc;
 
     return stack;
 }
@@ -62,8 +69,10 @@ void stack_destroy(DSCStack *stack) {
         return;
     }
 
-    dsc_free(stack->data);
-    dsc_free(stack);
+    DSCAllocator alloc = stack->allocator;
+    dsc_deallocate(&alloc, stack->data,
+                   stack->capacity * stack->element_size);
+    dsc_deallocate(&alloc, stack, sizeof(DSCStack));
 }
 
 size_t stack_size(DSCStack const *stack) { return stack ? stack->size : 0; }
@@ -106,6 +115,54 @@ DSCError stack_pop(DSCStack *stack) {
     return DSC_ERROR_OK;
 }
 
+DSCError stack_push_n(DSCStack *stack, void const *elements, size_t n) {
+    if (!stack || (!elements && n > 0)) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (n == 0) {
+        return DSC_ERROR_OK;
+    }
+
+    size_t needed;
+    if (!dsc_safe_add(stack->size, n, &needed)) {
+        return DSC_ERROR_OVERFLOW;
+    }
+
+    if (needed > stack->capacity) {
+        size_t new_capacity;
+        if (!dsc_safe_grow_capacity(stack->capacity, &new_capacity)) {
+            return DSC_ERROR_OVERFLOW;
+        }
+        DSCError err = stack_reserve(
+            stack, new_capacity > needed ? new_capacity : needed);
+        if (err != DSC_ERROR_OK) {
+            return err;
+        }
+    }
+
+    // capacity * element_size was checked when the buffer was allocated.
+    memcpy((char *)stack->data + stack->size * stack->element_size, elements,
+           n * stack->element_size);
+    stack->size = needed;
+    return DSC_ERROR_OK;
+}
+
+size_t stack_pop_n(DSCStack *stack, void *out, size_t n) {
+    if (!stack || !out) {
+        return 0;
+    }
+
+    if (n > stack->size) {
+        n = stack->size;
+    }
+
+    stack->size -= n;
+    memcpy(out, (char *)stack->data + stack->size * stack->element_size,
+           n * stack->element_size);
+    return n;
+}
+
 void *stack_top(DSCStack const *stack) {
     if (!stack || stack->size == 0) {
         return NULL;
@@ -139,7 +196,9 @@ DSCError stack_reserve(DSCStack *stack, size_t capacity) {
         return DSC_ERROR_OVERFLOW;
     }
 
-    void *new_data = dsc_realloc(stack->data, new_size);
+    void *new_data = dsc_reallocate(&stack->allocator, stack->data,
+                                    stack->capacity * stack->element_size,
+                                    new_size);
     if (!new_data) {
         return DSC_ERROR_MEMORY;
     }
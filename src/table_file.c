@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "table_file.h"
+
+// Table files need mmap(), fsync() and an atomic rename() over an existing
+// file, so they are only supported on POSIX systems. Elsewhere saving and
+// opening fail with DSC_ERROR_IO.
+#if defined(__unix__) || defined(__APPLE__)
+#define DSC_TABLE_FILE_SUPPORTED 1
+#else
+#define DSC_TABLE_FILE_SUPPORTED 0
+#endif
+
+#if DSC_TABLE_FILE_SUPPORTED
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "libdsc/hash_table.h"
+
+#define DSC_TABLE_FILE_BYTE_ORDER 0x01020304u
+
+static uint64_t align_up(uint64_t offset) {
+    return (offset + DSC_TABLE_FILE_ALIGNMENT - 1) &
+           ~(uint64_t)(DSC_TABLE_FILE_ALIGNMENT - 1);
+}
+
+static bool write_padding(FILE *file, uint64_t from, uint64_t to) {
+    static char const zeros[DSC_TABLE_FILE_ALIGNMENT] = {0};
+    return to - from == 0 || fwrite(zeros, 1, to - from, file) == to - from;
+}
+
+// Writes the file through fd, which it always closes.
+static bool write_file(int fd, DSCTableFileHeader const *header,
+                       void const *const sections[]) {
+    // mkstemp() creates the file private to its owner; the table is meant
+    // to be mapped by other processes too.
+    FILE *file = fchmod(fd, 0644) == 0 ? fdopen(fd, "wb") : NULL;
+    if (!file) {
+        close(fd);
+        return false;
+    }
+
+    bool ok = fwrite(header, sizeof(*header), 1, file) == 1;
+    uint64_t pos = sizeof(*header);
+    for (int i = 0; ok && i < DSC_TABLE_SECTION_COUNT; ++i) {
+        if (header->lengths[i] == 0) continue;
+        ok = write_padding(file, pos, header->offsets[i]) &&
+             fwrite(sections[i], 1, header->lengths[i], file) ==
+                 header->lengths[i];
+        pos = header->offsets[i] + header->lengths[i];
+    }
+    ok = ok && write_padding(file, pos, header->file_size);
+
+    ok = fflush(file) == 0 && ok;
+    ok = ok && fsync(fileno(file)) == 0;
+    return fclose(file) == 0 && ok;
+}
+
+DSCError dsc_table_file_save(char const *path, DSCTableFileHeader *header,
+                             void const *const sections[]) {
+    header->version = DSC_TABLE_FILE_VERSION;
+    header->byte_order = DSC_TABLE_FILE_BYTE_ORDER;
+    header->hash_bits = (uint32_t)(sizeof(size_t) * 8);
+    header->group_width = DSC_GROUP_WIDTH;
+
+    uint64_t offset = align_up(sizeof(DSCTableFileHeader));
+    for (int i = 0; i < DSC_TABLE_SECTION_COUNT; ++i) {
+        header->offsets[i] = header->lengths[i] ? offset : 0;
+        offset = align_up(offset + header->lengths[i]);
+    }
+    header->file_size = offset;
+
+    // Write to a uniquely named file next to the destination and rename
+    // it over the destination once it is synced. The old file stays intact
+    // for anyone mapping it until the new one is complete, and concurrent
+    // saves to the same path never write to the same temporary file.
+    static char const suffix[] = ".XXXXXX";
+    size_t path_len = strlen(path);
+    char *tmp_path = dsc_malloc(path_len + sizeof(suffix));
+    if (!tmp_path) return DSC_ERROR_MEMORY;
+    memcpy(tmp_path, path, path_len);
+    memcpy(tmp_path + path_len, suffix, sizeof(suffix));
+
+    int fd = mkstemp(tmp_path);
+    if (fd < 0) {
+        dsc_free(tmp_path);
+        return DSC_ERROR_IO;
+    }
+
+    bool ok = write_file(fd, header, sections) &&
+              rename(tmp_path, path) == 0;
+    if (!ok) remove(tmp_path);
+
+    dsc_free(tmp_path);
+    return ok ? DSC_ERROR_OK : DSC_ERROR_IO;
+}
+
+static bool valid_header(DSCTableFileHeader const *header,
+                         char const magic[8], uint64_t file_size) {
+    if (memcmp(header->magic, magic, sizeof(header->magic)) != 0 ||
+        header->version != DSC_TABLE_FILE_VERSION ||
+        header->byte_order != DSC_TABLE_FILE_BYTE_ORDER ||
+        header->hash_bits != sizeof(size_t) * 8 ||
+        header->group_width != DSC_GROUP_WIDTH ||
+        (header->flags & ~DSC_TABLE_FILE_BYTE_HASH) != 0 ||
+        header->file_size != file_size) {
+        return false;
+    }
+
+    if (header->probe_mode != DSC_PROBE_GROUP &&
+        header->probe_mode != DSC_PROBE_ROBIN_HOOD) {
+        return false;
+    }
+
+    // Group probing loads whole groups, so the table must span at least
+    // one of them.
+    uint64_t capacity = header->capacity;
+    if (capacity < DSC_GROUP_WIDTH || (capacity & (capacity - 1)) != 0 ||
+        header->size > capacity ||
+        header->growth_left > capacity || header->key_size == 0) {
+        return false;
+    }
+
+    if (header->key_size > UINT64_MAX / capacity ||
+        (header->value_size != 0 &&
+         header->value_size > UINT64_MAX / capacity)) {
+        return false;
+    }
+
+    uint64_t expected[DSC_TABLE_SECTION_COUNT] = {
+        [DSC_TABLE_SECTION_KEYS] = capacity * header->key_size,
+        [DSC_TABLE_SECTION_VALUES] = capacity * header->value_size,
+        [DSC_TABLE_SECTION_CTRL] = capacity,
+        [DSC_TABLE_SECTION_DIST] =
+            header->probe_mode == DSC_PROBE_ROBIN_HOOD ? capacity : 0,
+    };
+
+    for (int i = 0; i < DSC_TABLE_SECTION_COUNT; ++i) {
+        uint64_t offset = header->offsets[i];
+        uint64_t length = header->lengths[i];
+        if (length != expected[i]) return false;
+        if (length == 0) continue;
+        if (offset < sizeof(DSCTableFileHeader) ||
+            offset % DSC_TABLE_FILE_ALIGNMENT != 0 || offset > file_size ||
+            length > file_size - offset) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+DSCError dsc_table_file_map(char const *path, char const magic[8],
+                            void **mapping, size_t *mapping_size) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return DSC_ERROR_IO;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return DSC_ERROR_IO;
+    }
+
+    // Files larger than the address space cannot be mapped; every array
+    // then also fits in size_t.
+    uint64_t file_size = (uint64_t)st.st_size;
+    if (file_size < sizeof(DSCTableFileHeader) ||
+        file_size != (uint64_t)(size_t)file_size) {
+        close(fd);
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    size_t size = (size_t)file_size;
+    void *data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return DSC_ERROR_IO;
+
+    if (!valid_header(data, magic, size)) {
+        munmap(data, size);
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    *mapping = data;
+    *mapping_size = size;
+    return DSC_ERROR_OK;
+}
+
+void dsc_table_file_unmap(void *mapping, size_t mapping_size) {
+    munmap(mapping, mapping_size);
+}
+
+#else
+
+DSCError dsc_table_file_save(char const *path, DSCTableFileHeader *header,
+                             void const *const sections[]) {
+    (void)path;
+    (void)header;
+    (void)sections;
+    return DSC_ERROR_IO;
+}
+
+DSCError dsc_table_file_map(char const *path, char const magic[8],
+                            void **mapping, size_t *mapping_size) {
+    (void)path;
+    (void)magic;
+    (void)mapping;
+    (void)mapping_size;
+    return DSC_ERROR_IO;
+}
+
+void dsc_table_file_unmap(void *mapping, size_t mapping_size) {
+    (void)mapping;
+    (void)mapping_size;
+}
+
+#endif  // DSC_TABLE_FILE_SUPPORTED
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/// @file table_file.h
+/// @brief On-disk layout shared by the memory-mapped unordered containers
+///
+/// A table file is a fixed header followed by the raw table arrays, each
+/// starting at a 64-byte aligned offset from the beginning of the file.
+/// Offsets rather than pointers make the file relocatable, so it can be
+/// mapped at any address and shared read-only between processes.
+///
+/// The header records everything the probing code depends on: the hash
+/// width, the control-byte group width, the probing mode and the byte
+/// order. Files written by an incompatible build are rejected on open
+/// instead of being misread.
+
+#ifndef DSC_TABLE_FILE_H_
+#define DSC_TABLE_FILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "libdsc/common.h"
+
+/// @brief Incremented on any incompatible change to the layout or hashing
+#define DSC_TABLE_FILE_VERSION 2
+
+/// @brief Alignment of every array in the file
+#define DSC_TABLE_FILE_ALIGNMENT 64
+
+/// @brief Set when the table hashed raw key bytes instead of a hash_fn
+#define DSC_TABLE_FILE_BYTE_HASH 0x1u
+
+/// @brief Arrays stored in a table file, in file order
+enum {
+    DSC_TABLE_SECTION_KEYS,    ///< Keys, or set elements
+    DSC_TABLE_SECTION_VALUES,  ///< Values (empty for sets)
+    DSC_TABLE_SECTION_CTRL,    ///< Control bytes
+    DSC_TABLE_SECTION_DIST,    ///< Robin Hood distances (empty otherwise)
+    DSC_TABLE_SECTION_COUNT
+};
+
+/// @brief Header at offset 0 of a table file
+typedef struct {
+    char magic[8];             ///< Identifies the container type
+    uint32_t version;          ///< DSC_TABLE_FILE_VERSION
+    uint32_t byte_order;       ///< 0x01020304 in the writer's byte order
+    uint32_t hash_bits;        ///< Width of size_t hashes
+    uint32_t group_width;      ///< DSC_GROUP_WIDTH of the writer
+    uint32_t probe_mode;       ///< DSCProbeMode of the table
+    uint32_t flags;            ///< DSC_TABLE_FILE_* flags
+    uint64_t key_size;         ///< Size of each key or element
+    uint64_t value_size;       ///< Size of each value (0 for sets)
+    uint64_t size;             ///< Number of entries
+    uint64_t capacity;         ///< Number of slots
+    uint64_t growth_left;      ///< Inserts left before the table grows
+    uint64_t file_size;        ///< Total file size in bytes
+    uint64_t offsets[DSC_TABLE_SECTION_COUNT];  ///< Array offsets
+    uint64_t lengths[DSC_TABLE_SECTION_COUNT];  ///< Array sizes in bytes
+} DSCTableFileHeader;
+
+/// @brief Writes a table file
+///
+/// Fills in the layout fields of header from its lengths, then writes the
+/// header and arrays to a uniquely named temporary file in the same
+/// directory. The file is synced and then renamed over path, so processes
+/// that still map an older version of the file are unaffected and
+/// concurrent saves to the same path each replace it whole.
+///
+/// @param path Destination path
+/// @param header Header with magic, probe_mode, flags, sizes and lengths set
+/// @param sections Array data, one pointer per section
+/// @return DSC_ERROR_OK on success, DSC_ERROR_IO if writing failed
+DSCError dsc_table_file_save(char const *path, DSCTableFileHeader *header,
+                             void const *const sections[]);
+
+/// @brief Maps a table file read-only and validates its header
+///
+/// Checks the magic, version and build compatibility fields, and that
+/// every array lies inside the file with the length implied by the
+/// capacity and entry sizes. Does not read the arrays, so it takes O(1)
+/// time regardless of the table size.
+///
+/// @param path Path of the file to map
+/// @param magic Expected magic bytes
+/// @param mapping Receives the start of the mapping, which is the header
+/// @param mapping_size Receives the size of the mapping
+/// @return DSC_ERROR_OK on success, error code on failure
+/// @retval DSC_ERROR_IO The file could not be opened or mapped
+/// @retval DSC_ERROR_INVALID_ARGUMENT The file is not a compatible table
+DSCError dsc_table_file_map(char const *path, char const magic[8],
+                            void **mapping, size_t *mapping_size);
+
+/// @brief Releases a mapping returned by dsc_table_file_map()
+void dsc_table_file_unmap(void *mapping, size_t mapping_size);
+
+#endif  // DSC_TABLE_FILE_H_
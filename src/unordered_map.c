@@ -6,118 +6,450 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "libdsc/hash_table.h"
+#include "table_file.h"
+
 #define DSC_UNORDERED_MAP_INITIAL_CAPACITY 16
-#define LOAD_FACTOR 0.75f
 
-static size_t find_slot(DSCUnorderedMap const *map, void const *key,
-                        size_t hash) {
-    size_t mask = map->capacity - 1;
-    size_t idx = hash & mask;
+// Old-table slots migrated per operation during an incremental rehash.
+// A multiple of DSC_SCAN_WIDTH, so each step scans whole bitmap windows.
+#define DSC_UNORDERED_MAP_REHASH_STEP 128
 
-    while (map->hashes[idx] != 0) {
-        size_t key_offset;
+static char const file_magic[8] = "DSCUMAP";
 
-        if (!dsc_safe_multiply(idx, map->key_size, &key_offset)) {
-            // This should not happen in practice as we control capacity
-            return idx;
+static void *key_at(DSCUnorderedMap const *map, size_t idx) {
+    return (char *)map->keys + idx * map->key_size;
+}
+
+static void *value_at(DSCUnorderedMap const *map, size_t idx) {
+    return (char *)map->values + idx * map->value_size;
+}
+
+// Maps created without hash_fn and compare_fn hash and compare raw bytes.
+static size_t hash_key(DSCUnorderedMap const *map, void const *key) {
+    if (!map->hash_fn) {
+        return (size_t)dsc_hash_bytes(key, map->key_size,
+                                      DSC_HASH_DEFAULT_SEED);
+    }
+    return dsc_hash_finalize(map->hash_fn(key));
+}
+
+static bool keys_equal(DSCUnorderedMap const *map, void const *a,
+                       void const *b) {
+    if (!map->compare_fn) {
+        return memcmp(a, b, map->key_size) == 0;
+    }
+    return map->compare_fn(a, b) == 0;
+}
+
+// Returns the slot holding key, or map->capacity if the key is absent.
+static size_t find_slot_group(DSCUnorderedMap const *map, void const *key,
+                              size_t hash) {
+    size_t group_mask = map->capacity / DSC_GROUP_WIDTH - 1;
+    size_t group = dsc_hash_h1(hash) & group_mask;
+    int8_t h2 = dsc_hash_h2(hash);
+
+    // Triangular probing visits every group once when the group count is a
+    // power of two.
+    for (size_t step = 1; step <= group_mask + 1; ++step) {
+        int8_t const *ctrl = map->ctrl + group * DSC_GROUP_WIDTH;
+
+        DSCGroupMask match = dsc_group_match(ctrl, h2);
+        while (match) {
+            size_t idx = group * DSC_GROUP_WIDTH + dsc_mask_index(match);
+            if (keys_equal(map, key_at(map, idx), key)) {
+                return idx;
+            }
+            match = dsc_mask_next(match);
+        }
+
+        if (dsc_group_match_empty(ctrl)) {
+            break;
         }
 
-        if (map->hashes[idx] == hash &&
-            map->compare_fn((char *)map->keys + key_offset, key) == 0) {
+        group = (group + step) & group_mask;
+    }
+
+    return map->capacity;
+}
+
+// Robin Hood runs are ordered by home slot, so a miss ends at the first
+// slot whose resident is closer to its home than the key would be.
+static size_t find_slot_robin_hood(DSCUnorderedMap const *map,
+                                   void const *key, size_t hash) {
+    size_t mask = map->capacity - 1;
+    size_t idx = dsc_hash_h1(hash) & mask;
+    int8_t h2 = dsc_hash_h2(hash);
+
+    for (size_t dist = 0;; ++dist) {
+        int8_t ctrl = map->ctrl[idx];
+        if (ctrl == DSC_CTRL_EMPTY || map->dist[idx] < dist) {
+            break;
+        }
+        if (ctrl == h2 && keys_equal(map, key_at(map, idx), key)) {
             return idx;
         }
+        idx = (idx + 1) & mask;
+    }
+
+    return map->capacity;
+}
+
+static size_t find_slot(DSCUnorderedMap const *map, void const *key,
+                        size_t hash) {
+    if (map->probe_mode == DSC_PROBE_ROBIN_HOOD) {
+        return find_slot_robin_hood(map, key, hash);
+    }
+    return find_slot_group(map, key, hash);
+}
 
+
+// Moves the element in slot from into the free slot to, which is delta
+// slots further from its home.
+static void move_slot(DSCUnorderedMap *map, size_t to, size_t from,
+                      int delta) {
+    memcpy(key_at(map, to), key_at(map, from), map->key_size);
+    memcpy(value_at(map, to), value_at(map, from), map->value_size);
+    map->ctrl[to] = map->ctrl[from];
+    map->dist[to] = (uint8_t)(map->dist[from] + delta);
+}
+
+// Claims the Robin Hood position of an absent key: the first slot whose
+// resident is closer to its home, after shifting the rest of the run one
+// slot along. Keeping runs ordered by home slot is equivalent to the usual
+// swap-and-carry insertion but moves every element at most once. Returns
+// map->capacity if a probe distance would exceed DSC_RH_MAX_DIST.
+static size_t claim_robin_hood(DSCUnorderedMap *map, size_t hash) {
+    size_t mask = map->capacity - 1;
+    size_t idx = dsc_hash_h1(hash) & mask;
+    size_t dist = 0;
+
+    while (map->ctrl[idx] != DSC_CTRL_EMPTY && map->dist[idx] >= dist) {
         idx = (idx + 1) & mask;
+        ++dist;
+    }
+    if (dist > DSC_RH_MAX_DIST) return map->capacity;
+
+    size_t end = idx;
+    while (map->ctrl[end] != DSC_CTRL_EMPTY) {
+        if (map->dist[end] == DSC_RH_MAX_DIST) return map->capacity;
+        end = (end + 1) & mask;
     }
 
+    for (size_t to = end; to != idx;) {
+        size_t from = (to - 1) & mask;
+        move_slot(map, to, from, 1);
+        to = from;
+    }
+    --(map->growth_left);
+
+    map->ctrl[idx] = dsc_hash_h2(hash);
+    map->dist[idx] = (uint8_t)dist;
+
     return idx;
 }
 
-static DSCError rehash(DSCUnorderedMap *map) {
-    size_t old_capacity = map->capacity;
-    void *old_keys = map->keys;
-    void *old_values = map->values;
-    size_t *old_hashes = map->hashes;
+// Backward-shift deletion: every element of the run after idx moves one
+// slot closer to its home, up to the first empty slot or element already
+// in its home slot. Only the stored distances are consulted, so no key is
+// hashed or compared, each follower moves once, and Robin Hood tables
+// never hold tombstones.
+static void erase_robin_hood(DSCUnorderedMap *map, size_t idx) {
+    size_t mask = map->capacity - 1;
+    size_t next = (idx + 1) & mask;
+
+    while (dsc_ctrl_is_full(map->ctrl[next]) && map->dist[next] > 0) {
+        move_slot(map, idx, next, -1);
+        idx = next;
+        next = (next + 1) & mask;
+    }
+
+    map->ctrl[idx] = DSC_CTRL_EMPTY;
+    ++(map->growth_left);
+}
 
-    size_t new_capacity;
-    if (!dsc_safe_grow_capacity(map->capacity, &new_capacity)) {
-        return DSC_ERROR_OVERFLOW;
+// Claims a free slot for a key that is not in the map. The caller stores
+// the key and accounts for it in map->size. Returns map->capacity if a
+// Robin Hood probe distance would overflow.
+static size_t claim_slot(DSCUnorderedMap *map, size_t hash) {
+    if (map->probe_mode == DSC_PROBE_ROBIN_HOOD) {
+        return claim_robin_hood(map, hash);
     }
-    map->capacity = new_capacity;
 
-    size_t keys_size, values_size, hashes_size;
-    if (!dsc_safe_multiply(map->capacity, map->key_size, &keys_size) ||
-        !dsc_safe_multiply(map->capacity, map->value_size, &values_size) ||
-        !dsc_safe_multiply(map->capacity, sizeof(size_t), &hashes_size)) {
-        map->capacity = old_capacity;
-        return DSC_ERROR_OVERFLOW;
+    size_t idx = dsc_ctrl_find_insert_slot(map->ctrl, map->capacity, hash);
+    // Reusing a deleted slot does not consume growth.
+    if (map->ctrl[idx] == DSC_CTRL_EMPTY) {
+        --(map->growth_left);
     }
+    map->ctrl[idx] = dsc_hash_h2(hash);
 
-    map->keys = dsc_malloc(keys_size);
-    map->values = dsc_malloc(values_size);
-    map->hashes = dsc_malloc(hashes_size);
+    return idx;
+}
+
+// Moves the pair in slot i of table src into a newly claimed slot of map.
+// Returns false if a Robin Hood probe distance would overflow.
+static bool move_entry(DSCUnorderedMap *map, DSCUnorderedMap const *src,
+                       size_t i) {
+    size_t idx = claim_slot(map, hash_key(src, key_at(src, i)));
+    if (idx == map->capacity) return false;
+
+    memcpy(key_at(map, idx), key_at(src, i), map->key_size);
+    memcpy(value_at(map, idx), value_at(src, i), map->value_size);
 
-    if (!map->keys || !map->values || !map->hashes) {
-        dsc_free(map->keys);
-        dsc_free(map->values);
-        dsc_free(map->hashes);
-        map->keys = old_keys;
-        map->values = old_values;
-        map->hashes = old_hashes;
-        map->capacity = old_capacity;
+    return true;
+}
+
+// Replaces the arrays of map with empty ones of the given capacity and
+// mode, leaving map untouched on failure.
+static DSCError alloc_table(DSCUnorderedMap *map, size_t capacity,
+                            DSCProbeMode mode) {
+    size_t keys_size, values_size;
+    if (!dsc_safe_multiply(capacity, map->key_size, &keys_size) ||
+        !dsc_safe_multiply(capacity, map->value_size, &values_size)) {
+        return DSC_ERROR_OVERFLOW;
+    }
+
+    DSCAllocator const *alloc = &map->allocator;
+    void *keys = dsc_allocate(alloc, keys_size);
+    void *values = dsc_allocate(alloc, values_size);
+    int8_t *ctrl = dsc_allocate(alloc, capacity);
+    uint8_t *dist =
+        mode == DSC_PROBE_ROBIN_HOOD ? dsc_allocate(alloc, capacity) : NULL;
+
+    if (!keys || !values || !ctrl || (mode == DSC_PROBE_ROBIN_HOOD && !dist)) {
+        dsc_deallocate(alloc, keys, keys_size);
+        dsc_deallocate(alloc, values, values_size);
+        dsc_deallocate(alloc, ctrl, capacity);
+        dsc_deallocate(alloc, dist, capacity);
         return DSC_ERROR_MEMORY;
     }
 
-    // Initialize memory to zero
-    memset(map->keys, 0, keys_size);
-    memset(map->values, 0, values_size);
-    memset(map->hashes, 0, hashes_size);
-
-    for (size_t i = 0; i < old_capacity; ++i) {
-        if (old_hashes[i] != 0) {
-            size_t old_key_offset, new_key_offset, old_value_offset,
-                new_value_offset;
-            if (!dsc_safe_multiply(i, map->key_size, &old_key_offset) ||
-                !dsc_safe_multiply(i, map->value_size, &old_value_offset)) {
-                // Cleanup and return error
-                dsc_free(map->keys);
-                dsc_free(map->values);
-                dsc_free(map->hashes);
-                map->keys = old_keys;
-                map->values = old_values;
-                map->hashes = old_hashes;
-                map->capacity = old_capacity;
-                return DSC_ERROR_OVERFLOW;
-            }
+    memset(ctrl, DSC_CTRL_EMPTY, capacity);
+    map->keys = keys;
+    map->values = values;
+    map->ctrl = ctrl;
+    map->dist = dist;
+    map->capacity = capacity;
+    map->probe_mode = mode;
+    map->growth_left = dsc_table_growth(mode, capacity);
 
-            size_t new_idx = find_slot(map, (char *)old_keys + old_key_offset,
-                                       old_hashes[i]);
-
-            if (!dsc_safe_multiply(new_idx, map->key_size, &new_key_offset) ||
-                !dsc_safe_multiply(new_idx, map->value_size,
-                                   &new_value_offset)) {
-                // Cleanup and return error
-                dsc_free(map->keys);
-                dsc_free(map->values);
-                dsc_free(map->hashes);
-                map->keys = old_keys;
-                map->values = old_values;
-                map->hashes = old_hashes;
-                map->capacity = old_capacity;
-                return DSC_ERROR_OVERFLOW;
-            }
+    return DSC_ERROR_OK;
+}
+
+static void free_table(DSCUnorderedMap *table) {
+    DSCAllocator const *alloc = &table->allocator;
+    dsc_deallocate(alloc, table->keys, table->capacity * table->key_size);
+    dsc_deallocate(alloc, table->values, table->capacity * table->value_size);
+    dsc_deallocate(alloc, table->ctrl, table->capacity);
+    dsc_deallocate(alloc, table->dist, table->capacity);
+}
+
+static void free_old_table(DSCUnorderedMap *map) {
+    if (!map->old_table) return;
+    free_table(map->old_table);
+    dsc_deallocate(&map->allocator, map->old_table, sizeof(DSCUnorderedMap));
+    map->old_table = NULL;
+}
+
+// Moves every pair of src into map, skipping slots before start.
+static bool move_entries(DSCUnorderedMap *map, DSCUnorderedMap const *src,
+                         size_t start) {
+    // Keys are unique, so migration only needs a free slot per element.
+    for (size_t i = dsc_ctrl_next_full(src->ctrl, src->capacity, start);
+         i < src->capacity;
+         i = dsc_ctrl_next_full(src->ctrl, src->capacity, i + 1)) {
+        if (!move_entry(map, src, i)) return false;
+    }
+    return true;
+}
+
+static DSCError fall_back_to_groups(DSCUnorderedMap *map);
+
+// Rebuilds the map in one step, absorbing the table of a pending
+// incremental rehash.
+static DSCError rehash(DSCUnorderedMap *map, size_t new_capacity,
+                       DSCProbeMode mode) {
+    DSCUnorderedMap old = *map;
 
-            memcpy((char *)map->keys + new_key_offset,
-                   (char *)old_keys + old_key_offset, map->key_size);
-            memcpy((char *)map->values + new_value_offset,
-                   (char *)old_values + old_value_offset, map->value_size);
-            map->hashes[new_idx] = old_hashes[i];
+    DSCError err = alloc_table(map, new_capacity, mode);
+    if (err != DSC_ERROR_OK) return err;
+    map->old_table = NULL;
+
+    if (!move_entries(map, &old, 0) ||
+        (old.old_table &&
+         !move_entries(map, old.old_table, old.rehash_pos))) {
+        free_table(map);
+        *map = old;
+        return fall_back_to_groups(map);
+    }
+
+    free_table(&old);
+    free_old_table(&old);
+
+    return DSC_ERROR_OK;
+}
+
+// Rebuilds a Robin Hood table whose probe distances no longer fit in a
+// byte with group probing, leaving room for one more element. Only a
+// degenerate hash function produces runs that long.
+static DSCError fall_back_to_groups(DSCUnorderedMap *map) {
+    size_t new_capacity = dsc_capacity_for(
+        map->size + 1, DSC_UNORDERED_MAP_INITIAL_CAPACITY, DSC_PROBE_GROUP);
+    if (new_capacity == 0) return DSC_ERROR_OVERFLOW;
+
+    return rehash(map, new_capacity, DSC_PROBE_GROUP);
+}
+
+// Moves the pairs in the next n slots of the old table into the current
+// one and frees the old table once it has been drained.
+static DSCError migrate(DSCUnorderedMap *map, size_t n) {
+    DSCUnorderedMap *old = map->old_table;
+    size_t end = old->capacity - map->rehash_pos > n ? map->rehash_pos + n
+                                                     : old->capacity;
+
+    for (size_t i = dsc_ctrl_next_full(old->ctrl, end, map->rehash_pos);
+         i < end; i = dsc_ctrl_next_full(old->ctrl, end, i + 1)) {
+        if (!move_entry(map, old, i)) return fall_back_to_groups(map);
+
+        // A tombstone keeps the probe sequences (and Robin Hood distances)
+        // of the pairs still waiting in the old table intact.
+        old->ctrl[i] = DSC_CTRL_DELETED;
+        --(old->size);
+    }
+
+    map->rehash_pos = end;
+    if (end == old->capacity || old->size == 0) {
+        free_old_table(map);
+    }
+
+    return DSC_ERROR_OK;
+}
+
+// Finishes a pending incremental rehash in one step.
+static DSCError finish_migration(DSCUnorderedMap *map) {
+    if (!map->old_table) return DSC_ERROR_OK;
+    return migrate(map, map->old_table->capacity);
+}
+
+// Moves the current table aside and starts filling an empty one; the old
+// pairs are migrated a few slots at a time by later operations.
+static DSCError begin_migration(DSCUnorderedMap *map, size_t new_capacity) {
+    DSCUnorderedMap *old =
+        dsc_allocate(&map->allocator, sizeof(DSCUnorderedMap));
+    if (!old) return DSC_ERROR_MEMORY;
+
+    *old = *map;
+    DSCError err = alloc_table(map, new_capacity, map->probe_mode);
+    if (err != DSC_ERROR_OK) {
+        dsc_deallocate(&map->allocator, old, sizeof(DSCUnorderedMap));
+        return err;
+    }
+
+    map->old_table = old;
+    map->rehash_pos = 0;
+
+    return DSC_ERROR_OK;
+}
+
+// Makes room for one more element, either by doubling the table or, when
+// most of the used-up growth is deleted slots, by rebuilding it in place.
+static DSCError grow(DSCUnorderedMap *map) {
+    // The new table has room for every old pair plus the inserts made
+    // while migrating, so this only triggers after heavy tombstone churn.
+    DSCError err = finish_migration(map);
+    if (err != DSC_ERROR_OK || map->growth_left > 0) return err;
+
+    size_t new_capacity = map->capacity;
+
+    if (map->size >= dsc_table_growth(map->probe_mode, map->capacity) / 2) {
+        if (!dsc_safe_grow_capacity(map->capacity, &new_capacity) ||
+            new_capacity == SIZE_MAX) {
+            return DSC_ERROR_OVERFLOW;
         }
     }
 
-    dsc_free(old_keys);
-    dsc_free(old_values);
-    dsc_free(old_hashes);
+    if (map->incremental_rehash) {
+        return begin_migration(map, new_capacity);
+    }
+    return rehash(map, new_capacity, map->probe_mode);
+}
+
+// Group tables only grow when the insert would use up an empty slot.
+// Robin Hood tables have no deleted slots, so every insert uses one up.
+static bool needs_growth(DSCUnorderedMap const *map, size_t hash) {
+    if (map->growth_left > 0) return false;
+    if (map->probe_mode == DSC_PROBE_ROBIN_HOOD) return true;
+
+    size_t idx = dsc_ctrl_find_insert_slot(map->ctrl, map->capacity, hash);
+    return map->ctrl[idx] == DSC_CTRL_EMPTY;
+}
+
+// Performs the bounded share of a pending incremental rehash that every
+// insert, find and erase pays for.
+static DSCError rehash_step(DSCUnorderedMap *map) {
+    if (!map->old_table) return DSC_ERROR_OK;
+    return migrate(map, DSC_UNORDERED_MAP_REHASH_STEP);
+}
+
+// Finds key in the current table or, while an incremental rehash is
+// pending, in the old one. Returns the table holding the key, or NULL.
+static DSCUnorderedMap *locate(DSCUnorderedMap *map, void const *key,
+                               size_t hash, size_t *idx) {
+    *idx = find_slot(map, key, hash);
+    if (*idx != map->capacity) return map;
+
+    DSCUnorderedMap *old = map->old_table;
+    if (old) {
+        *idx = find_slot(old, key, hash);
+        if (*idx != old->capacity) return old;
+    }
+
+    return NULL;
+}
+
+// Starts loading the control bytes and first key that a lookup of hash
+// reads first, so that batched lookups overlap their cache misses.
+static void prefetch_home(DSCUnorderedMap const *map, size_t hash) {
+    size_t idx;
+    if (map->probe_mode == DSC_PROBE_ROBIN_HOOD) {
+        idx = dsc_hash_h1(hash) & (map->capacity - 1);
+        dsc_prefetch(map->dist + idx);
+    } else {
+        size_t group_mask = map->capacity / DSC_GROUP_WIDTH - 1;
+        idx = (dsc_hash_h1(hash) & group_mask) * DSC_GROUP_WIDTH;
+    }
+    dsc_prefetch(map->ctrl + idx);
+    dsc_prefetch(key_at(map, idx));
+}
+
+// Finds key, or claims and counts a slot for it, with a single hash.
+// Reports the table and slot; the caller stores the key into a new slot.
+static DSCError emplace(DSCUnorderedMap *map, void const *key, size_t hash,
+                        DSCUnorderedMap **table, size_t *idx,
+                        bool *inserted) {
+    if (map->mapping) return DSC_ERROR_READ_ONLY;
+
+    DSCError err = rehash_step(map);
+    if (err != DSC_ERROR_OK) return err;
+
+    *table = locate(map, key, hash, idx);
+    *inserted = !*table;
+    if (*table) return DSC_ERROR_OK;
+
+    if (needs_growth(map, hash)) {
+        err = grow(map);
+        if (err != DSC_ERROR_OK) return err;
+    }
+
+    *idx = claim_slot(map, hash);
+    if (*idx == map->capacity) {
+        err = fall_back_to_groups(map);
+        if (err != DSC_ERROR_OK) return err;
+        *idx = claim_slot(map, hash);
+    }
+    ++(map->size);
+    *table = map;
+
     return DSC_ERROR_OK;
 }
 
@@ -125,55 +457,105 @@ DSCUnorderedMap *unordered_map_create(size_t key_size, size_t value_size,
                                         size_t (*hash_fn)(void const *),
                                         int (*compare_fn)(void const *,
                                                           void const *)) {
+    return unordered_map_create_with_allocator(key_size, value_size, hash_fn,
+                                               compare_fn, NULL);
+}
+
+DSCUnorderedMap *unordered_map_create_with_allocator(
+    size_t key_size, size_t value_size, size_t (*hash_fn)(void const *),
+    int (*compare_fn)(void const *, void const *),
+    DSCAllocator const *allocator) {
     // Input validation
-    if (key_size == 0 || value_size == 0 || !hash_fn || !compare_fn) {
+    if (key_size == 0 || value_size == 0 || !hash_fn != !compare_fn ||
+        !dsc_allocator_valid(allocator)) {
         return NULL;
     }
 
-    // Check for potential overflow in initial allocation
-    size_t keys_size, values_size, hashes_size;
-    if (!dsc_safe_multiply(DSC_UNORDERED_MAP_INITIAL_CAPACITY, key_size, &keys_size) ||
-        !dsc_safe_multiply(DSC_UNORDERED_MAP_INITIAL_CAPACITY, value_size, &values_size) ||
-        !dsc_safe_multiply(DSC_UNORDERED_MAP_INITIAL_CAPACITY, sizeof(size_t), &hashes_size)) {
-        return NULL;  // Overflow would occur
-    }
-
-    DSCUnorderedMap *map = dsc_malloc(sizeof(DSCUnorderedMap));
+    DSCAllocator alloc = dsc_allocator_or_default(allocator);
+    DSCUnorderedMap *map = dsc_allocate(&alloc, sizeof(DSCUnorderedMap));
     if (!map) return NULL;
 
-    map->capacity = DSC_UNORDERED_MAP_INITIAL_CAPACITY;
     map->size = 0;
+    map->old_table = NULL;
+    map->rehash_pos = 0;
+    map->incremental_rehash = false;
+    map->mapping = NULL;
+    map->mapping_size = 0;
     map->key_size = key_size;
     map->value_size = value_size;
     map->hash_fn = hash_fn;
     map->compare_fn = compare_fn;
+    map->allocator = alloc;
 
-    map->keys = dsc_malloc(keys_size);
-    map->values = dsc_malloc(values_size);
-    map->hashes = dsc_malloc(hashes_size);
-
-    if (!map->keys || !map->values || !map->hashes) {
-        dsc_free(map->keys);
-        dsc_free(map->values);
-        dsc_free(map->hashes);
-        dsc_free(map);
+    if (alloc_table(map, DSC_UNORDERED_MAP_INITIAL_CAPACITY,
+                    DSC_PROBE_GROUP) != DSC_ERROR_OK) {
+        dsc_deallocate(&alloc, map, sizeof(DSCUnorderedMap));
         return NULL;
     }
 
-    // Initialize memory to zero
-    memset(map->keys, 0, keys_size);
-    memset(map->values, 0, values_size);
-    memset(map->hashes, 0, hashes_size);
-
     return map;
 }
 
 void unordered_map_destroy(DSCUnorderedMap *map) {
     if (!map) return;
-    dsc_free(map->keys);
-    dsc_free(map->values);
-    dsc_free(map->hashes);
-    dsc_free(map);
+
+    DSCAllocator alloc = map->allocator;
+    if (map->mapping) {
+        dsc_table_file_unmap(map->mapping, map->mapping_size);
+    } else {
+        free_old_table(map);
+        free_table(map);
+    }
+    dsc_deallocate(&alloc, map, sizeof(DSCUnorderedMap));
+}
+
+// Copies src's arrays into dst, which must already hold src's fields.
+static DSCError copy_table(DSCUnorderedMap *dst, DSCUnorderedMap const *src) {
+    DSCError err = alloc_table(dst, src->capacity, src->probe_mode);
+    if (err != DSC_ERROR_OK) return err;
+
+    memcpy(dst->keys, src->keys, src->capacity * src->key_size);
+    memcpy(dst->values, src->values, src->capacity * src->value_size);
+    memcpy(dst->ctrl, src->ctrl, src->capacity);
+    if (src->dist) memcpy(dst->dist, src->dist, src->capacity);
+    dst->growth_left = src->growth_left;
+
+    return DSC_ERROR_OK;
+}
+
+DSCUnorderedMap *unordered_map_clone(DSCUnorderedMap const *map) {
+    if (!map) return NULL;
+
+    DSCUnorderedMap *clone =
+        dsc_allocate(&map->allocator, sizeof(DSCUnorderedMap));
+    if (!clone) return NULL;
+
+    *clone = *map;
+    clone->old_table = NULL;
+    clone->mapping = NULL;
+    clone->mapping_size = 0;
+    if (copy_table(clone, map) != DSC_ERROR_OK) {
+        dsc_deallocate(&map->allocator, clone, sizeof(DSCUnorderedMap));
+        return NULL;
+    }
+
+    if (map->old_table) {
+        DSCUnorderedMap *old =
+            dsc_allocate(&map->allocator, sizeof(DSCUnorderedMap));
+        if (!old) {
+            unordered_map_destroy(clone);
+            return NULL;
+        }
+        *old = *map->old_table;
+        if (copy_table(old, map->old_table) != DSC_ERROR_OK) {
+            dsc_deallocate(&map->allocator, old, sizeof(DSCUnorderedMap));
+            unordered_map_destroy(clone);
+            return NULL;
+        }
+        clone->old_table = old;
+    }
+
+    return clone;
 }
 
 size_t unordered_map_size(DSCUnorderedMap const *map) {
@@ -188,179 +570,313 @@ DSCError unordered_map_insert(DSCUnorderedMap *map, void const *key,
                                void const *value) {
     if (!map || !key || !value) return DSC_ERROR_INVALID_ARGUMENT;
 
-    if ((float)map->size / map->capacity >= LOAD_FACTOR) {
-        DSCError err = rehash(map);
-        if (err != DSC_ERROR_OK) return err;
-    }
+    DSCUnorderedMap *table;
+    size_t idx;
+    bool inserted;
+    DSCError err =
+        emplace(map, key, hash_key(map, key), &table, &idx, &inserted);
+    if (err != DSC_ERROR_OK) return err;
 
-    size_t hash = map->hash_fn(key);
-    size_t idx = find_slot(map, key, hash);
+    memcpy(key_at(table, idx), key, map->key_size);
+    memcpy(value_at(table, idx), value, map->value_size);
 
-    if (map->hashes[idx] == 0) {
-        ++(map->size);
-    }
+    return DSC_ERROR_OK;
+}
 
-    size_t key_offset, value_offset;
-    if (!dsc_safe_multiply(idx, map->key_size, &key_offset) ||
-        !dsc_safe_multiply(idx, map->value_size, &value_offset)) {
-        return DSC_ERROR_OVERFLOW;
+size_t unordered_map_hash(DSCUnorderedMap const *map, void const *key) {
+    if (!map || !key) return 0;
+    return hash_key(map, key);
+}
+
+void *unordered_map_try_emplace(DSCUnorderedMap *map, void const *key,
+                                bool *inserted) {
+    if (!map || !key) return NULL;
+    return unordered_map_try_emplace_hashed(map, key, hash_key(map, key),
+                                            inserted);
+}
+
+void *unordered_map_try_emplace_hashed(DSCUnorderedMap *map, void const *key,
+                                       size_t hash, bool *inserted) {
+    if (!map || !key) return NULL;
+
+    DSCUnorderedMap *table;
+    size_t idx;
+    bool is_new;
+    if (emplace(map, key, hash, &table, &idx, &is_new) != DSC_ERROR_OK) {
+        return NULL;
     }
 
-    memcpy((char *)map->keys + key_offset, key, map->key_size);
-    memcpy((char *)map->values + value_offset, value, map->value_size);
-    map->hashes[idx] = hash;
+    if (is_new) {
+        memcpy(key_at(table, idx), key, map->key_size);
+        memset(value_at(table, idx), 0, map->value_size);
+    }
+    if (inserted) *inserted = is_new;
 
-    return DSC_ERROR_OK;
+    return value_at(table, idx);
 }
 
 void *unordered_map_find(DSCUnorderedMap *map, void const *key) {
     if (!map || !key) return NULL;
+    return unordered_map_find_hashed(map, key, hash_key(map, key));
+}
 
-    size_t hash = map->hash_fn(key);
-    size_t idx = find_slot(map, key, hash);
+void *unordered_map_find_hashed(DSCUnorderedMap *map, void const *key,
+                                size_t hash) {
+    if (!map || !key) return NULL;
 
-    if (map->hashes[idx] == 0) return NULL;
+    // A failed step leaves both tables intact, so the lookup still works.
+    (void)rehash_step(map);
 
-    size_t value_offset;
-    if (!dsc_safe_multiply(idx, map->value_size, &value_offset)) {
-        return NULL;  // Overflow error
-    }
+    size_t idx;
+    DSCUnorderedMap *table = locate(map, key, hash, &idx);
 
-    return (char *)map->values + value_offset;
+    return table ? value_at(table, idx) : NULL;
 }
 
-DSCError unordered_map_erase(DSCUnorderedMap *map, void const *key) {
-    if (!map || !key) return DSC_ERROR_INVALID_ARGUMENT;
+size_t unordered_map_find_batch(DSCUnorderedMap *map, void const *keys,
+                                size_t n, void **values) {
+    if (!map || (n > 0 && (!keys || !values))) return 0;
 
-    size_t hash = map->hash_fn(key);
-    size_t idx = find_slot(map, key, hash);
+    (void)rehash_step(map);
 
-    if (map->hashes[idx] == 0) return DSC_ERROR_NOT_FOUND;
+    size_t hashes[DSC_LOOKUP_BATCH];
+    size_t found = 0;
 
-    map->hashes[idx] = 0;
-    map->size--;
+    for (size_t base = 0; base < n; base += DSC_LOOKUP_BATCH) {
+        size_t count = n - base < DSC_LOOKUP_BATCH ? n - base
+                                                   : DSC_LOOKUP_BATCH;
+        char const *batch = (char const *)keys + base * map->key_size;
 
-    // Rehash remaining elements
-    size_t mask = map->capacity - 1;
-    size_t next = (idx + 1) & mask;
+        // Hash everything first so the loads of all home groups are in
+        // flight before the first probe waits on one.
+        for (size_t i = 0; i < count; ++i) {
+            hashes[i] = hash_key(map, batch + i * map->key_size);
+            prefetch_home(map, hashes[i]);
+        }
 
-    while (map->hashes[next] != 0) {
-        size_t existing_hash = map->hashes[next];
-        size_t next_key_offset;
-        if (!dsc_safe_multiply(next, map->key_size, &next_key_offset)) {
-            return DSC_ERROR_OVERFLOW;
+        for (size_t i = 0; i < count; ++i) {
+            size_t idx;
+            DSCUnorderedMap *table =
+                locate(map, batch + i * map->key_size, hashes[i], &idx);
+            values[base + i] = table ? value_at(table, idx) : NULL;
+            found += table != NULL;
         }
+    }
 
-        size_t new_idx =
-            find_slot(map, (char *)map->keys + next_key_offset, existing_hash);
+    return found;
+}
 
-        if (new_idx != next) {
-            size_t new_key_offset, next_value_offset, new_value_offset;
-            if (!dsc_safe_multiply(new_idx, map->key_size, &new_key_offset) ||
-                !dsc_safe_multiply(next, map->value_size, &next_value_offset) ||
-                !dsc_safe_multiply(new_idx, map->value_size,
-                                   &new_value_offset)) {
-                return DSC_ERROR_OVERFLOW;
-            }
+DSCError unordered_map_erase(DSCUnorderedMap *map, void const *key) {
+    if (!map || !key) return DSC_ERROR_INVALID_ARGUMENT;
+    return unordered_map_erase_hashed(map, key, hash_key(map, key));
+}
 
-            memcpy((char *)map->keys + new_key_offset,
-                   (char *)map->keys + next_key_offset, map->key_size);
-            memcpy((char *)map->values + new_value_offset,
-                   (char *)map->values + next_value_offset, map->value_size);
-            map->hashes[new_idx] = existing_hash;
-            map->hashes[next] = 0;
-        }
+DSCError unordered_map_erase_hashed(DSCUnorderedMap *map, void const *key,
+                                    size_t hash) {
+    if (!map || !key) return DSC_ERROR_INVALID_ARGUMENT;
+    if (map->mapping) return DSC_ERROR_READ_ONLY;
 
-        next = (next + 1) & mask;
+    DSCError err = rehash_step(map);
+    if (err != DSC_ERROR_OK) return err;
+
+    size_t idx;
+    DSCUnorderedMap *table = locate(map, key, hash, &idx);
+
+    if (!table) return DSC_ERROR_NOT_FOUND;
+
+    // The old table is only drained, so a tombstone is all it needs.
+    if (table != map) {
+        table->ctrl[idx] = DSC_CTRL_DELETED;
+        --(table->size);
+        map->size--;
+        return DSC_ERROR_OK;
+    }
+
+    if (map->probe_mode == DSC_PROBE_ROBIN_HOOD) {
+        erase_robin_hood(map, idx);
+        map->size--;
+        return DSC_ERROR_OK;
+    }
+
+    if (dsc_ctrl_erase(map->ctrl, idx)) {
+        ++(map->growth_left);
     }
+    map->size--;
 
     return DSC_ERROR_OK;
 }
 
 void unordered_map_clear(DSCUnorderedMap *map) {
-    if (!map) return;
+    if (!map || map->mapping) return;
 
-    size_t hashes_size;
-    if (dsc_safe_multiply(map->capacity, sizeof(size_t), &hashes_size)) {
-        memset(map->hashes, 0, hashes_size);
-    }
+    free_old_table(map);
+    memset(map->ctrl, DSC_CTRL_EMPTY, map->capacity);
     map->size = 0;
+    map->growth_left = dsc_table_growth(map->probe_mode, map->capacity);
 }
 
 DSCError unordered_map_reserve(DSCUnorderedMap *map, size_t n) {
     if (!map) return DSC_ERROR_INVALID_ARGUMENT;
+    if (map->mapping) return DSC_ERROR_READ_ONLY;
 
-    if (n <= map->capacity) return DSC_ERROR_OK;
+    if (n <= dsc_table_growth(map->probe_mode, map->capacity)) {
+        return DSC_ERROR_OK;
+    }
 
-    size_t old_capacity = map->capacity;
-    map->capacity = n;
+    size_t new_capacity = dsc_capacity_for(
+        n, DSC_UNORDERED_MAP_INITIAL_CAPACITY, map->probe_mode);
+    if (new_capacity == 0) return DSC_ERROR_OVERFLOW;
 
-    size_t keys_size, values_size, hashes_size;
-    if (!dsc_safe_multiply(map->capacity, map->key_size, &keys_size) ||
-        !dsc_safe_multiply(map->capacity, map->value_size, &values_size) ||
-        !dsc_safe_multiply(map->capacity, sizeof(size_t), &hashes_size)) {
-        map->capacity = old_capacity;
-        return DSC_ERROR_OVERFLOW;
+    return rehash(map, new_capacity, map->probe_mode);
+}
+
+DSCError unordered_map_set_probe_mode(DSCUnorderedMap *map,
+                                      DSCProbeMode mode) {
+    if (!map ||
+        (mode != DSC_PROBE_GROUP && mode != DSC_PROBE_ROBIN_HOOD)) {
+        return DSC_ERROR_INVALID_ARGUMENT;
     }
 
-    void *new_keys = dsc_malloc(keys_size);
-    void *new_values = dsc_malloc(values_size);
-    size_t *new_hashes = dsc_malloc(hashes_size);
+    if (mode == map->probe_mode) return DSC_ERROR_OK;
+    if (map->mapping) return DSC_ERROR_READ_ONLY;
 
-    if (!new_keys || !new_values || !new_hashes) {
-        dsc_free(new_keys);
-        dsc_free(new_values);
-        dsc_free(new_hashes);
-        map->capacity = old_capacity;
-        return DSC_ERROR_MEMORY;
+    size_t new_capacity = dsc_capacity_for(
+        map->size, DSC_UNORDERED_MAP_INITIAL_CAPACITY, mode);
+    if (new_capacity == 0) return DSC_ERROR_OVERFLOW;
+    if (new_capacity < map->capacity) new_capacity = map->capacity;
+
+    return rehash(map, new_capacity, mode);
+}
+
+DSCProbeMode unordered_map_probe_mode(DSCUnorderedMap const *map) {
+    return map ? map->probe_mode : DSC_PROBE_GROUP;
+}
+
+DSCError unordered_map_set_incremental_rehash(DSCUnorderedMap *map,
+                                              bool enabled) {
+    if (!map) return DSC_ERROR_INVALID_ARGUMENT;
+    if (map->mapping && enabled) return DSC_ERROR_READ_ONLY;
+
+    map->incremental_rehash = enabled;
+
+    return enabled ? DSC_ERROR_OK : finish_migration(map);
+}
+
+bool unordered_map_next(DSCUnorderedMap const *map, size_t *cursor,
+                        void **key, void **value) {
+    if (!map || !cursor) return false;
+
+    // Cursors past the current table continue into the old one.
+    DSCUnorderedMap const *table = map;
+    size_t base = 0;
+    if (*cursor >= map->capacity) {
+        table = map->old_table;
+        base = map->capacity;
+        if (!table || *cursor - base >= table->capacity) return false;
     }
 
-    // Initialize memory to zero
-    memset(new_keys, 0, keys_size);
-    memset(new_values, 0, values_size);
-    memset(new_hashes, 0, hashes_size);
-
-    for (size_t i = 0; i < old_capacity; ++i) {
-        if (map->hashes[i] != 0) {
-            size_t old_key_offset, old_value_offset;
-            if (!dsc_safe_multiply(i, map->key_size, &old_key_offset) ||
-                !dsc_safe_multiply(i, map->value_size, &old_value_offset)) {
-                dsc_free(new_keys);
-                dsc_free(new_values);
-                dsc_free(new_hashes);
-                map->capacity = old_capacity;
-                return DSC_ERROR_OVERFLOW;
-            }
+    size_t idx =
+        dsc_ctrl_next_full(table->ctrl, table->capacity, *cursor - base);
+    if (idx == table->capacity) {
+        *cursor = base + table->capacity;
+        return table == map && unordered_map_next(map, cursor, key, value);
+    }
 
-            size_t new_idx = find_slot(map, (char *)map->keys + old_key_offset,
-                                       map->hashes[i]);
-
-            size_t new_key_offset, new_value_offset;
-            if (!dsc_safe_multiply(new_idx, map->key_size, &new_key_offset) ||
-                !dsc_safe_multiply(new_idx, map->value_size,
-                                   &new_value_offset)) {
-                dsc_free(new_keys);
-                dsc_free(new_values);
-                dsc_free(new_hashes);
-                map->capacity = old_capacity;
-                return DSC_ERROR_OVERFLOW;
-            }
+    if (key) *key = key_at(table, idx);
+    if (value) *value = value_at(table, idx);
+    *cursor = base + idx + 1;
 
-            memcpy((char *)new_keys + new_key_offset,
-                   (char *)map->keys + old_key_offset, map->key_size);
-            memcpy((char *)new_values + new_value_offset,
-                   (char *)map->values + old_value_offset, map->value_size);
-            new_hashes[new_idx] = map->hashes[i];
-        }
+    return true;
+}
+
+DSCError unordered_map_save(DSCUnorderedMap const *map, char const *path) {
+    if (!map || !path) return DSC_ERROR_INVALID_ARGUMENT;
+
+    // Only a single flat table can be mapped, so finish a pending
+    // migration on a copy rather than touching the caller's map.
+    if (map->old_table) {
+        DSCUnorderedMap *flat = unordered_map_clone(map);
+        if (!flat) return DSC_ERROR_MEMORY;
+        DSCError err = finish_migration(flat);
+        if (err == DSC_ERROR_OK) err = unordered_map_save(flat, path);
+        unordered_map_destroy(flat);
+        return err;
     }
 
-    dsc_free(map->keys);
-    dsc_free(map->values);
-    dsc_free(map->hashes);
+    DSCTableFileHeader header = {0};
+    memcpy(header.magic, file_magic, sizeof(header.magic));
+    header.probe_mode = (uint32_t)map->probe_mode;
+    header.flags = map->hash_fn ? 0 : DSC_TABLE_FILE_BYTE_HASH;
+    header.key_size = map->key_size;
+    header.value_size = map->value_size;
+    header.size = map->size;
+    header.capacity = map->capacity;
+    header.growth_left = map->growth_left;
+    header.lengths[DSC_TABLE_SECTION_KEYS] = map->capacity * map->key_size;
+    header.lengths[DSC_TABLE_SECTION_VALUES] =
+        map->capacity * map->value_size;
+    header.lengths[DSC_TABLE_SECTION_CTRL] = map->capacity;
+    header.lengths[DSC_TABLE_SECTION_DIST] = map->dist ? map->capacity : 0;
+
+    void const *sections[DSC_TABLE_SECTION_COUNT] = {
+        map->keys, map->values, map->ctrl, map->dist};
+
+    return dsc_table_file_save(path, &header, sections);
+}
 
-    map->keys = new_keys;
-    map->values = new_values;
-    map->hashes = new_hashes;
+DSCUnorderedMap *unordered_map_open_mapped(
+    char const *path, size_t key_size, size_t value_size,
+    size_t (*hash_fn)(void const *),
+    int (*compare_fn)(void const *, void const *)) {
+    if (!path || key_size == 0 || value_size == 0 || !hash_fn != !compare_fn) {
+        return NULL;
+    }
 
-    return DSC_ERROR_OK;
+    void *mapping;
+    size_t mapping_size;
+    if (dsc_table_file_map(path, file_magic, &mapping, &mapping_size) !=
+        DSC_ERROR_OK) {
+        return NULL;
+    }
+
+    // The file cannot record which hash_fn built it, only whether one did.
+    DSCTableFileHeader const *header = mapping;
+    bool byte_hash = (header->flags & DSC_TABLE_FILE_BYTE_HASH) != 0;
+    if (header->key_size != key_size || header->value_size != value_size ||
+        byte_hash != !hash_fn) {
+        dsc_table_file_unmap(mapping, mapping_size);
+        return NULL;
+    }
+
+    DSCAllocator alloc = dsc_default_allocator();
+    DSCUnorderedMap *map = dsc_allocate(&alloc, sizeof(DSCUnorderedMap));
+    if (!map) {
+        dsc_table_file_unmap(mapping, mapping_size);
+        return NULL;
+    }
+
+    char *base = mapping;
+    map->keys = base + header->offsets[DSC_TABLE_SECTION_KEYS];
+    map->values = base + header->offsets[DSC_TABLE_SECTION_VALUES];
+    map->ctrl = (int8_t *)(base + header->offsets[DSC_TABLE_SECTION_CTRL]);
+    map->probe_mode = (DSCProbeMode)header->probe_mode;
+    map->dist = map->probe_mode == DSC_PROBE_ROBIN_HOOD
+                    ? (uint8_t *)(base +
+                                  header->offsets[DSC_TABLE_SECTION_DIST])
+                    : NULL;
+    map->size = (size_t)header->size;
+    map->capacity = (size_t)header->capacity;
+    map->growth_left = (size_t)header->growth_left;
+    map->old_table = NULL;
+    map->rehash_pos = 0;
+    map->incremental_rehash = false;
+    map->mapping = mapping;
+    map->mapping_size = mapping_size;
+    map->key_size = key_size;
+    map->value_size = value_size;
+    map->hash_fn = hash_fn;
+    map->compare_fn = compare_fn;
+    map->allocator = alloc;
+
+    return map;
 }
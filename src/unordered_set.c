@@ -2,84 +2,311 @@
 
 #include "libdsc/unordered_set.h"
 
-#include <stdlib.h>
 #include <string.h>
 
+#include "libdsc/hash_table.h"
+#include "table_file.h"
+
 #define DSC_UNORDERED_SET_INITIAL_CAPACITY 16
-#define LOAD_FACTOR 0.75f
 
-static size_t find_slot(DSCUnorderedSet const *set, void const *element,
-                        size_t hash) {
+static char const file_magic[8] = "DSCUSET";
+
+static void *element_at(DSCUnorderedSet const *set, size_t idx) {
+    return (char *)set->elements + idx * set->element_size;
+}
+
+// Sets created without hash_fn and compare_fn hash and compare raw bytes.
+static size_t hash_key(DSCUnorderedSet const *set, void const *key) {
+    if (!set->hash_fn) {
+        return (size_t)dsc_hash_bytes(key, set->element_size,
+                                      DSC_HASH_DEFAULT_SEED);
+    }
+    return dsc_hash_finalize(set->hash_fn(key));
+}
+
+static bool keys_equal(DSCUnorderedSet const *set, void const *a,
+                       void const *b) {
+    if (!set->compare_fn) {
+        return memcmp(a, b, set->element_size) == 0;
+    }
+    return set->compare_fn(a, b) == 0;
+}
+
+// Returns the slot holding element, or set->capacity if it is absent.
+static size_t find_slot_group(DSCUnorderedSet const *set, void const *element,
+                              size_t hash) {
+    size_t group_mask = set->capacity / DSC_GROUP_WIDTH - 1;
+    size_t group = dsc_hash_h1(hash) & group_mask;
+    int8_t h2 = dsc_hash_h2(hash);
+
+    for (size_t step = 1; step <= group_mask + 1; ++step) {
+        int8_t const *ctrl = set->ctrl + group * DSC_GROUP_WIDTH;
+
+        DSCGroupMask match = dsc_group_match(ctrl, h2);
+        while (match) {
+            size_t idx = group * DSC_GROUP_WIDTH + dsc_mask_index(match);
+            if (keys_equal(set, element_at(set, idx), element)) {
+                return idx;
+            }
+            match = dsc_mask_next(match);
+        }
+
+        if (dsc_group_match_empty(ctrl)) {
+            break;
+        }
+
+        group = (group + step) & group_mask;
+    }
+
+    return set->capacity;
+}
+
+// See find_slot_robin_hood() in unordered_map.c.
+static size_t find_slot_robin_hood(DSCUnorderedSet const *set,
+                                   void const *element, size_t hash) {
     size_t mask = set->capacity - 1;
-    size_t idx = hash & mask;
+    size_t idx = dsc_hash_h1(hash) & mask;
+    int8_t h2 = dsc_hash_h2(hash);
 
-    while (set->hashes[idx] != 0) {
-        if (set->hashes[idx] == hash &&
-            set->compare_fn((char *)set->elements + idx * set->element_size,
-                            element) == 0) {
+    for (size_t dist = 0;; ++dist) {
+        int8_t ctrl = set->ctrl[idx];
+        if (ctrl == DSC_CTRL_EMPTY || set->dist[idx] < dist) {
+            break;
+        }
+        if (ctrl == h2 && keys_equal(set, element_at(set, idx), element)) {
             return idx;
         }
         idx = (idx + 1) & mask;
     }
+
+    return set->capacity;
+}
+
+static size_t find_slot(DSCUnorderedSet const *set, void const *element,
+                        size_t hash) {
+    if (set->probe_mode == DSC_PROBE_ROBIN_HOOD) {
+        return find_slot_robin_hood(set, element, hash);
+    }
+    return find_slot_group(set, element, hash);
+}
+
+
+static void move_slot(DSCUnorderedSet *set, size_t to, size_t from,
+                      int delta) {
+    memcpy(element_at(set, to), element_at(set, from), set->element_size);
+    set->ctrl[to] = set->ctrl[from];
+    set->dist[to] = (uint8_t)(set->dist[from] + delta);
+}
+
+// See claim_robin_hood() in unordered_map.c.
+static size_t claim_robin_hood(DSCUnorderedSet *set, size_t hash) {
+    size_t mask = set->capacity - 1;
+    size_t idx = dsc_hash_h1(hash) & mask;
+    size_t dist = 0;
+
+    while (set->ctrl[idx] != DSC_CTRL_EMPTY && set->dist[idx] >= dist) {
+        idx = (idx + 1) & mask;
+        ++dist;
+    }
+    if (dist > DSC_RH_MAX_DIST) return set->capacity;
+
+    size_t end = idx;
+    while (set->ctrl[end] != DSC_CTRL_EMPTY) {
+        if (set->dist[end] == DSC_RH_MAX_DIST) return set->capacity;
+        end = (end + 1) & mask;
+    }
+
+    for (size_t to = end; to != idx;) {
+        size_t from = (to - 1) & mask;
+        move_slot(set, to, from, 1);
+        to = from;
+    }
+    --(set->growth_left);
+
+    set->ctrl[idx] = dsc_hash_h2(hash);
+    set->dist[idx] = (uint8_t)dist;
+
     return idx;
 }
 
-static DSCError rehash(DSCUnorderedSet *set) {
-    size_t old_capacity = set->capacity;
-    void *old_elements = set->elements;
-    size_t *old_hashes = set->hashes;
+// See erase_robin_hood() in unordered_map.c.
+static void erase_robin_hood(DSCUnorderedSet *set, size_t idx) {
+    size_t mask = set->capacity - 1;
+    size_t next = (idx + 1) & mask;
+
+    while (dsc_ctrl_is_full(set->ctrl[next]) && set->dist[next] > 0) {
+        move_slot(set, idx, next, -1);
+        idx = next;
+        next = (next + 1) & mask;
+    }
+
+    set->ctrl[idx] = DSC_CTRL_EMPTY;
+    ++(set->growth_left);
+}
+
+static size_t claim_slot(DSCUnorderedSet *set, size_t hash) {
+    size_t idx;
+
+    if (set->probe_mode == DSC_PROBE_ROBIN_HOOD) {
+        idx = claim_robin_hood(set, hash);
+        if (idx == set->capacity) return idx;
+    } else {
+        idx = dsc_ctrl_find_insert_slot(set->ctrl, set->capacity, hash);
+        if (set->ctrl[idx] == DSC_CTRL_EMPTY) {
+            --(set->growth_left);
+        }
+        set->ctrl[idx] = dsc_hash_h2(hash);
+    }
+
+    ++(set->size);
+    return idx;
+}
 
-    set->capacity *= 2;
-    set->elements = calloc(set->capacity, set->element_size);
-    set->hashes = calloc(set->capacity, sizeof(size_t));
+static DSCError fall_back_to_groups(DSCUnorderedSet *set);
 
-    if (!set->elements || !set->hashes) {
-        free(set->elements);
-        free(set->hashes);
-        set->elements = old_elements;
-        set->hashes = old_hashes;
-        set->capacity = old_capacity;
+// Replaces the arrays of set with empty ones of the given capacity and
+// mode, leaving set untouched on failure.
+static DSCError alloc_table(DSCUnorderedSet *set, size_t capacity,
+                            DSCProbeMode mode) {
+    size_t elements_size;
+    if (!dsc_safe_multiply(capacity, set->element_size, &elements_size)) {
+        return DSC_ERROR_OVERFLOW;
+    }
+
+    DSCAllocator const *alloc = &set->allocator;
+    void *elements = dsc_allocate(alloc, elements_size);
+    int8_t *ctrl = dsc_allocate(alloc, capacity);
+    uint8_t *dist =
+        mode == DSC_PROBE_ROBIN_HOOD ? dsc_allocate(alloc, capacity) : NULL;
+
+    if (!elements || !ctrl || (mode == DSC_PROBE_ROBIN_HOOD && !dist)) {
+        dsc_deallocate(alloc, elements, elements_size);
+        dsc_deallocate(alloc, ctrl, capacity);
+        dsc_deallocate(alloc, dist, capacity);
         return DSC_ERROR_MEMORY;
     }
 
-    for (size_t i = 0; i < old_capacity; ++i) {
-        if (old_hashes[i] != 0) {
-            size_t new_idx =
-                find_slot(set, (char *)old_elements + i * set->element_size,
-                          old_hashes[i]);
+    memset(ctrl, DSC_CTRL_EMPTY, capacity);
+    set->elements = elements;
+    set->ctrl = ctrl;
+    set->dist = dist;
+    set->capacity = capacity;
+    set->probe_mode = mode;
+    set->growth_left = dsc_table_growth(mode, capacity);
+
+    return DSC_ERROR_OK;
+}
+
+static void free_table(DSCUnorderedSet *set) {
+    DSCAllocator const *alloc = &set->allocator;
+    dsc_deallocate(alloc, set->elements, set->capacity * set->element_size);
+    dsc_deallocate(alloc, set->ctrl, set->capacity);
+    dsc_deallocate(alloc, set->dist, set->capacity);
+}
+
+static DSCError rehash(DSCUnorderedSet *set, size_t new_capacity,
+                       DSCProbeMode mode) {
+    DSCUnorderedSet old = *set;
 
-            memcpy((char *)set->elements + new_idx * set->element_size,
-                   (char *)old_elements + i * set->element_size,
-                   set->element_size);
-            set->hashes[new_idx] = old_hashes[i];
+    DSCError err = alloc_table(set, new_capacity, mode);
+    if (err != DSC_ERROR_OK) return err;
+    set->size = 0;
+
+    for (size_t i = dsc_ctrl_next_full(old.ctrl, old.capacity, 0);
+         i < old.capacity;
+         i = dsc_ctrl_next_full(old.ctrl, old.capacity, i + 1)) {
+        size_t idx = claim_slot(set, hash_key(&old, element_at(&old, i)));
+
+        if (idx == set->capacity) {
+            free_table(set);
+            *set = old;
+            return fall_back_to_groups(set);
         }
+
+        memcpy(element_at(set, idx), element_at(&old, i), set->element_size);
     }
 
-    free(old_elements);
-    free(old_hashes);
+    free_table(&old);
+
     return DSC_ERROR_OK;
 }
 
+// See fall_back_to_groups() in unordered_map.c.
+static DSCError fall_back_to_groups(DSCUnorderedSet *set) {
+    size_t new_capacity = dsc_capacity_for(
+        set->size + 1, DSC_UNORDERED_SET_INITIAL_CAPACITY, DSC_PROBE_GROUP);
+    if (new_capacity == 0) return DSC_ERROR_OVERFLOW;
+
+    return rehash(set, new_capacity, DSC_PROBE_GROUP);
+}
+
+static DSCError grow(DSCUnorderedSet *set) {
+    size_t new_capacity = set->capacity;
+
+    if (set->size >= dsc_table_growth(set->probe_mode, set->capacity) / 2) {
+        if (set->capacity > SIZE_MAX / 2) {
+            return DSC_ERROR_OVERFLOW;
+        }
+        new_capacity = set->capacity * 2;
+    }
+
+    return rehash(set, new_capacity, set->probe_mode);
+}
+
+static bool needs_growth(DSCUnorderedSet const *set, size_t hash) {
+    if (set->growth_left > 0) return false;
+    if (set->probe_mode == DSC_PROBE_ROBIN_HOOD) return true;
+
+    size_t idx = dsc_ctrl_find_insert_slot(set->ctrl, set->capacity, hash);
+    return set->ctrl[idx] == DSC_CTRL_EMPTY;
+}
+
+// See prefetch_home() in unordered_map.c.
+static void prefetch_home(DSCUnorderedSet const *set, size_t hash) {
+    size_t idx;
+    if (set->probe_mode == DSC_PROBE_ROBIN_HOOD) {
+        idx = dsc_hash_h1(hash) & (set->capacity - 1);
+        dsc_prefetch(set->dist + idx);
+    } else {
+        size_t group_mask = set->capacity / DSC_GROUP_WIDTH - 1;
+        idx = (dsc_hash_h1(hash) & group_mask) * DSC_GROUP_WIDTH;
+    }
+    dsc_prefetch(set->ctrl + idx);
+    dsc_prefetch(element_at(set, idx));
+}
+
 DSCUnorderedSet *unordered_set_create(size_t element_size,
                                         size_t (*hash_fn)(void const *),
                                         int (*compare_fn)(void const *,
                                                           void const *)) {
-    DSCUnorderedSet *set = malloc(sizeof(DSCUnorderedSet));
+    return unordered_set_create_with_allocator(element_size, hash_fn,
+                                               compare_fn, NULL);
+}
+
+DSCUnorderedSet *unordered_set_create_with_allocator(
+    size_t element_size, size_t (*hash_fn)(void const *),
+    int (*compare_fn)(void const *, void const *),
+    DSCAllocator const *allocator) {
+    if (element_size == 0 || !hash_fn != !compare_fn ||
+        !dsc_allocator_valid(allocator)) {
+        return NULL;
+    }
+
+    DSCAllocator alloc = dsc_allocator_or_default(allocator);
+    DSCUnorderedSet *set = dsc_allocate(&alloc, sizeof(DSCUnorderedSet));
     if (!set) return NULL;
 
-    set->capacity = DSC_UNORDERED_SET_INITIAL_CAPACITY;
     set->size = 0;
+    set->mapping = NULL;
+    set->mapping_size = 0;
     set->element_size = element_size;
     set->hash_fn = hash_fn;
     set->compare_fn = compare_fn;
+    set->allocator = alloc;
 
-    set->elements = calloc(set->capacity, element_size);
-    set->hashes = calloc(set->capacity, sizeof(size_t));
-
-    if (!set->elements || !set->hashes) {
-        free(set->elements);
-        free(set->hashes);
-        free(set);
+    if (alloc_table(set, DSC_UNORDERED_SET_INITIAL_CAPACITY,
+                    DSC_PROBE_GROUP) != DSC_ERROR_OK) {
+        dsc_deallocate(&alloc, set, sizeof(DSCUnorderedSet));
         return NULL;
     }
 
@@ -88,9 +315,14 @@ DSCUnorderedSet *unordered_set_create(size_t element_size,
 
 void unordered_set_destroy(DSCUnorderedSet *set) {
     if (!set) return;
-    free(set->elements);
-    free(set->hashes);
-    free(set);
+
+    DSCAllocator alloc = set->allocator;
+    if (set->mapping) {
+        dsc_table_file_unmap(set->mapping, set->mapping_size);
+    } else {
+        free_table(set);
+    }
+    dsc_deallocate(&alloc, set, sizeof(DSCUnorderedSet));
 }
 
 size_t unordered_set_size(DSCUnorderedSet const *set) {
@@ -103,22 +335,26 @@ bool unordered_set_empty(DSCUnorderedSet const *set) {
 
 DSCError unordered_set_insert(DSCUnorderedSet *set, void const *element) {
     if (!set || !element) return DSC_ERROR_INVALID_ARGUMENT;
+    if (set->mapping) return DSC_ERROR_READ_ONLY;
 
-    if ((float)set->size / set->capacity >= LOAD_FACTOR) {
-        DSCError err = rehash(set);
-        if (err != DSC_ERROR_OK) return err;
-    }
-
-    size_t hash = set->hash_fn(element);
+    size_t hash = hash_key(set, element);
     size_t idx = find_slot(set, element, hash);
 
-    if (set->hashes[idx] == 0) {
-        ++(set->size);
+    if (idx == set->capacity) {
+        if (needs_growth(set, hash)) {
+            DSCError err = grow(set);
+            if (err != DSC_ERROR_OK) return err;
+        }
+
+        idx = claim_slot(set, hash);
+        if (idx == set->capacity) {
+            DSCError err = fall_back_to_groups(set);
+            if (err != DSC_ERROR_OK) return err;
+            idx = claim_slot(set, hash);
+        }
     }
 
-    memcpy((char *)set->elements + idx * set->element_size, element,
-           set->element_size);
-    set->hashes[idx] = hash;
+    memcpy(element_at(set, idx), element, set->element_size);
 
     return DSC_ERROR_OK;
 }
@@ -126,92 +362,193 @@ DSCError unordered_set_insert(DSCUnorderedSet *set, void const *element) {
 void *unordered_set_find(DSCUnorderedSet *set, void const *element) {
     if (!set || !element) return NULL;
 
-    size_t hash = set->hash_fn(element);
+    size_t hash = hash_key(set, element);
     size_t idx = find_slot(set, element, hash);
 
-    if (set->hashes[idx] == 0) return NULL;
+    if (idx == set->capacity) return NULL;
 
-    return (char *)set->elements + idx * set->element_size;
+    return element_at(set, idx);
+}
+
+size_t unordered_set_contains_batch(DSCUnorderedSet const *set,
+                                    void const *elements, size_t n,
+                                    bool *results) {
+    if (!set || (n > 0 && (!elements || !results))) return 0;
+
+    size_t hashes[DSC_LOOKUP_BATCH];
+    size_t found = 0;
+
+    for (size_t base = 0; base < n; base += DSC_LOOKUP_BATCH) {
+        size_t count = n - base < DSC_LOOKUP_BATCH ? n - base
+                                                   : DSC_LOOKUP_BATCH;
+        char const *batch = (char const *)elements + base * set->element_size;
+
+        for (size_t i = 0; i < count; ++i) {
+            hashes[i] = hash_key(set, batch + i * set->element_size);
+            prefetch_home(set, hashes[i]);
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            bool hit = find_slot(set, batch + i * set->element_size,
+                                 hashes[i]) != set->capacity;
+            results[base + i] = hit;
+            found += hit;
+        }
+    }
+
+    return found;
 }
 
 DSCError unordered_set_erase(DSCUnorderedSet *set, void const *element) {
     if (!set || !element) return DSC_ERROR_INVALID_ARGUMENT;
+    if (set->mapping) return DSC_ERROR_READ_ONLY;
 
-    size_t hash = set->hash_fn(element);
+    size_t hash = hash_key(set, element);
     size_t idx = find_slot(set, element, hash);
 
-    if (set->hashes[idx] == 0) return DSC_ERROR_NOT_FOUND;
-
-    set->hashes[idx] = 0;
-    set->size--;
-
-    // Rehash remaining elements
-    size_t mask = set->capacity - 1;
-    size_t next = (idx + 1) & mask;
+    if (idx == set->capacity) return DSC_ERROR_NOT_FOUND;
 
-    while (set->hashes[next] != 0) {
-        size_t existing_hash = set->hashes[next];
-        size_t new_idx =
-            find_slot(set, (char *)set->elements + next * set->element_size,
-                      existing_hash);
-
-        if (new_idx != next) {
-            memcpy((char *)set->elements + new_idx * set->element_size,
-                   (char *)set->elements + next * set->element_size,
-                   set->element_size);
-            set->hashes[new_idx] = existing_hash;
-            set->hashes[next] = 0;
-        }
+    if (set->probe_mode == DSC_PROBE_ROBIN_HOOD) {
+        erase_robin_hood(set, idx);
+        set->size--;
+        return DSC_ERROR_OK;
+    }
 
-        next = (next + 1) & mask;
+    if (dsc_ctrl_erase(set->ctrl, idx)) {
+        ++(set->growth_left);
     }
+    set->size--;
 
     return DSC_ERROR_OK;
 }
 
 void unordered_set_clear(DSCUnorderedSet *set) {
-    if (!set) return;
+    if (!set || set->mapping) return;
 
-    memset(set->hashes, 0, set->capacity * sizeof(size_t));
+    memset(set->ctrl, DSC_CTRL_EMPTY, set->capacity);
     set->size = 0;
+    set->growth_left = dsc_table_growth(set->probe_mode, set->capacity);
 }
 
 DSCError unordered_set_reserve(DSCUnorderedSet *set, size_t n) {
     if (!set) return DSC_ERROR_INVALID_ARGUMENT;
+    if (set->mapping) return DSC_ERROR_READ_ONLY;
 
-    if (n <= set->capacity) return DSC_ERROR_OK;
+    if (n <= dsc_table_growth(set->probe_mode, set->capacity)) {
+        return DSC_ERROR_OK;
+    }
 
-    size_t old_capacity = set->capacity;
-    set->capacity = n;
+    size_t new_capacity = dsc_capacity_for(
+        n, DSC_UNORDERED_SET_INITIAL_CAPACITY, set->probe_mode);
+    if (new_capacity == 0) return DSC_ERROR_OVERFLOW;
 
-    void *new_elements = calloc(set->capacity, set->element_size);
-    size_t *new_hashes = calloc(set->capacity, sizeof(size_t));
+    return rehash(set, new_capacity, set->probe_mode);
+}
 
-    if (!new_elements || !new_hashes) {
-        free(new_elements);
-        free(new_hashes);
-        set->capacity = old_capacity;
-        return DSC_ERROR_MEMORY;
+DSCError unordered_set_set_probe_mode(DSCUnorderedSet *set,
+                                      DSCProbeMode mode) {
+    if (!set ||
+        (mode != DSC_PROBE_GROUP && mode != DSC_PROBE_ROBIN_HOOD)) {
+        return DSC_ERROR_INVALID_ARGUMENT;
     }
 
-    for (size_t i = 0; i < old_capacity; ++i) {
-        if (set->hashes[i] != 0) {
-            size_t new_idx =
-                find_slot(set, (char *)set->elements + i * set->element_size,
-                          set->hashes[i]);
+    if (mode == set->probe_mode) return DSC_ERROR_OK;
+    if (set->mapping) return DSC_ERROR_READ_ONLY;
 
-            memcpy((char *)new_elements + new_idx * set->element_size,
-                   (char *)set->elements + i * set->element_size,
-                   set->element_size);
-            new_hashes[new_idx] = set->hashes[i];
-        }
+    size_t new_capacity = dsc_capacity_for(
+        set->size, DSC_UNORDERED_SET_INITIAL_CAPACITY, mode);
+    if (new_capacity == 0) return DSC_ERROR_OVERFLOW;
+    if (new_capacity < set->capacity) new_capacity = set->capacity;
+
+    return rehash(set, new_capacity, mode);
+}
+
+DSCProbeMode unordered_set_probe_mode(DSCUnorderedSet const *set) {
+    return set ? set->probe_mode : DSC_PROBE_GROUP;
+}
+
+bool unordered_set_next(DSCUnorderedSet const *set, size_t *cursor,
+                        void **element) {
+    if (!set || !cursor || *cursor >= set->capacity) return false;
+
+    size_t idx = dsc_ctrl_next_full(set->ctrl, set->capacity, *cursor);
+    if (idx == set->capacity) {
+        *cursor = set->capacity;
+        return false;
     }
 
-    free(set->elements);
-    free(set->hashes);
+    if (element) *element = element_at(set, idx);
+    *cursor = idx + 1;
 
-    set->elements = new_elements;
-    set->hashes = new_hashes;
+    return true;
+}
 
-    return DSC_ERROR_OK;
+DSCError unordered_set_save(DSCUnorderedSet const *set, char const *path) {
+    if (!set || !path) return DSC_ERROR_INVALID_ARGUMENT;
+
+    DSCTableFileHeader header = {0};
+    memcpy(header.magic, file_magic, sizeof(header.magic));
+    header.probe_mode = (uint32_t)set->probe_mode;
+    header.flags = set->hash_fn ? 0 : DSC_TABLE_FILE_BYTE_HASH;
+    header.key_size = set->element_size;
+    header.size = set->size;
+    header.capacity = set->capacity;
+    header.growth_left = set->growth_left;
+    header.lengths[DSC_TABLE_SECTION_KEYS] =
+        set->capacity * set->element_size;
+    header.lengths[DSC_TABLE_SECTION_CTRL] = set->capacity;
+    header.lengths[DSC_TABLE_SECTION_DIST] = set->dist ? set->capacity : 0;
+
+    void const *sections[DSC_TABLE_SECTION_COUNT] = {
+        set->elements, NULL, set->ctrl, set->dist};
+
+    return dsc_table_file_save(path, &header, sections);
+}
+
+DSCUnorderedSet *unordered_set_open_mapped(
+    char const *path, size_t element_size, size_t (*hash_fn)(void const *),
+    int (*compare_fn)(void const *, void const *)) {
+    if (!path || element_size == 0 || !hash_fn != !compare_fn) return NULL;
+
+    void *mapping;
+    size_t mapping_size;
+    if (dsc_table_file_map(path, file_magic, &mapping, &mapping_size) !=
+        DSC_ERROR_OK) {
+        return NULL;
+    }
+
+    DSCTableFileHeader const *header = mapping;
+    bool byte_hash = (header->flags & DSC_TABLE_FILE_BYTE_HASH) != 0;
+    if (header->key_size != element_size || header->value_size != 0 ||
+        byte_hash != !hash_fn) {
+        dsc_table_file_unmap(mapping, mapping_size);
+        return NULL;
+    }
+
+    DSCAllocator alloc = dsc_default_allocator();
+    DSCUnorderedSet *set = dsc_allocate(&alloc, sizeof(DSCUnorderedSet));
+    if (!set) {
+        dsc_table_file_unmap(mapping, mapping_size);
+        return NULL;
+    }
+
+    char *base = mapping;
+    set->elements = base + header->offsets[DSC_TABLE_SECTION_KEYS];
+    set->ctrl = (int8_t *)(base + header->offsets[DSC_TABLE_SECTION_CTRL]);
+    set->probe_mode = (DSCProbeMode)header->probe_mode;
+    set->dist = set->probe_mode == DSC_PROBE_ROBIN_HOOD
+                    ? (uint8_t *)(base +
+                                  header->offsets[DSC_TABLE_SECTION_DIST])
+                    : NULL;
+    set->size = (size_t)header->size;
+    set->capacity = (size_t)header->capacity;
+    set->growth_left = (size_t)header->growth_left;
+    set->mapping = mapping;
+    set->mapping_size = mapping_size;
+    set->element_size = element_size;
+    set->hash_fn = hash_fn;
+    set->compare_fn = compare_fn;
+    set->allocator = alloc;
+
+    return set;
 }
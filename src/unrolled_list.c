@@ -0,0 +1,439 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "libdsc/unrolled_list.h"
+
+#include <string.h>
+
+// Pointer to slot i of a node, counted from the start of its array.
+static char *slot(DSCUnrolledList const *list, DSCUnrolledListNode *node,
+                  size_t i) {
+    return (char *)node->data + i * list->element_size;
+}
+
+// Pointer to the element at index i of a node, counted from begin.
+static char *element(DSCUnrolledList const *list, DSCUnrolledListNode *node,
+                     size_t i) {
+    return slot(list, node, node->begin + i);
+}
+
+static DSCUnrolledListNode *create_node(DSCUnrolledList *list,
+                                        size_t begin) {
+    DSCUnrolledListNode *node = pool_allocate(list->pool);
+    if (!node) {
+        return NULL;
+    }
+
+    node->prev = NULL;
+    node->next = NULL;
+    node->begin = begin;
+    node->count = 0;
+    return node;
+}
+
+// Links node into the list after prev, or at the front if prev is NULL.
+static void link_after(DSCUnrolledList *list, DSCUnrolledListNode *prev,
+                       DSCUnrolledListNode *node) {
+    node->prev = prev;
+    node->next = prev ? prev->next : list->head;
+    if (node->next) {
+        node->next->prev = node;
+    } else {
+        list->tail = node;
+    }
+    if (prev) {
+        prev->next = node;
+    } else {
+        list->head = node;
+    }
+}
+
+static void unlink_node(DSCUnrolledList *list, DSCUnrolledListNode *node) {
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    } else {
+        list->tail = node->prev;
+    }
+    pool_deallocate(list->pool, node);
+}
+
+// Moves the upper half of a full node into a new node after it.
+static DSCUnrolledListNode *split_node(DSCUnrolledList *list,
+                                       DSCUnrolledListNode *node) {
+    DSCUnrolledListNode *upper = create_node(list, 0);
+    if (!upper) {
+        return NULL;
+    }
+
+    size_t half = node->count / 2;
+    upper->count = node->count - half;
+    memcpy(slot(list, upper, 0), element(list, node, half),
+           upper->count * list->element_size);
+    node->count = half;
+    link_after(list, node, upper);
+    return upper;
+}
+
+// Appends the elements of node->next to node and frees node->next. The
+// caller checks that they fit.
+static void merge_next(DSCUnrolledList *list, DSCUnrolledListNode *node) {
+    DSCUnrolledListNode *next = node->next;
+    if (node->begin + node->count + next->count > list->node_capacity) {
+        memmove(slot(list, node, 0), element(list, node, 0),
+                node->count * list->element_size);
+        node->begin = 0;
+    }
+    memcpy(element(list, node, node->count), element(list, next, 0),
+           next->count * list->element_size);
+    node->count += next->count;
+    unlink_node(list, next);
+}
+
+// Moves an iterator left one past the end of its node to the next node.
+static void normalize(DSCUnrolledListIterator *it) {
+    if (it->node && it->index == it->node->count) {
+        it->node = it->node->next;
+        it->index = 0;
+    }
+}
+
+DSCUnrolledList *unrolled_list_create(size_t element_size) {
+    return unrolled_list_create_with_allocator(element_size, NULL);
+}
+
+DSCUnrolledList *unrolled_list_create_with_allocator(
+    size_t element_size, DSCAllocator const *allocator) {
+    if (element_size == 0 || !dsc_allocator_valid(allocator)) {
+        return NULL;
+    }
+
+    size_t const slot_bytes =
+        DSC_UNROLLED_LIST_NODE_BYTES - sizeof(DSCUnrolledListNode);
+    size_t capacity = DSC_UNROLLED_LIST_MIN_NODE_ELEMENTS;
+    if (element_size <= slot_bytes / DSC_UNROLLED_LIST_MIN_NODE_ELEMENTS) {
+        capacity = slot_bytes / element_size;
+    }
+
+    size_t node_size;
+    if (!dsc_safe_multiply(capacity, element_size, &node_size) ||
+        !dsc_safe_add(node_size, sizeof(DSCUnrolledListNode), &node_size)) {
+        return NULL;
+    }
+
+    DSCPool *pool = pool_create_with_allocator(node_size, allocator);
+    if (!pool) {
+        return NULL;
+    }
+
+    DSCUnrolledList *list =
+        dsc_allocate(&pool->allocator, sizeof(DSCUnrolledList));
+    if (!list) {
+        pool_destroy(pool);
+        return NULL;
+    }
+
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+    list->element_size = element_size;
+    list->node_capacity = capacity;
+    list->pool = pool;
+    list->allocator = pool->allocator;
+    return list;
+}
+
+void unrolled_list_destroy(DSCUnrolledList *list) {
+    if (!list) {
+        return;
+    }
+
+    pool_destroy(list->pool);
+
+    DSCAllocator alloc = list->allocator;
+    dsc_deallocate(&alloc, list, sizeof(DSCUnrolledList));
+}
+
+size_t unrolled_list_size(DSCUnrolledList const *list) {
+    return list ? list->size : 0;
+}
+
+bool unrolled_list_empty(DSCUnrolledList const *list) {
+    return !list || list->size == 0;
+}
+
+DSCError unrolled_list_push_front(DSCUnrolledList *list,
+                                  void const *element_ptr) {
+    if (!list || !element_ptr) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    DSCUnrolledListNode *node = list->head;
+    if (!node || node->begin == 0) {
+        // Fill the new node from its end, so further pushes fit in front.
+        node = create_node(list, list->node_capacity);
+        if (!node) {
+            return DSC_ERROR_MEMORY;
+        }
+        link_after(list, NULL, node);
+    }
+
+    --(node->begin);
+    ++(node->count);
+    memcpy(element(list, node, 0), element_ptr, list->element_size);
+    ++(list->size);
+    return DSC_ERROR_OK;
+}
+
+DSCError unrolled_list_push_back(DSCUnrolledList *list,
+                                 void const *element_ptr) {
+    if (!list || !element_ptr) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    DSCUnrolledListNode *node = list->tail;
+    if (!node || node->begin + node->count == list->node_capacity) {
+        node = create_node(list, 0);
+        if (!node) {
+            return DSC_ERROR_MEMORY;
+        }
+        link_after(list, list->tail, node);
+    }
+
+    memcpy(element(list, node, node->count), element_ptr,
+           list->element_size);
+    ++(node->count);
+    ++(list->size);
+    return DSC_ERROR_OK;
+}
+
+DSCError unrolled_list_pop_front(DSCUnrolledList *list) {
+    if (!list) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    if (list->size == 0) {
+        return DSC_ERROR_EMPTY;
+    }
+
+    DSCUnrolledListNode *node = list->head;
+    ++(node->begin);
+    if (--(node->count) == 0) {
+        unlink_node(list, node);
+    }
+    --(list->size);
+    return DSC_ERROR_OK;
+}
+
+DSCError unrolled_list_pop_back(DSCUnrolledList *list) {
+    if (!list) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+    if (list->size == 0) {
+        return DSC_ERROR_EMPTY;
+    }
+
+    DSCUnrolledListNode *node = list->tail;
+    if (--(node->count) == 0) {
+        unlink_node(list, node);
+    }
+    --(list->size);
+    return DSC_ERROR_OK;
+}
+
+void *unrolled_list_front(DSCUnrolledList const *list) {
+    if (!list || list->size == 0) {
+        return NULL;
+    }
+    return element(list, list->head, 0);
+}
+
+void *unrolled_list_back(DSCUnrolledList const *list) {
+    if (!list || list->size == 0) {
+        return NULL;
+    }
+    return element(list, list->tail, list->tail->count - 1);
+}
+
+DSCUnrolledListIterator unrolled_list_iterator_at(DSCUnrolledList const *list,
+                                                  size_t index) {
+    DSCUnrolledListIterator it = {NULL, 0};
+    if (!list || index >= list->size) {
+        return it;
+    }
+
+    // Walk from whichever end is closer.
+    if (index < list->size / 2) {
+        DSCUnrolledListNode *node = list->head;
+        while (index >= node->count) {
+            index -= node->count;
+            node = node->next;
+        }
+        it.node = node;
+        it.index = index;
+    } else {
+        size_t from_back = list->size - 1 - index;
+        DSCUnrolledListNode *node = list->tail;
+        while (from_back >= node->count) {
+            from_back -= node->count;
+            node = node->prev;
+        }
+        it.node = node;
+        it.index = node->count - 1 - from_back;
+    }
+    return it;
+}
+
+void *unrolled_list_at(DSCUnrolledList const *list, size_t index) {
+    return unrolled_list_get(list, unrolled_list_iterator_at(list, index));
+}
+
+DSCUnrolledListIterator unrolled_list_begin(DSCUnrolledList const *list) {
+    DSCUnrolledListIterator it = {list ? list->head : NULL, 0};
+    return it;
+}
+
+DSCUnrolledListIterator unrolled_list_end(DSCUnrolledList const *list) {
+    (void)list;
+    DSCUnrolledListIterator it = {NULL, 0};
+    return it;
+}
+
+void *unrolled_list_get(DSCUnrolledList const *list,
+                        DSCUnrolledListIterator it) {
+    if (!list || !it.node) {
+        return NULL;
+    }
+    return element(list, it.node, it.index);
+}
+
+void unrolled_list_advance(DSCUnrolledListIterator *it) {
+    ++(it->index);
+    normalize(it);
+}
+
+DSCError unrolled_list_insert(DSCUnrolledList *list,
+                              DSCUnrolledListIterator *pos,
+                              void const *element_ptr) {
+    if (!list || !pos || !element_ptr) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!pos->node) {
+        DSCError err = unrolled_list_push_back(list, element_ptr);
+        if (err == DSC_ERROR_OK) {
+            pos->node = list->tail;
+            pos->index = list->tail->count - 1;
+        }
+        return err;
+    }
+
+    DSCUnrolledListNode *node = pos->node;
+    size_t index = pos->index;
+    if (node->count == list->node_capacity) {
+        DSCUnrolledListNode *upper = split_node(list, node);
+        if (!upper) {
+            return DSC_ERROR_MEMORY;
+        }
+        if (index > node->count) {
+            index -= node->count;
+            node = upper;
+        }
+    }
+
+    // Shift whichever side of the insertion point is shorter and has room.
+    bool room_back = node->begin + node->count < list->node_capacity;
+    bool shift_front =
+        node->begin > 0 && (!room_back || index < node->count / 2);
+    if (shift_front) {
+        --(node->begin);
+        memmove(element(list, node, 0), element(list, node, 1),
+                index * list->element_size);
+    } else {
+        memmove(element(list, node, index + 1), element(list, node, index),
+                (node->count - index) * list->element_size);
+    }
+    memcpy(element(list, node, index), element_ptr, list->element_size);
+    ++(node->count);
+    ++(list->size);
+
+    pos->node = node;
+    pos->index = index;
+    return DSC_ERROR_OK;
+}
+
+DSCError unrolled_list_erase(DSCUnrolledList *list,
+                             DSCUnrolledListIterator *pos) {
+    if (!list || !pos || !pos->node) {
+        return DSC_ERROR_INVALID_ARGUMENT;
+    }
+
+    DSCUnrolledListNode *node = pos->node;
+    size_t index = pos->index;
+    if (index < node->count / 2) {
+        memmove(element(list, node, 1), element(list, node, 0),
+                index * list->element_size);
+        ++(node->begin);
+    } else {
+        memmove(element(list, node, index), element(list, node, index + 1),
+                (node->count - index - 1) * list->element_size);
+    }
+    --(node->count);
+    --(list->size);
+
+    if (node->count == 0) {
+        pos->node = node->next;
+        pos->index = 0;
+        unlink_node(list, node);
+        return DSC_ERROR_OK;
+    }
+
+    // Keep nodes at least a quarter full where a neighbour can absorb them.
+    size_t capacity = list->node_capacity;
+    if (node->count < capacity / 4) {
+        DSCUnrolledListNode *prev = node->prev;
+        if (node->next && node->count + node->next->count <= capacity) {
+            merge_next(list, node);
+        } else if (prev && prev->count + node->count <= capacity) {
+            index += prev->count;
+            merge_next(list, prev);
+            node = prev;
+        }
+    }
+
+    pos->node = node;
+    pos->index = index;
+    normalize(pos);
+    return DSC_ERROR_OK;
+}
+
+void unrolled_list_clear(DSCUnrolledList *list) {
+    if (!list) {
+        return;
+    }
+
+    pool_reset(list->pool);
+    list->head = NULL;
+    list->tail = NULL;
+    list->size = 0;
+}
+
+bool unrolled_list_next_block(DSCUnrolledList const *list,
+                              DSCUnrolledListNode **node, void **elements,
+                              size_t *count) {
+    if (!list) {
+        return false;
+    }
+
+    DSCUnrolledListNode *next = *node ? (*node)->next : list->head;
+    if (!next) {
+        return false;
+    }
+
+    *node = next;
+    *elements = element(list, next, 0);
+    *count = next->count;
+    return true;
+}
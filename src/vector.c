@@ -4,27 +4,35 @@
 
 #include <assert.h>
 
-#define DSC_VECTOR_INITIAL_CAPACITY 16
-
 DSCVector *vector_create(size_t element_size) {
-    if (element_size == 0) {
+    return vector_create_with_allocator(element_size, NULL);
+}
+
+DSCVector *vector_create_with_allocator(size_t element_size,
+                                        DSCAllocator const *allocator) {
+    size_t data_size;
+    if (element_size == 0 || !dsc_allocator_valid(allocator) ||
+        !dsc_safe_multiply(element_size, DSC_VECTOR_INITIAL_CAPACITY,
+                           &data_size)) {
         return NULL;
     }
 
-    DSCVector *vector = dsc_malloc(sizeof(DSCVector));
+    DSCAllocator alloc = dsc_allocator_or_default(allocator);
+    DSCVector *vector = dsc_allocate(&alloc, sizeof(DSCVector));
     if (vector == NULL) {
         return NULL;
     }
 
-    vector->data = dsc_malloc(element_size * DSC_VECTOR_INITIAL_CAPACITY);
+    vector->data = dsc_allocate(&alloc, data_size);
     if (vector->data == NULL) {
-        dsc_free(vector);
+        dsc_deallocate(&alloc, vector, sizeof(DSCVector));
         return NULL;
     }
 
     vector->size = 0;
     vector->capacity = DSC_VECTOR_INITIAL_CAPACITY;
     vector->element_size = element_size;
+    vector->allocator = alloc;
 
     return vector;
 }
@@ -34,8 +42,10 @@ void vector_destroy(DSCVector *vector) {
         return;
     }
 
-    dsc_free(vector->data);
-    dsc_free(vector);
+    DSCAllocator alloc = vector->allocator;
+    dsc_deallocate(&alloc, vector->data,
+                   vector->capacity * vector->element_size);
+    dsc_deallocate(&alloc, vector, sizeof(DSCVector));
 }
 
 size_t vector_size(const DSCVector *vector) {
@@ -59,7 +69,14 @@ DSCError vector_reserve(DSCVector *vector, size_t n) {
         return DSC_ERROR_OK;
     }
 
-    void *new_data = dsc_realloc(vector->data, n * vector->element_size);
+    size_t new_size;
+    if (!dsc_safe_multiply(n, vector->element_size, &new_size)) {
+        return DSC_ERROR_OVERFLOW;
+    }
+
+    void *new_data = dsc_reallocate(&vector->allocator, vector->data,
+                                    vector->capacity * vector->element_size,
+                                    new_size);
     if (new_data == NULL) return DSC_ERROR_MEMORY;
 
     vector->data = new_data;
@@ -90,7 +107,7 @@ DSCError vector_push_back(DSCVector *vector, const void *element) {
 
     if (vector->size >= vector->capacity) {
         size_t new_capacity = vector->capacity * 2;
-        DSCError err = vector_reserve(vec, new_capacity);
+        DSCError err = vector_reserve(vector, new_capacity);
         if (err != DSC_ERROR_OK) {
             return err;
         }
@@ -131,7 +148,7 @@ void *vector_front(DSCVector *vec)
 
 void *vector_back(DSCVector *vector)
 {
-    if (vector == NULL || vec->size == 0) {
+    if (vector == NULL || vector->size == 0) {
         return NULL;
     }
 
@@ -206,7 +223,9 @@ DSCError vector_shrink_to_fit(DSCVector *vec) {
         return DSC_ERROR_OK;
     }
 
-    void *new_data = dsc_realloc(vec->data, vec->size * vec->element_size);
+    void *new_data = dsc_reallocate(&vec->allocator, vec->data,
+                                    vec->capacity * vec->element_size,
+                                    vec->size * vec->element_size);
     if (!new_data) {
         return DSC_ERROR_MEMORY;
     }
@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+#include "libdsc/deque.h"
+#include "libdsc/forward_list.h"
+#include "libdsc/list.h"
+#include "libdsc/queue.h"
+#include "libdsc/stack.h"
+#include "libdsc/unordered_map.h"
+#include "libdsc/unordered_set.h"
+#include "libdsc/vector.h"
+
+// Records every live block with its size, and checks that blocks come
+// back with the size they were allocated with.
+struct Tracker {
+    std::map<void *, size_t> blocks;
+    size_t allocations = 0;
+    size_t size_mismatches = 0;
+    size_t unknown_frees = 0;
+};
+
+static void *track_allocate(void *context, size_t size) {
+    auto *tracker = static_cast<Tracker *>(context);
+    void *ptr = malloc(size ? size : 1);
+    if (ptr) {
+        tracker->blocks[ptr] = size;
+        ++tracker->allocations;
+    }
+    return ptr;
+}
+
+static void track_deallocate(void *context, void *ptr, size_t size) {
+    auto *tracker = static_cast<Tracker *>(context);
+    auto it = tracker->blocks.find(ptr);
+    if (it == tracker->blocks.end()) {
+        ++tracker->unknown_frees;
+        return;
+    }
+    if (it->second != size) ++tracker->size_mismatches;
+    tracker->blocks.erase(it);
+    free(ptr);
+}
+
+static void *track_reallocate(void *context, void *ptr, size_t old_size,
+                              size_t new_size) {
+    void *new_ptr = track_allocate(context, new_size);
+    if (new_ptr && ptr) {
+        memcpy(new_ptr, ptr, old_size < new_size ? old_size : new_size);
+        track_deallocate(context, ptr, old_size);
+    }
+    return new_ptr;
+}
+
+static void *failing_allocate(void *context, size_t size) {
+    (void)context;
+    (void)size;
+    return nullptr;
+}
+
+class AllocatorTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        allocator = {track_allocate, track_reallocate, track_deallocate,
+                     &tracker};
+    }
+
+    void TearDown() override {
+        EXPECT_TRUE(tracker.blocks.empty());
+        EXPECT_EQ(tracker.size_mismatches, 0u);
+        EXPECT_EQ(tracker.unknown_frees, 0u);
+    }
+
+    Tracker tracker;
+    DSCAllocator allocator;
+};
+
+TEST_F(AllocatorTest, Vector) {
+    DSCVector *vec = vector_create_with_allocator(sizeof(int), &allocator);
+    ASSERT_NE(vec, nullptr);
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(vector_push_back(vec, &i), DSC_ERROR_OK);
+    }
+    ASSERT_EQ(vector_shrink_to_fit(vec), DSC_ERROR_OK);
+    EXPECT_EQ(*static_cast<int *>(vector_at(vec, 999)), 999);
+    EXPECT_GT(tracker.allocations, 2u);
+
+    vector_destroy(vec);
+}
+
+TEST_F(AllocatorTest, List) {
+    DSCList *list = list_create_with_allocator(sizeof(int), &allocator);
+    ASSERT_NE(list, nullptr);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(list_push_back(list, &i), DSC_ERROR_OK);
+        ASSERT_EQ(list_push_front(list, &i), DSC_ERROR_OK);
+    }
+    ASSERT_EQ(list_pop_front(list), DSC_ERROR_OK);
+    ASSERT_EQ(list_pop_back(list), DSC_ERROR_OK);
+    ASSERT_EQ(list_erase(list, list_begin(list)->next), DSC_ERROR_OK);
+    EXPECT_EQ(list_size(list), 197u);
+
+    list_destroy(list);
+}
+
+TEST_F(AllocatorTest, ListNodesComeFromSlabs) {
+    DSCList *list = list_create_with_allocator(sizeof(int), &allocator);
+    ASSERT_NE(list, nullptr);
+    size_t before = tracker.allocations;
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(list_push_back(list, &i), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(tracker.allocations - before, 2u);
+
+    // Steady-state pushes and pops never reach the allocator.
+    before = tracker.allocations;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(list_pop_front(list), DSC_ERROR_OK);
+        ASSERT_EQ(list_push_back(list, &i), DSC_ERROR_OK);
+    }
+    list_clear(list);
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(list_push_back(list, &i), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(tracker.allocations, before);
+
+    list_destroy(list);
+}
+
+TEST_F(AllocatorTest, ForwardList) {
+    DSCForwardList *list =
+        forward_list_create_with_allocator(sizeof(int), &allocator);
+    ASSERT_NE(list, nullptr);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(forward_list_push_front(list, &i), DSC_ERROR_OK);
+    }
+    ASSERT_EQ(forward_list_pop_front(list), DSC_ERROR_OK);
+    ASSERT_EQ(forward_list_erase_after(list, forward_list_begin(list)),
+              DSC_ERROR_OK);
+    EXPECT_EQ(forward_list_size(list), 98u);
+
+    forward_list_destroy(list);
+}
+
+TEST_F(AllocatorTest, Queue) {
+    DSCQueue *queue = queue_create_with_allocator(sizeof(int), &allocator);
+    ASSERT_NE(queue, nullptr);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(queue_push(queue, &i), DSC_ERROR_OK);
+    }
+    ASSERT_EQ(queue_reserve(queue, 1000), DSC_ERROR_OK);
+    EXPECT_EQ(*static_cast<int *>(queue_front(queue)), 0);
+    EXPECT_EQ(*static_cast<int *>(queue_back(queue)), 99);
+
+    queue_destroy(queue);
+}
+
+TEST_F(AllocatorTest, Deque) {
+    DSCDeque *deque = deque_create_with_allocator(sizeof(int), &allocator);
+    ASSERT_NE(deque, nullptr);
+
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(deque_push_back(deque, &i), DSC_ERROR_OK);
+        ASSERT_EQ(deque_push_front(deque, &i), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(*static_cast<int *>(deque_front(deque)), 4999);
+    EXPECT_EQ(*static_cast<int *>(deque_back(deque)), 4999);
+
+    // Used as a FIFO, the deque recycles the blocks it empties instead of
+    // going back to the allocator.
+    deque_clear(deque);
+    size_t allocations = tracker.allocations;
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(deque_push_back(deque, &i), DSC_ERROR_OK);
+        if (i >= 1000) ASSERT_EQ(deque_pop_front(deque), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(tracker.allocations, allocations);
+    EXPECT_EQ(*static_cast<int *>(deque_front(deque)), 99000);
+
+    deque_shrink_to_fit(deque);
+    deque_destroy(deque);
+}
+
+TEST_F(AllocatorTest, Stack) {
+    DSCStack *stack = stack_create_with_allocator(sizeof(int), &allocator);
+    ASSERT_NE(stack, nullptr);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(stack_push(stack, &i), DSC_ERROR_OK);
+    }
+    ASSERT_EQ(stack_reserve(stack, 1000), DSC_ERROR_OK);
+    EXPECT_EQ(*static_cast<int *>(stack_top(stack)), 99);
+
+    stack_destroy(stack);
+}
+
+TEST_F(AllocatorTest, UnorderedMap) {
+    DSCUnorderedMap *map = unordered_map_create_with_allocator(
+        sizeof(int), sizeof(int), nullptr, nullptr, &allocator);
+    ASSERT_NE(map, nullptr);
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(unordered_map_insert(map, &i, &i), DSC_ERROR_OK);
+    }
+    ASSERT_EQ(unordered_map_set_probe_mode(map, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+
+    DSCUnorderedMap *clone = unordered_map_clone(map);
+    ASSERT_NE(clone, nullptr);
+    EXPECT_EQ(clone->allocator.context, &tracker);
+    unordered_map_destroy(clone);
+
+    size_t blocks = tracker.blocks.size();
+    unordered_map_destroy(map);
+    EXPECT_LT(tracker.blocks.size(), blocks);
+}
+
+TEST_F(AllocatorTest, UnorderedMapIncrementalRehash) {
+    DSCUnorderedMap *map = unordered_map_create_with_allocator(
+        sizeof(int), sizeof(int), nullptr, nullptr, &allocator);
+    ASSERT_NE(map, nullptr);
+    ASSERT_EQ(unordered_map_set_incremental_rehash(map, true), DSC_ERROR_OK);
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(unordered_map_insert(map, &i, &i), DSC_ERROR_OK);
+    }
+    // Leaves a migration pending, so destroy releases the old table too.
+    unordered_map_destroy(map);
+}
+
+TEST_F(AllocatorTest, UnorderedSet) {
+    DSCUnorderedSet *set = unordered_set_create_with_allocator(
+        sizeof(int), nullptr, nullptr, &allocator);
+    ASSERT_NE(set, nullptr);
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(unordered_set_insert(set, &i), DSC_ERROR_OK);
+    }
+    ASSERT_EQ(unordered_set_set_probe_mode(set, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+    int key = 500;
+    EXPECT_NE(unordered_set_find(set, &key), nullptr);
+
+    unordered_set_destroy(set);
+}
+
+TEST_F(AllocatorTest, WithoutReallocate) {
+    allocator.reallocate = nullptr;
+
+    DSCVector *vec = vector_create_with_allocator(sizeof(int), &allocator);
+    ASSERT_NE(vec, nullptr);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(vector_push_back(vec, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(*static_cast<int *>(vector_at(vec, i)), i);
+    }
+    vector_destroy(vec);
+}
+
+TEST_F(AllocatorTest, FailingAllocator) {
+    DSCAllocator failing = {failing_allocate, nullptr, nullptr, nullptr};
+
+    EXPECT_EQ(vector_create_with_allocator(sizeof(int), &failing), nullptr);
+    EXPECT_EQ(list_create_with_allocator(sizeof(int), &failing), nullptr);
+    EXPECT_EQ(unordered_map_create_with_allocator(sizeof(int), sizeof(int),
+                                                  nullptr, nullptr, &failing),
+              nullptr);
+}
+
+TEST(AllocatorValidationTest, RejectsMissingAllocate) {
+    DSCAllocator invalid = {nullptr, nullptr, nullptr, nullptr};
+
+    EXPECT_EQ(vector_create_with_allocator(sizeof(int), &invalid), nullptr);
+    EXPECT_EQ(queue_create_with_allocator(sizeof(int), &invalid), nullptr);
+    EXPECT_EQ(unordered_set_create_with_allocator(sizeof(int), nullptr,
+                                                  nullptr, &invalid),
+              nullptr);
+}
+
+TEST(AllocatorValidationTest, NullSelectsDefault) {
+    DSCStack *stack = stack_create_with_allocator(sizeof(int), nullptr);
+    ASSERT_NE(stack, nullptr);
+    EXPECT_NE(stack->allocator.allocate, nullptr);
+    EXPECT_EQ(stack->allocator.context, nullptr);
+    stack_destroy(stack);
+}
@@ -0,0 +1,219 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "libdsc/arena.h"
+#include "libdsc/list.h"
+#include "libdsc/unordered_map.h"
+#include "libdsc/vector.h"
+
+class ArenaTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        arena = arena_create(1024);
+        ASSERT_NE(arena, nullptr);
+    }
+
+    void TearDown() override { arena_destroy(arena); }
+
+    DSCArena *arena;
+};
+
+static bool is_aligned(void const *ptr) {
+    return reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t) == 0;
+}
+
+TEST_F(ArenaTest, CreateIsEmpty) {
+    EXPECT_EQ(arena_reserved(arena), 0u);
+    EXPECT_EQ(arena_reserved(nullptr), 0u);
+
+    DSCArenaCheckpoint checkpoint = arena_checkpoint(nullptr);
+    EXPECT_EQ(checkpoint.chunk, nullptr);
+    EXPECT_EQ(checkpoint.ptr, nullptr);
+}
+
+TEST_F(ArenaTest, AllocationsAreAlignedAndDistinct) {
+    char *a = static_cast<char *>(arena_allocate(arena, 1));
+    char *b = static_cast<char *>(arena_allocate(arena, 3));
+    char *c = static_cast<char *>(arena_allocate(arena, 0));
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+    ASSERT_NE(c, nullptr);
+    EXPECT_TRUE(is_aligned(a));
+    EXPECT_TRUE(is_aligned(b));
+    EXPECT_TRUE(is_aligned(c));
+    EXPECT_NE(a, b);
+    EXPECT_NE(b, c);
+    EXPECT_EQ(arena_reserved(arena), 1024u);
+}
+
+TEST_F(ArenaTest, GrowsByChunks) {
+    for (int i = 0; i < 100; ++i) {
+        void *block = arena_allocate(arena, 100);
+        ASSERT_NE(block, nullptr);
+        memset(block, i, 100);
+    }
+    EXPECT_GT(arena_reserved(arena), 1024u);
+}
+
+TEST_F(ArenaTest, LargeAllocationGetsOwnChunk) {
+    void *block = arena_allocate(arena, 10000);
+    ASSERT_NE(block, nullptr);
+    memset(block, 0xAB, 10000);
+    EXPECT_GE(arena_reserved(arena), 10000u);
+}
+
+TEST_F(ArenaTest, ResetReusesChunks) {
+    void *first = arena_allocate(arena, 64);
+    for (int i = 0; i < 100; ++i) arena_allocate(arena, 100);
+    size_t reserved = arena_reserved(arena);
+
+    arena_reset(arena);
+    EXPECT_EQ(arena_allocate(arena, 64), first);
+    for (int i = 0; i < 100; ++i) arena_allocate(arena, 100);
+    EXPECT_EQ(arena_reserved(arena), reserved);
+}
+
+TEST_F(ArenaTest, ResetSkipsKeptChunkThatIsTooSmall) {
+    arena_allocate(arena, 1000);
+    arena_allocate(arena, 1000);
+    arena_reset(arena);
+
+    arena_allocate(arena, 1000);
+    void *large = arena_allocate(arena, 5000);
+    ASSERT_NE(large, nullptr);
+    memset(large, 0, 5000);
+    // The kept 1024-byte chunk is still there for later allocations.
+    size_t reserved = arena_reserved(arena);
+    arena_allocate(arena, 1000);
+    EXPECT_EQ(arena_reserved(arena), reserved);
+}
+
+TEST_F(ArenaTest, RollbackReleasesLaterAllocations) {
+    arena_allocate(arena, 100);
+    DSCArenaCheckpoint checkpoint = arena_checkpoint(arena);
+    void *a = arena_allocate(arena, 100);
+    for (int i = 0; i < 50; ++i) arena_allocate(arena, 100);
+
+    arena_rollback(arena, checkpoint);
+    EXPECT_EQ(arena_allocate(arena, 100), a);
+}
+
+TEST_F(ArenaTest, NestedCheckpoints) {
+    DSCArenaCheckpoint outer = arena_checkpoint(arena);
+    void *a = arena_allocate(arena, 16);
+    DSCArenaCheckpoint inner = arena_checkpoint(arena);
+    void *b = arena_allocate(arena, 16);
+
+    arena_rollback(arena, inner);
+    EXPECT_EQ(arena_allocate(arena, 16), b);
+    arena_rollback(arena, outer);
+    EXPECT_EQ(arena_allocate(arena, 16), a);
+}
+
+TEST_F(ArenaTest, TrimFreesUnusedChunks) {
+    for (int i = 0; i < 100; ++i) arena_allocate(arena, 100);
+    arena_reset(arena);
+    arena_trim(arena);
+    EXPECT_EQ(arena_reserved(arena), 1024u);
+    EXPECT_NE(arena_allocate(arena, 100), nullptr);
+}
+
+TEST_F(ArenaTest, ReallocateLastBlockInPlace) {
+    DSCAllocator allocator = arena_allocator(arena);
+    int *data = static_cast<int *>(dsc_allocate(&allocator, 4 * sizeof(int)));
+    ASSERT_NE(data, nullptr);
+    for (int i = 0; i < 4; ++i) data[i] = i;
+
+    int *grown = static_cast<int *>(
+        dsc_reallocate(&allocator, data, 4 * sizeof(int), 8 * sizeof(int)));
+    EXPECT_EQ(grown, data);
+
+    // Not the last block any more, so it has to move.
+    arena_allocate(arena, 1);
+    int *moved = static_cast<int *>(
+        dsc_reallocate(&allocator, grown, 8 * sizeof(int), 16 * sizeof(int)));
+    ASSERT_NE(moved, grown);
+    for (int i = 0; i < 4; ++i) EXPECT_EQ(moved[i], i);
+}
+
+TEST_F(ArenaTest, DeallocateLastBlock) {
+    DSCAllocator allocator = arena_allocator(arena);
+    void *a = dsc_allocate(&allocator, 32);
+    void *b = dsc_allocate(&allocator, 32);
+
+    dsc_deallocate(&allocator, a, 32);  // Not the last block: no-op
+    EXPECT_NE(dsc_allocate(&allocator, 32), a);
+
+    void *c = dsc_allocate(&allocator, 32);
+    dsc_deallocate(&allocator, c, 32);
+    EXPECT_EQ(dsc_allocate(&allocator, 32), c);
+    EXPECT_NE(b, c);
+}
+
+TEST_F(ArenaTest, BacksContainers) {
+    DSCAllocator allocator = arena_allocator(arena);
+
+    for (int round = 0; round < 3; ++round) {
+        DSCVector *vec =
+            vector_create_with_allocator(sizeof(int), &allocator);
+        DSCList *list = list_create_with_allocator(sizeof(int), &allocator);
+        DSCUnorderedMap *map = unordered_map_create_with_allocator(
+            sizeof(int), sizeof(int), nullptr, nullptr, &allocator);
+        ASSERT_NE(vec, nullptr);
+        ASSERT_NE(list, nullptr);
+        ASSERT_NE(map, nullptr);
+
+        for (int i = 0; i < 1000; ++i) {
+            ASSERT_EQ(vector_push_back(vec, &i), DSC_ERROR_OK);
+            ASSERT_EQ(list_push_back(list, &i), DSC_ERROR_OK);
+            ASSERT_EQ(unordered_map_insert(map, &i, &i), DSC_ERROR_OK);
+        }
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_EQ(*static_cast<int *>(vector_at(vec, i)), i);
+            EXPECT_EQ(*static_cast<int *>(unordered_map_find(map, &i)), i);
+        }
+        EXPECT_EQ(list_size(list), 1000u);
+
+        // Destroying is optional; the reset releases everything.
+        if (round == 0) {
+            vector_destroy(vec);
+            list_destroy(list);
+            unordered_map_destroy(map);
+        }
+        arena_reset(arena);
+    }
+}
+
+TEST(ArenaDefaultTest, DefaultChunkSize) {
+    DSCArena *arena = arena_create(0);
+    ASSERT_NE(arena, nullptr);
+    EXPECT_NE(arena_allocate(arena, 1), nullptr);
+    EXPECT_EQ(arena_reserved(arena), DSC_ARENA_DEFAULT_CHUNK_SIZE);
+    arena_destroy(arena);
+}
+
+TEST(ArenaDefaultTest, RollbackToEmptyCheckpoint) {
+    DSCArena *arena = arena_create(256);
+    ASSERT_NE(arena, nullptr);
+    DSCArenaCheckpoint checkpoint = arena_checkpoint(arena);
+    void *a = arena_allocate(arena, 8);
+    arena_allocate(arena, 8);
+
+    arena_rollback(arena, checkpoint);
+    EXPECT_EQ(arena_allocate(arena, 8), a);
+    arena_destroy(arena);
+}
+
+TEST(ArenaDefaultTest, OverflowFails) {
+    DSCArena *arena = arena_create(256);
+    ASSERT_NE(arena, nullptr);
+    EXPECT_EQ(arena_allocate(arena, SIZE_MAX), nullptr);
+    EXPECT_EQ(arena_allocate(arena, SIZE_MAX - sizeof(void *)), nullptr);
+    EXPECT_EQ(arena_allocate(nullptr, 8), nullptr);
+    arena_destroy(arena);
+}
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "libdsc/concurrent_map.h"
+
+static constexpr int kThreads = 8;
+
+static void increment(void *value, void *context) {
+    (void)context;
+    ++*static_cast<uint64_t *>(value);
+}
+
+class ConcurrentMapTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        map = concurrent_map_create(sizeof(uint64_t), sizeof(uint64_t),
+                                    nullptr, nullptr, 0);
+        ASSERT_NE(map, nullptr);
+    }
+
+    void TearDown() override { concurrent_map_destroy(map); }
+
+    DSCConcurrentMap *map;
+};
+
+TEST_F(ConcurrentMapTest, InsertFindErase) {
+    uint64_t key = 7, value = 42, out = 0;
+
+    EXPECT_EQ(concurrent_map_find(map, &key, &out), DSC_ERROR_NOT_FOUND);
+    EXPECT_EQ(concurrent_map_insert(map, &key, &value), DSC_ERROR_OK);
+    EXPECT_EQ(concurrent_map_find(map, &key, &out), DSC_ERROR_OK);
+    EXPECT_EQ(out, 42u);
+    EXPECT_EQ(concurrent_map_find(map, &key, nullptr), DSC_ERROR_OK);
+
+    value = 43;
+    EXPECT_EQ(concurrent_map_insert(map, &key, &value), DSC_ERROR_OK);
+    EXPECT_EQ(concurrent_map_size(map), 1u);
+    EXPECT_EQ(concurrent_map_find(map, &key, &out), DSC_ERROR_OK);
+    EXPECT_EQ(out, 43u);
+
+    EXPECT_EQ(concurrent_map_erase(map, &key), DSC_ERROR_OK);
+    EXPECT_EQ(concurrent_map_erase(map, &key), DSC_ERROR_NOT_FOUND);
+    EXPECT_EQ(concurrent_map_size(map), 0u);
+}
+
+TEST_F(ConcurrentMapTest, InvalidArguments) {
+    uint64_t key = 1;
+    EXPECT_EQ(concurrent_map_insert(nullptr, &key, &key),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(concurrent_map_insert(map, &key, nullptr),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(concurrent_map_find(map, nullptr, nullptr),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(concurrent_map_erase(nullptr, &key), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(concurrent_map_size(nullptr), 0u);
+    EXPECT_EQ(concurrent_map_create(sizeof(uint64_t), sizeof(uint64_t),
+                                    dsc_hash_uint64, nullptr, 0),
+              nullptr);
+    concurrent_map_destroy(nullptr);
+}
+
+TEST_F(ConcurrentMapTest, ShardCounts) {
+    uint64_t key = 3, value = 9, out = 0;
+
+    DSCConcurrentMap *single = concurrent_map_create(
+        sizeof(uint64_t), sizeof(uint64_t), nullptr, nullptr, 1);
+    ASSERT_NE(single, nullptr);
+    EXPECT_EQ(concurrent_map_insert(single, &key, &value), DSC_ERROR_OK);
+    EXPECT_EQ(concurrent_map_find(single, &key, &out), DSC_ERROR_OK);
+    EXPECT_EQ(out, 9u);
+    concurrent_map_destroy(single);
+
+    DSCConcurrentMap *odd = concurrent_map_create(
+        sizeof(uint64_t), sizeof(uint64_t), nullptr, nullptr, 5);
+    ASSERT_NE(odd, nullptr);
+    EXPECT_EQ(concurrent_map_insert(odd, &key, &value), DSC_ERROR_OK);
+    EXPECT_EQ(concurrent_map_find(odd, &key, &out), DSC_ERROR_OK);
+    concurrent_map_destroy(odd);
+
+    EXPECT_EQ(concurrent_map_create(sizeof(uint64_t), sizeof(uint64_t),
+                                    nullptr, nullptr, 1 << 20),
+              nullptr);
+}
+
+TEST_F(ConcurrentMapTest, ParallelDisjointInserts) {
+    constexpr uint64_t kPerThread = 20000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([this, t] {
+            for (uint64_t i = 0; i < kPerThread; ++i) {
+                uint64_t key = t * kPerThread + i;
+                uint64_t value = key * 3;
+                ASSERT_EQ(concurrent_map_insert(map, &key, &value),
+                          DSC_ERROR_OK);
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    EXPECT_EQ(concurrent_map_size(map), kThreads * kPerThread);
+    for (uint64_t key = 0; key < kThreads * kPerThread; ++key) {
+        uint64_t out = 0;
+        ASSERT_EQ(concurrent_map_find(map, &key, &out), DSC_ERROR_OK);
+        EXPECT_EQ(out, key * 3);
+    }
+}
+
+TEST_F(ConcurrentMapTest, ParallelCountingWithTryEmplace) {
+    constexpr uint64_t kKeys = 1000;
+    constexpr int kRounds = 50;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([this] {
+            for (int round = 0; round < kRounds; ++round) {
+                for (uint64_t key = 0; key < kKeys; ++key) {
+                    ASSERT_EQ(concurrent_map_try_emplace(map, &key, increment,
+                                                         nullptr, nullptr),
+                              DSC_ERROR_OK);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    EXPECT_EQ(concurrent_map_size(map), kKeys);
+    for (uint64_t key = 0; key < kKeys; ++key) {
+        uint64_t count = 0;
+        ASSERT_EQ(concurrent_map_find(map, &key, &count), DSC_ERROR_OK);
+        EXPECT_EQ(count, static_cast<uint64_t>(kThreads * kRounds));
+    }
+
+    bool inserted = true;
+    uint64_t key = 0;
+    EXPECT_EQ(concurrent_map_try_emplace(map, &key, nullptr, nullptr,
+                                         &inserted),
+              DSC_ERROR_OK);
+    EXPECT_FALSE(inserted);
+}
+
+TEST_F(ConcurrentMapTest, ParallelReadersAndWriters) {
+    constexpr uint64_t kKeys = 10000;
+
+    for (uint64_t key = 0; key < kKeys; ++key) {
+        ASSERT_EQ(concurrent_map_insert(map, &key, &key), DSC_ERROR_OK);
+    }
+
+    // Writers erase the odd keys and add new ones above kKeys while
+    // readers check that the even keys never disappear.
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([this, t] {
+            if (t % 2 == 0) {
+                for (uint64_t key = t + 1; key < kKeys;
+                     key += kThreads) {
+                    ASSERT_EQ(concurrent_map_erase(map, &key), DSC_ERROR_OK);
+                    uint64_t grown = key + kKeys;
+                    ASSERT_EQ(concurrent_map_insert(map, &grown, &grown),
+                              DSC_ERROR_OK);
+                }
+            } else {
+                for (int round = 0; round < 3; ++round) {
+                    for (uint64_t key = 0; key < kKeys; key += 2) {
+                        uint64_t out = 0;
+                        ASSERT_EQ(concurrent_map_find(map, &key, &out),
+                                  DSC_ERROR_OK);
+                        ASSERT_EQ(out, key);
+                    }
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    EXPECT_EQ(concurrent_map_size(map), kKeys);
+    for (uint64_t key = 1; key < kKeys; key += 2) {
+        EXPECT_EQ(concurrent_map_find(map, &key, nullptr),
+                  DSC_ERROR_NOT_FOUND);
+    }
+}
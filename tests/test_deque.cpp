@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include "libdsc/deque.h"
+
+class DequeTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        deque = deque_create(sizeof(int));
+        ASSERT_NE(deque, nullptr);
+    }
+
+    void TearDown() override { deque_destroy(deque); }
+
+    DSCDeque *deque;
+};
+
+TEST_F(DequeTest, Create) {
+    EXPECT_EQ(deque_size(deque), 0u);
+    EXPECT_TRUE(deque_empty(deque));
+    EXPECT_EQ(deque_front(deque), nullptr);
+    EXPECT_EQ(deque_back(deque), nullptr);
+    EXPECT_EQ(deque_at(deque, 0), nullptr);
+}
+
+TEST_F(DequeTest, InvalidArguments) {
+    int value = 1;
+    EXPECT_EQ(deque_create(0), nullptr);
+    EXPECT_EQ(deque_create(SIZE_MAX / 2), nullptr);
+    EXPECT_EQ(deque_push_back(nullptr, &value), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(deque_push_back(deque, nullptr), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(deque_push_front(nullptr, &value), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(deque_push_front(deque, nullptr), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(deque_pop_back(nullptr), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(deque_pop_front(nullptr), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(deque_pop_back(deque), DSC_ERROR_EMPTY);
+    EXPECT_EQ(deque_pop_front(deque), DSC_ERROR_EMPTY);
+    EXPECT_EQ(deque_size(nullptr), 0u);
+    EXPECT_TRUE(deque_empty(nullptr));
+    EXPECT_EQ(deque_at(nullptr, 0), nullptr);
+    deque_clear(nullptr);
+    deque_shrink_to_fit(nullptr);
+    deque_destroy(nullptr);
+}
+
+TEST_F(DequeTest, PushAndPopBothEnds) {
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(deque_push_back(deque, &i), DSC_ERROR_OK);
+        int negative = -i - 1;
+        ASSERT_EQ(deque_push_front(deque, &negative), DSC_ERROR_OK);
+    }
+    ASSERT_EQ(deque_size(deque), 10u);
+
+    // -5 -4 -3 -2 -1 0 1 2 3 4
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(*static_cast<int *>(deque_at(deque, i)), int(i) - 5);
+    }
+    EXPECT_EQ(deque_at(deque, 10), nullptr);
+
+    EXPECT_EQ(deque_pop_front(deque), DSC_ERROR_OK);
+    EXPECT_EQ(deque_pop_back(deque), DSC_ERROR_OK);
+    EXPECT_EQ(*static_cast<int *>(deque_front(deque)), -4);
+    EXPECT_EQ(*static_cast<int *>(deque_back(deque)), 3);
+    EXPECT_EQ(deque_size(deque), 8u);
+}
+
+TEST_F(DequeTest, MatchesStdDeque) {
+    std::deque<int> model;
+    std::mt19937 rng(7);
+
+    // Biased phases make the deque grow and shrink by many blocks at
+    // either end, so blocks are added and released on both sides.
+    for (int phase = 0; phase < 8; ++phase) {
+        for (int step = 0; step < 20000; ++step) {
+            int value = int(rng());
+            unsigned op = rng() % 8;
+            bool grow = (phase % 2 == 0) ? op < 6 : op < 2;
+            if (grow) {
+                if (rng() % 2) {
+                    ASSERT_EQ(deque_push_back(deque, &value), DSC_ERROR_OK);
+                    model.push_back(value);
+                } else {
+                    ASSERT_EQ(deque_push_front(deque, &value), DSC_ERROR_OK);
+                    model.push_front(value);
+                }
+            } else if (rng() % 2) {
+                ASSERT_EQ(deque_pop_back(deque),
+                          model.empty() ? DSC_ERROR_EMPTY : DSC_ERROR_OK);
+                if (!model.empty()) model.pop_back();
+            } else {
+                ASSERT_EQ(deque_pop_front(deque),
+                          model.empty() ? DSC_ERROR_EMPTY : DSC_ERROR_OK);
+                if (!model.empty()) model.pop_front();
+            }
+            ASSERT_EQ(deque_size(deque), model.size());
+        }
+
+        for (size_t i = 0; i < model.size(); ++i) {
+            ASSERT_EQ(*static_cast<int *>(deque_at(deque, i)), model[i]);
+        }
+    }
+}
+
+TEST_F(DequeTest, AddressesAreStable) {
+    std::vector<int *> addresses;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(deque_push_back(deque, &i), DSC_ERROR_OK);
+        addresses.push_back(static_cast<int *>(deque_back(deque)));
+    }
+
+    // Grow far enough at both ends that the map is reallocated many times.
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_EQ(deque_push_back(deque, &i), DSC_ERROR_OK);
+        ASSERT_EQ(deque_push_front(deque, &i), DSC_ERROR_OK);
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(deque_at(deque, 100000 + i), addresses[i]);
+        EXPECT_EQ(*addresses[i], i);
+    }
+}
+
+TEST_F(DequeTest, ClearAndReuse) {
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 3000; ++i) {
+            ASSERT_EQ(deque_push_front(deque, &i), DSC_ERROR_OK);
+        }
+        EXPECT_EQ(*static_cast<int *>(deque_back(deque)), 0);
+        EXPECT_EQ(*static_cast<int *>(deque_front(deque)), 2999);
+
+        deque_clear(deque);
+        EXPECT_TRUE(deque_empty(deque));
+        EXPECT_EQ(deque_front(deque), nullptr);
+    }
+    deque_shrink_to_fit(deque);
+    EXPECT_EQ(deque->spare_count, 0u);
+}
+
+TEST(DequeElementTest, LargeElements) {
+    struct Large {
+        uint64_t id;
+        char payload[1000];
+    };
+    DSCDeque *deque = deque_create(sizeof(Large));
+    ASSERT_NE(deque, nullptr);
+    EXPECT_EQ(deque->block_elements, size_t(DSC_DEQUE_MIN_BLOCK_ELEMENTS));
+
+    for (uint64_t i = 0; i < 100; ++i) {
+        Large element{};
+        element.id = i;
+        element.payload[999] = char(i);
+        ASSERT_EQ(i % 2 ? deque_push_back(deque, &element)
+                        : deque_push_front(deque, &element),
+                  DSC_ERROR_OK);
+    }
+
+    // Even ids were pushed to the front, odd ids to the back.
+    for (size_t i = 0; i < 100; ++i) {
+        auto *element = static_cast<Large *>(deque_at(deque, i));
+        uint64_t expected = i < 50 ? 98 - 2 * i : 2 * (i - 50) + 1;
+        EXPECT_EQ(element->id, expected);
+        EXPECT_EQ(element->payload[999], char(expected));
+    }
+    deque_destroy(deque);
+}
@@ -2,6 +2,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
 #include "libdsc/forward_list.h"
 
 class ForwardListTest : public ::testing::Test {
@@ -10,7 +17,7 @@ class ForwardListTest : public ::testing::Test {
 
     void TearDown() override { forward_list_destroy(list); }
 
-    dsc_forward_list *list;
+    DSCForwardList *list;
 };
 
 TEST_F(ForwardListTest, Create) {
@@ -46,7 +53,7 @@ TEST_F(ForwardListTest, PushMultiple) {
 
     // Values should be in reverse order (5, 4, 3, 2, 1)
     int expected = 5;
-    forward_list_node_t *current = forward_list_begin(list);
+    DSCForwardListNode *current = forward_list_begin(list);
     while (current) {
         int *value = (int *)current->data;
         EXPECT_EQ(*value, expected--);
@@ -69,7 +76,7 @@ TEST_F(ForwardListTest, InsertAfter) {
     }
 
     // List is now: 3 -> 2 -> 1
-    forward_list_node_t *pos = forward_list_begin(list);
+    DSCForwardListNode *pos = forward_list_begin(list);
     int value = 42;
     EXPECT_EQ(forward_list_insert_after(list, pos, &value), DSC_ERROR_OK);
     // List should be: 3 -> 42 -> 2 -> 1
@@ -91,7 +98,7 @@ TEST_F(ForwardListTest, EraseAfter) {
     }
 
     // List is now: 4 -> 3 -> 2 -> 1
-    forward_list_node_t *pos = forward_list_begin(list);
+    DSCForwardListNode *pos = forward_list_begin(list);
     EXPECT_EQ(forward_list_erase_after(list, pos), DSC_ERROR_OK);
     // List should be: 4 -> 2 -> 1
 
@@ -115,6 +122,125 @@ TEST_F(ForwardListTest, Clear) {
     EXPECT_TRUE(forward_list_empty(list));
 }
 
+TEST(ForwardListInlineStorageTest, WideElementsAreAlignedAndIntact) {
+    struct Wide {
+        long double x;
+        char bytes[37];
+    };
+    DSCForwardList *wide = forward_list_create(sizeof(Wide));
+    ASSERT_NE(wide, nullptr);
+
+    for (int i = 0; i < 16; ++i) {
+        Wide value{};
+        value.x = i;
+        memset(value.bytes, i, sizeof(value.bytes));
+        ASSERT_EQ(forward_list_push_front(wide, &value), DSC_ERROR_OK);
+    }
+    for (auto *node = forward_list_begin(wide); node; node = node->next) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(node->data) %
+                      alignof(std::max_align_t),
+                  0u);
+        Wide *value = (Wide *)node->data;
+        EXPECT_EQ(value->bytes[36], (char)value->x);
+    }
+
+    forward_list_destroy(wide);
+}
+
+static int compare_key(void const *a, void const *b) {
+    int x = *static_cast<int const *>(a) / 10;
+    int y = *static_cast<int const *>(b) / 10;
+    return (x > y) - (x < y);
+}
+
+static std::vector<int> contents(DSCForwardList const *list) {
+    std::vector<int> result;
+    for (DSCForwardListNode *node = forward_list_begin(list); node;
+         node = node->next) {
+        result.push_back(*(int *)node->data);
+    }
+    EXPECT_EQ(result.size(), forward_list_size(list));
+    return result;
+}
+
+TEST_F(ForwardListTest, SortIsStable) {
+    std::mt19937 gen(7);
+    std::vector<int> model;
+    for (int i = 0; i < 1000; ++i) {
+        int value = static_cast<int>(gen() % 50) * 10 + i % 10;
+        model.insert(model.begin(), value);
+        ASSERT_EQ(forward_list_push_front(list, &value), DSC_ERROR_OK);
+    }
+
+    ASSERT_EQ(forward_list_sort(list, compare_key), DSC_ERROR_OK);
+    std::stable_sort(model.begin(), model.end(),
+                     [](int a, int b) { return a / 10 < b / 10; });
+    EXPECT_EQ(contents(list), model);
+    EXPECT_EQ(forward_list_sort(list, nullptr), DSC_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(ForwardListTest, Reverse) {
+    for (int i = 0; i < 5; ++i) forward_list_push_front(list, &i);
+    forward_list_reverse(list);
+    EXPECT_EQ(contents(list), (std::vector<int>{0, 1, 2, 3, 4}));
+    forward_list_reverse(nullptr);
+}
+
+TEST_F(ForwardListTest, SpliceAfter) {
+    DSCForwardList *other = forward_list_create(sizeof(int));
+    ASSERT_NE(other, nullptr);
+    for (int i = 2; i >= 0; --i) forward_list_push_front(list, &i);
+    for (int i = 12; i >= 10; --i) forward_list_push_front(other, &i);
+
+    ASSERT_EQ(forward_list_splice_after(list, forward_list_begin(list), other),
+              DSC_ERROR_OK);
+    EXPECT_EQ(contents(list), (std::vector<int>{0, 10, 11, 12, 1, 2}));
+    EXPECT_TRUE(forward_list_empty(other));
+
+    int value = 99;
+    forward_list_push_front(other, &value);
+    ASSERT_EQ(forward_list_splice_after(list, nullptr, other), DSC_ERROR_OK);
+    EXPECT_EQ(contents(list), (std::vector<int>{99, 0, 10, 11, 12, 1, 2}));
+    EXPECT_EQ(forward_list_splice_after(list, nullptr, list),
+              DSC_ERROR_INVALID_ARGUMENT);
+
+    forward_list_destroy(other);
+}
+
+TEST_F(ForwardListTest, SpliceAfterRelinksWithinSharedPool) {
+    DSCPool *pool = pool_create(forward_list_node_size(sizeof(int)));
+    ASSERT_NE(pool, nullptr);
+    DSCForwardList *a = forward_list_create_with_pool(sizeof(int), pool);
+    DSCForwardList *b = forward_list_create_with_pool(sizeof(int), pool);
+    for (int i = 0; i < 3; ++i) forward_list_push_front(a, &i);
+    for (int i = 10; i < 13; ++i) forward_list_push_front(b, &i);
+    DSCForwardListNode *moved = forward_list_begin(b);
+
+    ASSERT_EQ(forward_list_splice_after(a, nullptr, b), DSC_ERROR_OK);
+    EXPECT_EQ(contents(a), (std::vector<int>{12, 11, 10, 2, 1, 0}));
+    EXPECT_EQ(forward_list_begin(a), moved);
+
+    forward_list_destroy(b);
+    forward_list_destroy(a);
+    pool_destroy(pool);
+}
+
+TEST_F(ForwardListTest, Merge) {
+    DSCForwardList *other = forward_list_create(sizeof(int));
+    ASSERT_NE(other, nullptr);
+    for (int value : {51, 50, 30, 10}) forward_list_push_front(list, &value);
+    for (int value : {70, 60, 52, 31, 5}) {
+        forward_list_push_front(other, &value);
+    }
+
+    ASSERT_EQ(forward_list_merge(list, other, compare_key), DSC_ERROR_OK);
+    EXPECT_EQ(contents(list),
+              (std::vector<int>{5, 10, 30, 31, 50, 51, 52, 60, 70}));
+    EXPECT_TRUE(forward_list_empty(other));
+
+    forward_list_destroy(other);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "libdsc/frozen_map.h"
+
+static size_t string_hash(void const *key) {
+    return static_cast<size_t>(
+        dsc_hash_string_seeded(*static_cast<char const *const *>(key), 1));
+}
+
+static int string_compare(void const *a, void const *b) {
+    return strcmp(*static_cast<char const *const *>(a),
+                  *static_cast<char const *const *>(b));
+}
+
+static size_t constant_hash(void const *key) {
+    (void)key;
+    return 42;
+}
+
+static int uint64_compare(void const *a, void const *b) {
+    uint64_t x = *static_cast<uint64_t const *>(a);
+    uint64_t y = *static_cast<uint64_t const *>(b);
+    return x < y ? -1 : x > y;
+}
+
+class FrozenMapTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        map = unordered_map_create(sizeof(uint64_t), sizeof(uint64_t),
+                                   nullptr, nullptr);
+        ASSERT_NE(map, nullptr);
+    }
+
+    void TearDown() override {
+        frozen_map_destroy(frozen);
+        unordered_map_destroy(map);
+    }
+
+    void fill(uint64_t n) {
+        for (uint64_t key = 0; key < n; ++key) {
+            uint64_t value = key * 7 + 1;
+            ASSERT_EQ(unordered_map_insert(map, &key, &value), DSC_ERROR_OK);
+        }
+    }
+
+    DSCUnorderedMap *map;
+    DSCFrozenMap *frozen = nullptr;
+};
+
+TEST_F(FrozenMapTest, Empty) {
+    frozen = unordered_map_freeze(map);
+    ASSERT_NE(frozen, nullptr);
+    EXPECT_EQ(frozen_map_size(frozen), 0u);
+
+    uint64_t key = 1;
+    EXPECT_EQ(frozen_map_find(frozen, &key), nullptr);
+
+    size_t cursor = 0;
+    EXPECT_FALSE(frozen_map_next(frozen, &cursor, nullptr, nullptr));
+}
+
+TEST_F(FrozenMapTest, NullArguments) {
+    EXPECT_EQ(unordered_map_freeze(nullptr), nullptr);
+    EXPECT_EQ(frozen_map_size(nullptr), 0u);
+    EXPECT_EQ(frozen_map_find(nullptr, nullptr), nullptr);
+    frozen_map_destroy(nullptr);
+}
+
+TEST_F(FrozenMapTest, FindsEveryKey) {
+    for (uint64_t n : {1u, 2u, 3u, 17u, 1000u, 100000u}) {
+        unordered_map_clear(map);
+        fill(n);
+
+        frozen_map_destroy(frozen);
+        frozen = unordered_map_freeze(map);
+        ASSERT_NE(frozen, nullptr) << n;
+        EXPECT_EQ(frozen_map_size(frozen), n);
+
+        for (uint64_t key = 0; key < n; ++key) {
+            auto const *value =
+                static_cast<uint64_t const *>(frozen_map_find(frozen, &key));
+            ASSERT_NE(value, nullptr) << key;
+            EXPECT_EQ(*value, key * 7 + 1);
+        }
+        for (uint64_t key = n; key < 2 * n; ++key) {
+            EXPECT_EQ(frozen_map_find(frozen, &key), nullptr);
+        }
+    }
+}
+
+TEST_F(FrozenMapTest, SourceMapIsUnchanged) {
+    fill(500);
+    frozen = unordered_map_freeze(map);
+    ASSERT_NE(frozen, nullptr);
+
+    EXPECT_EQ(unordered_map_size(map), 500u);
+    uint64_t key = 10;
+    ASSERT_NE(unordered_map_find(map, &key), nullptr);
+
+    // Later changes to the map do not reach the frozen copy.
+    uint64_t value = 0;
+    ASSERT_EQ(unordered_map_insert(map, &key, &value), DSC_ERROR_OK);
+    EXPECT_EQ(*static_cast<uint64_t const *>(frozen_map_find(frozen, &key)),
+              71u);
+}
+
+TEST_F(FrozenMapTest, IterationVisitsEveryPairOnce) {
+    fill(2000);
+    frozen = unordered_map_freeze(map);
+    ASSERT_NE(frozen, nullptr);
+
+    std::set<uint64_t> seen;
+    size_t cursor = 0;
+    void const *key;
+    void const *value;
+    while (frozen_map_next(frozen, &cursor, &key, &value)) {
+        uint64_t k = *static_cast<uint64_t const *>(key);
+        EXPECT_EQ(*static_cast<uint64_t const *>(value), k * 7 + 1);
+        EXPECT_TRUE(seen.insert(k).second);
+    }
+    EXPECT_EQ(seen.size(), 2000u);
+}
+
+TEST(FrozenMapStringTest, CustomHashAndCompare) {
+    DSCUnorderedMap *map = unordered_map_create(
+        sizeof(char const *), sizeof(int), string_hash, string_compare);
+    ASSERT_NE(map, nullptr);
+
+    std::vector<std::string> words;
+    for (int i = 0; i < 5000; ++i) words.push_back("word" + std::to_string(i));
+    for (int i = 0; i < 5000; ++i) {
+        char const *key = words[i].c_str();
+        ASSERT_EQ(unordered_map_insert(map, &key, &i), DSC_ERROR_OK);
+    }
+
+    DSCFrozenMap *frozen = unordered_map_freeze(map);
+    ASSERT_NE(frozen, nullptr);
+
+    for (int i = 0; i < 5000; ++i) {
+        std::string copy = words[i];
+        char const *key = copy.c_str();
+        auto const *value =
+            static_cast<int const *>(frozen_map_find(frozen, &key));
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, i);
+    }
+    char const *missing = "word5000";
+    EXPECT_EQ(frozen_map_find(frozen, &missing), nullptr);
+
+    frozen_map_destroy(frozen);
+    unordered_map_destroy(map);
+}
+
+TEST(FrozenMapHashTest, CollidingHashesCannotBeFrozen) {
+    DSCUnorderedMap *map = unordered_map_create(
+        sizeof(uint64_t), sizeof(uint64_t), constant_hash, uint64_compare);
+    ASSERT_NE(map, nullptr);
+
+    uint64_t key = 1;
+    ASSERT_EQ(unordered_map_insert(map, &key, &key), DSC_ERROR_OK);
+    DSCFrozenMap *frozen = unordered_map_freeze(map);
+    EXPECT_NE(frozen, nullptr);
+    frozen_map_destroy(frozen);
+
+    key = 2;
+    ASSERT_EQ(unordered_map_insert(map, &key, &key), DSC_ERROR_OK);
+    EXPECT_EQ(unordered_map_freeze(map), nullptr);
+
+    unordered_map_destroy(map);
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+
+#include "libdsc/hash.h"
+#include "libdsc/unordered_map.h"
+
+static int popcount64(uint64_t x) {
+    int count = 0;
+    while (x) {
+        x &= x - 1;
+        ++count;
+    }
+    return count;
+}
+
+TEST(HashTest, MixersAvalanche) {
+    // Flipping one input bit should flip about half of the output bits
+    long flipped64 = 0;
+    long flipped32 = 0;
+    int const samples = 1000;
+    for (int i = 0; i < samples; ++i) {
+        uint64_t x = static_cast<uint64_t>(i) * 0x9E3779B97F4A7C15ull;
+        int bit = i % 64;
+        flipped64 += popcount64(dsc_hash_mix64(x) ^
+                                dsc_hash_mix64(x ^ (1ull << bit)));
+        uint32_t y = static_cast<uint32_t>(x);
+        flipped32 += popcount64(dsc_hash_mix32(y) ^
+                                dsc_hash_mix32(y ^ (1u << (bit % 32))));
+    }
+    EXPECT_NEAR(static_cast<double>(flipped64) / samples, 32.0, 2.0);
+    EXPECT_NEAR(static_cast<double>(flipped32) / samples, 16.0, 1.5);
+}
+
+TEST(HashTest, SequentialIntsSpreadAcrossBuckets) {
+    // The low bits select the bucket in power-of-two tables
+    std::set<size_t> buckets;
+    for (int i = 0; i < 1024; ++i) {
+        buckets.insert(dsc_hash_int(&i) & 1023);
+    }
+    EXPECT_GT(buckets.size(), 600u);
+}
+
+TEST(HashTest, BytesAllLengths) {
+    unsigned char buffer[130];
+    for (size_t i = 0; i < sizeof(buffer); ++i) {
+        buffer[i] = static_cast<unsigned char>(i * 7 + 1);
+    }
+
+    std::set<uint64_t> hashes;
+    for (size_t len = 0; len <= sizeof(buffer); ++len) {
+        uint64_t h = dsc_hash_bytes(buffer, len, DSC_HASH_DEFAULT_SEED);
+        EXPECT_EQ(h, dsc_hash_bytes(buffer, len, DSC_HASH_DEFAULT_SEED));
+        hashes.insert(h);
+    }
+    EXPECT_EQ(hashes.size(), sizeof(buffer) + 1);
+}
+
+TEST(HashTest, BytesSensitiveToEveryByteAndSeed) {
+    unsigned char buffer[64] = {0};
+    uint64_t base = dsc_hash_bytes(buffer, sizeof(buffer), 1);
+    for (size_t i = 0; i < sizeof(buffer); ++i) {
+        buffer[i] = 1;
+        EXPECT_NE(dsc_hash_bytes(buffer, sizeof(buffer), 1), base);
+        buffer[i] = 0;
+    }
+    EXPECT_NE(dsc_hash_bytes(buffer, sizeof(buffer), 2), base);
+}
+
+TEST(HashTest, StringMatchesBytes) {
+    char const *str = "the quick brown fox";
+    EXPECT_EQ(dsc_hash_string_seeded(str, 42),
+              dsc_hash_bytes(str, strlen(str), 42));
+    EXPECT_EQ(dsc_hash_string(&str),
+              static_cast<size_t>(
+                  dsc_hash_string_seeded(str, DSC_HASH_DEFAULT_SEED)));
+}
+
+TEST(HashTest, MapWithDefaultByteHash) {
+    struct Point {
+        int x;
+        int y;
+    };
+
+    DSCUnorderedMap *map =
+        unordered_map_create(sizeof(Point), sizeof(int), nullptr, nullptr);
+    ASSERT_NE(map, nullptr);
+
+    for (int i = 0; i < 1000; ++i) {
+        Point p = {i, -i};
+        ASSERT_EQ(unordered_map_insert(map, &p, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        Point p = {i, -i};
+        int *found = static_cast<int *>(unordered_map_find(map, &p));
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, i);
+    }
+    Point missing = {1, 1};
+    EXPECT_EQ(unordered_map_find(map, &missing), nullptr);
+    unordered_map_destroy(map);
+
+    // Only one of the two functions may not be defaulted
+    EXPECT_EQ(unordered_map_create(sizeof(int), sizeof(int), dsc_hash_int,
+                                   nullptr),
+              nullptr);
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
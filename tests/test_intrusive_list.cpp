@@ -0,0 +1,291 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "libdsc/intrusive_list.h"
+
+struct Timer {
+    int id;
+    DSCIListHook hook;
+    DSCISListHook slist_hook;
+};
+
+static std::vector<int> ids(DSCIList const *list) {
+    std::vector<int> result;
+    for (DSCIListHook *hook = ilist_front(list); hook;
+         hook = ilist_next(list, hook)) {
+        result.push_back(DSC_CONTAINER_OF(hook, Timer, hook)->id);
+    }
+    return result;
+}
+
+static std::vector<int> reverse_ids(DSCIList const *list) {
+    std::vector<int> result;
+    for (DSCIListHook *hook = ilist_back(list); hook;
+         hook = ilist_prev(list, hook)) {
+        result.push_back(DSC_CONTAINER_OF(hook, Timer, hook)->id);
+    }
+    return result;
+}
+
+static std::vector<int> ids(DSCISList const *list) {
+    std::vector<int> result;
+    for (DSCISListHook *hook = islist_front(list); hook; hook = hook->next) {
+        result.push_back(DSC_CONTAINER_OF(hook, Timer, slist_hook)->id);
+    }
+    return result;
+}
+
+class IntrusiveListTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        ilist_init(&list);
+        ilist_init(&other);
+        islist_init(&slist);
+        islist_init(&slist_other);
+        for (int i = 0; i < 8; ++i) {
+            timers[i].id = i;
+            ilist_hook_init(&timers[i].hook);
+            islist_hook_init(&timers[i].slist_hook);
+        }
+    }
+
+    Timer timers[8];
+    DSCIList list;
+    DSCIList other;
+    DSCISList slist;
+    DSCISList slist_other;
+};
+
+TEST_F(IntrusiveListTest, Empty) {
+    EXPECT_TRUE(ilist_empty(&list));
+    EXPECT_EQ(ilist_size(&list), 0u);
+    EXPECT_EQ(ilist_front(&list), nullptr);
+    EXPECT_EQ(ilist_back(&list), nullptr);
+    EXPECT_EQ(ilist_pop_front(&list), nullptr);
+    EXPECT_EQ(ilist_pop_back(&list), nullptr);
+    EXPECT_TRUE(ilist_empty(nullptr));
+}
+
+TEST_F(IntrusiveListTest, PushAndPop) {
+    ASSERT_EQ(ilist_push_back(&list, &timers[1].hook), DSC_ERROR_OK);
+    ASSERT_EQ(ilist_push_back(&list, &timers[2].hook), DSC_ERROR_OK);
+    ASSERT_EQ(ilist_push_front(&list, &timers[0].hook), DSC_ERROR_OK);
+    EXPECT_EQ(ilist_size(&list), 3u);
+    EXPECT_EQ(ids(&list), (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(reverse_ids(&list), (std::vector<int>{2, 1, 0}));
+
+    EXPECT_EQ(ilist_pop_front(&list), &timers[0].hook);
+    EXPECT_EQ(ilist_pop_back(&list), &timers[2].hook);
+    EXPECT_FALSE(ilist_hook_linked(&timers[0].hook));
+    EXPECT_FALSE(ilist_hook_linked(&timers[2].hook));
+    EXPECT_TRUE(ilist_hook_linked(&timers[1].hook));
+    EXPECT_EQ(ids(&list), (std::vector<int>{1}));
+}
+
+TEST_F(IntrusiveListTest, RejectsLinkedHook) {
+    ASSERT_EQ(ilist_push_back(&list, &timers[0].hook), DSC_ERROR_OK);
+    EXPECT_EQ(ilist_push_back(&other, &timers[0].hook),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(ilist_push_front(&list, &timers[0].hook),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(ilist_erase(&list, &timers[1].hook),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(ilist_push_back(nullptr, &timers[1].hook),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(ilist_size(&list), 1u);
+}
+
+TEST_F(IntrusiveListTest, InsertAndErase) {
+    ilist_push_back(&list, &timers[0].hook);
+    ilist_push_back(&list, &timers[2].hook);
+    ASSERT_EQ(ilist_insert(&list, &timers[2].hook, &timers[1].hook),
+              DSC_ERROR_OK);
+    ASSERT_EQ(ilist_insert(&list, nullptr, &timers[3].hook), DSC_ERROR_OK);
+    EXPECT_EQ(ids(&list), (std::vector<int>{0, 1, 2, 3}));
+
+    ASSERT_EQ(ilist_erase(&list, &timers[1].hook), DSC_ERROR_OK);
+    ASSERT_EQ(ilist_erase(&list, &timers[3].hook), DSC_ERROR_OK);
+    EXPECT_EQ(ids(&list), (std::vector<int>{0, 2}));
+    EXPECT_EQ(ilist_size(&list), 2u);
+
+    // An erased hook can be linked again.
+    ASSERT_EQ(ilist_push_front(&list, &timers[1].hook), DSC_ERROR_OK);
+    EXPECT_EQ(ids(&list), (std::vector<int>{1, 0, 2}));
+}
+
+TEST_F(IntrusiveListTest, EraseWhileIterating) {
+    for (auto &timer : timers) ilist_push_back(&list, &timer.hook);
+
+    DSCIListHook *next;
+    for (DSCIListHook *hook = ilist_front(&list); hook; hook = next) {
+        next = ilist_next(&list, hook);
+        if (DSC_CONTAINER_OF(hook, Timer, hook)->id % 2 == 0) {
+            ASSERT_EQ(ilist_erase(&list, hook), DSC_ERROR_OK);
+        }
+    }
+    EXPECT_EQ(ids(&list), (std::vector<int>{1, 3, 5, 7}));
+}
+
+TEST_F(IntrusiveListTest, Splice) {
+    for (int i = 0; i < 4; ++i) ilist_push_back(&list, &timers[i].hook);
+    for (int i = 4; i < 8; ++i) ilist_push_back(&other, &timers[i].hook);
+
+    ilist_splice(&list, &timers[2].hook, &other);
+    EXPECT_EQ(ids(&list), (std::vector<int>{0, 1, 4, 5, 6, 7, 2, 3}));
+    EXPECT_EQ(reverse_ids(&list),
+              (std::vector<int>{3, 2, 7, 6, 5, 4, 1, 0}));
+    EXPECT_EQ(ilist_size(&list), 8u);
+    EXPECT_TRUE(ilist_empty(&other));
+
+    ilist_splice(&other, nullptr, &list);
+    EXPECT_EQ(ids(&other), (std::vector<int>{0, 1, 4, 5, 6, 7, 2, 3}));
+    EXPECT_TRUE(ilist_empty(&list));
+
+    // Splicing an empty list changes nothing.
+    EXPECT_EQ(ilist_splice(&other, nullptr, &list), DSC_ERROR_OK);
+    EXPECT_EQ(ilist_size(&other), 8u);
+
+    // A list cannot be spliced into itself.
+    EXPECT_EQ(ilist_splice(&other, &timers[4].hook, &other),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(ilist_splice(nullptr, nullptr, &other),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(ids(&other), (std::vector<int>{0, 1, 4, 5, 6, 7, 2, 3}));
+    EXPECT_EQ(reverse_ids(&other),
+              (std::vector<int>{3, 2, 7, 6, 5, 4, 1, 0}));
+}
+
+TEST_F(IntrusiveListTest, SpliceElement) {
+    for (int i = 0; i < 4; ++i) ilist_push_back(&list, &timers[i].hook);
+    ilist_push_back(&other, &timers[4].hook);
+
+    ilist_splice_element(&other, &timers[4].hook, &list, &timers[1].hook);
+    EXPECT_EQ(ids(&list), (std::vector<int>{0, 2, 3}));
+    EXPECT_EQ(ids(&other), (std::vector<int>{1, 4}));
+
+    // Within one list: move to the back.
+    ilist_splice_element(&list, nullptr, &list, &timers[0].hook);
+    EXPECT_EQ(ids(&list), (std::vector<int>{2, 3, 0}));
+    EXPECT_EQ(ilist_size(&list), 3u);
+}
+
+TEST_F(IntrusiveListTest, ClearUnlinksHooks) {
+    for (auto &timer : timers) ilist_push_back(&list, &timer.hook);
+    ilist_clear(&list);
+    EXPECT_TRUE(ilist_empty(&list));
+    for (auto &timer : timers) {
+        EXPECT_FALSE(ilist_hook_linked(&timer.hook));
+    }
+}
+
+TEST_F(IntrusiveListTest, SeveralHooksPerElement) {
+    for (auto &timer : timers) {
+        ilist_push_back(&list, &timer.hook);
+        islist_push_front(&slist, &timer.slist_hook);
+    }
+    EXPECT_EQ(ids(&list), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+    EXPECT_EQ(ids(&slist), (std::vector<int>{7, 6, 5, 4, 3, 2, 1, 0}));
+}
+
+TEST_F(IntrusiveListTest, SListPushPop) {
+    EXPECT_EQ(islist_pop_front(&slist), nullptr);
+    ASSERT_EQ(islist_push_back(&slist, &timers[1].slist_hook), DSC_ERROR_OK);
+    ASSERT_EQ(islist_push_front(&slist, &timers[0].slist_hook), DSC_ERROR_OK);
+    ASSERT_EQ(islist_push_back(&slist, &timers[2].slist_hook), DSC_ERROR_OK);
+    EXPECT_EQ(ids(&slist), (std::vector<int>{0, 1, 2}));
+    EXPECT_EQ(islist_back(&slist), &timers[2].slist_hook);
+    EXPECT_EQ(islist_size(&slist), 3u);
+
+    EXPECT_EQ(islist_pop_front(&slist), &timers[0].slist_hook);
+    EXPECT_EQ(islist_pop_front(&slist), &timers[1].slist_hook);
+    EXPECT_EQ(islist_pop_front(&slist), &timers[2].slist_hook);
+    EXPECT_FALSE(islist_hook_linked(&timers[2].slist_hook));
+    EXPECT_TRUE(islist_empty(&slist));
+    EXPECT_EQ(islist_back(&slist), nullptr);
+    EXPECT_EQ(islist_push_back(nullptr, &timers[0].slist_hook),
+              DSC_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(IntrusiveListTest, SListRejectsLinkedHook) {
+    EXPECT_FALSE(islist_hook_linked(&timers[0].slist_hook));
+    ASSERT_EQ(islist_push_back(&slist, &timers[0].slist_hook), DSC_ERROR_OK);
+    ASSERT_EQ(islist_push_back(&slist, &timers[1].slist_hook), DSC_ERROR_OK);
+
+    // The tail is linked too, although its next pointer is NULL.
+    EXPECT_TRUE(islist_hook_linked(&timers[0].slist_hook));
+    EXPECT_TRUE(islist_hook_linked(&timers[1].slist_hook));
+    EXPECT_EQ(islist_push_back(&slist_other, &timers[1].slist_hook),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(islist_push_front(&slist, &timers[0].slist_hook),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(islist_insert_after(&slist, &timers[1].slist_hook,
+                                  &timers[0].slist_hook),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(islist_size(&slist), 2u);
+    EXPECT_EQ(ids(&slist), (std::vector<int>{0, 1}));
+    EXPECT_TRUE(islist_empty(&slist_other));
+
+    // Once removed, a hook can be linked again.
+    EXPECT_EQ(islist_erase_after(&slist, &timers[0].slist_hook),
+              &timers[1].slist_hook);
+    EXPECT_EQ(islist_push_front(&slist, &timers[1].slist_hook), DSC_ERROR_OK);
+    EXPECT_EQ(ids(&slist), (std::vector<int>{1, 0}));
+}
+
+TEST_F(IntrusiveListTest, SListInsertAndEraseAfter) {
+    islist_push_back(&slist, &timers[0].slist_hook);
+    islist_push_back(&slist, &timers[2].slist_hook);
+    ASSERT_EQ(islist_insert_after(&slist, &timers[0].slist_hook,
+                                  &timers[1].slist_hook),
+              DSC_ERROR_OK);
+    ASSERT_EQ(islist_insert_after(&slist, &timers[2].slist_hook,
+                                  &timers[3].slist_hook),
+              DSC_ERROR_OK);
+    EXPECT_EQ(islist_back(&slist), &timers[3].slist_hook);
+    EXPECT_EQ(ids(&slist), (std::vector<int>{0, 1, 2, 3}));
+
+    // Removing the last hook moves the tail back.
+    EXPECT_EQ(islist_erase_after(&slist, &timers[2].slist_hook),
+              &timers[3].slist_hook);
+    EXPECT_EQ(islist_back(&slist), &timers[2].slist_hook);
+    EXPECT_EQ(islist_erase_after(&slist, &timers[2].slist_hook), nullptr);
+    EXPECT_EQ(islist_erase_after(&slist, nullptr), &timers[0].slist_hook);
+    EXPECT_EQ(ids(&slist), (std::vector<int>{1, 2}));
+
+    islist_push_back(&slist, &timers[4].slist_hook);
+    EXPECT_EQ(ids(&slist), (std::vector<int>{1, 2, 4}));
+}
+
+TEST_F(IntrusiveListTest, SListSpliceAfter) {
+    for (int i = 0; i < 3; ++i) {
+        islist_push_back(&slist, &timers[i].slist_hook);
+    }
+    for (int i = 3; i < 6; ++i) {
+        islist_push_back(&slist_other, &timers[i].slist_hook);
+    }
+
+    islist_splice_after(&slist, &timers[0].slist_hook, &slist_other);
+    EXPECT_EQ(ids(&slist), (std::vector<int>{0, 3, 4, 5, 1, 2}));
+    EXPECT_EQ(islist_size(&slist), 6u);
+    EXPECT_TRUE(islist_empty(&slist_other));
+
+    islist_push_back(&slist_other, &timers[6].slist_hook);
+    islist_splice_after(&slist, islist_back(&slist), &slist_other);
+    EXPECT_EQ(islist_back(&slist), &timers[6].slist_hook);
+
+    islist_splice_after(&slist_other, nullptr, &slist);
+    EXPECT_EQ(ids(&slist_other), (std::vector<int>{0, 3, 4, 5, 1, 2, 6}));
+    EXPECT_EQ(islist_back(&slist_other), &timers[6].slist_hook);
+
+    // A list cannot be spliced into itself.
+    EXPECT_EQ(islist_splice_after(&slist_other, &timers[0].slist_hook,
+                                  &slist_other),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(islist_splice_after(&slist_other, nullptr, nullptr),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(ids(&slist_other), (std::vector<int>{0, 3, 4, 5, 1, 2, 6}));
+    EXPECT_EQ(islist_size(&slist_other), 7u);
+}
@@ -2,6 +2,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
 #include "libdsc/list.h"
 
 class ListTest : public ::testing::Test {
@@ -10,7 +17,7 @@ class ListTest : public ::testing::Test {
 
     void TearDown() override { list_destroy(list); }
 
-    dsc_list *list;
+    DSCList *list;
 };
 
 TEST_F(ListTest, Create) {
@@ -59,7 +66,7 @@ TEST_F(ListTest, PushMultiple) {
 
     // Values should be in order (1, 2, 3, 4, 5)
     int expected = 1;
-    list_node_t *current = list_begin(list);
+    DSCListNode *current = list_begin(list);
     while (current) {
         int *value = (int *)current->data;
         EXPECT_EQ(*value, expected++);
@@ -95,7 +102,7 @@ TEST_F(ListTest, Insert) {
     }
 
     // List is now: 1 -> 2 -> 3
-    list_node_t *pos = list_begin(list);
+    DSCListNode *pos = list_begin(list);
     int value = 42;
     EXPECT_EQ(list_insert(list, pos, &value), DSC_ERROR_OK);
     // List should be: 42 -> 1 -> 2 -> 3
@@ -117,7 +124,7 @@ TEST_F(ListTest, Erase) {
     }
 
     // List is now: 1 -> 2 -> 3 -> 4
-    list_node_t *pos = list_begin(list);
+    DSCListNode *pos = list_begin(list);
     pos = pos->next;  // Move to 2
     EXPECT_EQ(list_erase(list, pos), DSC_ERROR_OK);
     // List should be: 1 -> 3 -> 4
@@ -142,6 +149,158 @@ TEST_F(ListTest, Clear) {
     EXPECT_TRUE(list_empty(list));
 }
 
+TEST(ListInlineStorageTest, WideElementsAreAlignedAndIntact) {
+    struct Wide {
+        long double x;
+        char bytes[37];
+    };
+    DSCList *wide = list_create(sizeof(Wide));
+    ASSERT_NE(wide, nullptr);
+
+    for (int i = 0; i < 16; ++i) {
+        Wide value{};
+        value.x = i;
+        memset(value.bytes, i, sizeof(value.bytes));
+        ASSERT_EQ(list_push_back(wide, &value), DSC_ERROR_OK);
+    }
+    for (auto *node = list_begin(wide); node; node = node->next) {
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(node->data) %
+                      alignof(std::max_align_t),
+                  0u);
+        Wide *value = (Wide *)node->data;
+        EXPECT_EQ(value->bytes[36], (char)value->x);
+    }
+
+    list_destroy(wide);
+}
+
+static int compare_key(void const *a, void const *b) {
+    int x = *static_cast<int const *>(a) / 10;
+    int y = *static_cast<int const *>(b) / 10;
+    return (x > y) - (x < y);
+}
+
+static std::vector<int> contents(DSCList const *list) {
+    std::vector<int> result;
+    for (DSCListNode *node = list_begin(list); node; node = node->next) {
+        result.push_back(*(int *)node->data);
+    }
+    // The prev links must mirror the next links.
+    std::vector<int> backwards;
+    for (DSCListNode *node = list_rbegin(list); node; node = node->prev) {
+        backwards.insert(backwards.begin(), *(int *)node->data);
+    }
+    EXPECT_EQ(result, backwards);
+    EXPECT_EQ(result.size(), list_size(list));
+    return result;
+}
+
+TEST_F(ListTest, SortIsStable) {
+    std::mt19937 gen(7);
+    std::vector<int> model;
+    for (int i = 0; i < 1000; ++i) {
+        // Only the tens are compared, so the units tell equal keys apart.
+        int value = static_cast<int>(gen() % 50) * 10 + i % 10;
+        model.push_back(value);
+        ASSERT_EQ(list_push_back(list, &value), DSC_ERROR_OK);
+    }
+    DSCListNode *node = list_begin(list);
+
+    ASSERT_EQ(list_sort(list, compare_key), DSC_ERROR_OK);
+    std::stable_sort(model.begin(), model.end(),
+                     [](int a, int b) { return a / 10 < b / 10; });
+    EXPECT_EQ(contents(list), model);
+
+    // Nodes are relinked, not copied.
+    bool found = false;
+    for (DSCListNode *it = list_begin(list); it; it = it->next) {
+        found = found || it == node;
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST_F(ListTest, SortSmallAndInvalid) {
+    EXPECT_EQ(list_sort(list, dsc_compare_int), DSC_ERROR_OK);
+    int value = 3;
+    list_push_back(list, &value);
+    EXPECT_EQ(list_sort(list, dsc_compare_int), DSC_ERROR_OK);
+    EXPECT_EQ(contents(list), std::vector<int>{3});
+    EXPECT_EQ(list_sort(nullptr, dsc_compare_int),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(list_sort(list, nullptr), DSC_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(ListTest, Reverse) {
+    for (int i = 0; i < 5; ++i) list_push_back(list, &i);
+    list_reverse(list);
+    EXPECT_EQ(contents(list), (std::vector<int>{4, 3, 2, 1, 0}));
+    list_reverse(nullptr);
+}
+
+TEST_F(ListTest, SpliceCopiesBetweenPools) {
+    DSCList *other = list_create(sizeof(int));
+    ASSERT_NE(other, nullptr);
+    for (int i = 0; i < 3; ++i) list_push_back(list, &i);
+    for (int i = 10; i < 13; ++i) list_push_back(other, &i);
+
+    ASSERT_EQ(list_splice(list, list_begin(list)->next, other), DSC_ERROR_OK);
+    EXPECT_EQ(contents(list), (std::vector<int>{0, 10, 11, 12, 1, 2}));
+    EXPECT_TRUE(list_empty(other));
+
+    // The source stays usable.
+    int value = 99;
+    ASSERT_EQ(list_push_back(other, &value), DSC_ERROR_OK);
+    ASSERT_EQ(list_splice(list, nullptr, other), DSC_ERROR_OK);
+    EXPECT_EQ(contents(list), (std::vector<int>{0, 10, 11, 12, 1, 2, 99}));
+
+    list_destroy(other);
+    EXPECT_EQ(*(int *)list_back(list), 99);
+}
+
+TEST_F(ListTest, SpliceRelinksWithinSharedPool) {
+    DSCPool *pool = pool_create(list_node_size(sizeof(int)));
+    ASSERT_NE(pool, nullptr);
+    DSCList *a = list_create_with_pool(sizeof(int), pool);
+    DSCList *b = list_create_with_pool(sizeof(int), pool);
+    for (int i = 0; i < 3; ++i) list_push_back(a, &i);
+    for (int i = 10; i < 13; ++i) list_push_back(b, &i);
+    DSCListNode *moved = list_begin(b);
+
+    ASSERT_EQ(list_splice(a, list_begin(a), b), DSC_ERROR_OK);
+    EXPECT_EQ(contents(a), (std::vector<int>{10, 11, 12, 0, 1, 2}));
+    EXPECT_EQ(list_begin(a), moved);
+    EXPECT_TRUE(list_empty(b));
+
+    list_destroy(b);
+    list_destroy(a);
+    pool_destroy(pool);
+}
+
+TEST_F(ListTest, SpliceInvalid) {
+    DSCList *wide = list_create(sizeof(double));
+    EXPECT_EQ(list_splice(list, nullptr, list), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(list_splice(list, nullptr, wide), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(list_splice(nullptr, nullptr, list),
+              DSC_ERROR_INVALID_ARGUMENT);
+    list_destroy(wide);
+}
+
+TEST_F(ListTest, Merge) {
+    DSCList *other = list_create(sizeof(int));
+    ASSERT_NE(other, nullptr);
+    for (int value : {10, 30, 50, 51}) list_push_back(list, &value);
+    for (int value : {5, 31, 52, 60, 70}) list_push_back(other, &value);
+
+    ASSERT_EQ(list_merge(list, other, compare_key), DSC_ERROR_OK);
+    // Ties keep elements of the destination first.
+    EXPECT_EQ(contents(list),
+              (std::vector<int>{5, 10, 30, 31, 50, 51, 52, 60, 70}));
+    EXPECT_TRUE(list_empty(other));
+    EXPECT_EQ(list_merge(list, other, nullptr), DSC_ERROR_INVALID_ARGUMENT);
+
+    list_destroy(other);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "libdsc/mpmc_queue.h"
+
+class MpmcQueueTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        queue = mpmc_queue_create(sizeof(int), 8);
+        ASSERT_NE(queue, nullptr);
+    }
+
+    void TearDown() override { mpmc_queue_destroy(queue); }
+
+    DSCMpmcQueue *queue;
+};
+
+TEST_F(MpmcQueueTest, Create) {
+    EXPECT_EQ(mpmc_queue_capacity(queue), 8u);
+    EXPECT_EQ(mpmc_queue_size(queue), 0u);
+    EXPECT_TRUE(mpmc_queue_empty(queue));
+
+    DSCMpmcQueue *small = mpmc_queue_create(sizeof(int), 1);
+    ASSERT_NE(small, nullptr);
+    EXPECT_EQ(mpmc_queue_capacity(small), 2u);
+    mpmc_queue_destroy(small);
+}
+
+TEST_F(MpmcQueueTest, InvalidArguments) {
+    int value = 1;
+    EXPECT_EQ(mpmc_queue_create(0, 8), nullptr);
+    EXPECT_EQ(mpmc_queue_create(sizeof(int), 0), nullptr);
+    EXPECT_EQ(mpmc_queue_create(SIZE_MAX / 2, 4), nullptr);
+    EXPECT_EQ(mpmc_queue_push(nullptr, &value), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mpmc_queue_push(queue, nullptr), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mpmc_queue_pop(queue, nullptr), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mpmc_queue_push_wait(queue, nullptr, 0),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mpmc_queue_pop_wait(nullptr, &value, 0),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(mpmc_queue_capacity(nullptr), 0u);
+    mpmc_queue_destroy(nullptr);
+}
+
+TEST_F(MpmcQueueTest, FullAndEmpty) {
+    int out;
+    EXPECT_EQ(mpmc_queue_pop(queue, &out), DSC_ERROR_EMPTY);
+
+    // Several rounds so every slot goes through several laps.
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            int value = round * 8 + i;
+            ASSERT_EQ(mpmc_queue_push(queue, &value), DSC_ERROR_OK);
+        }
+        int extra = -1;
+        EXPECT_EQ(mpmc_queue_push(queue, &extra), DSC_ERROR_FULL);
+        EXPECT_EQ(mpmc_queue_size(queue), 8u);
+
+        for (int i = 0; i < 8; ++i) {
+            ASSERT_EQ(mpmc_queue_pop(queue, &out), DSC_ERROR_OK);
+            EXPECT_EQ(out, round * 8 + i);
+        }
+        EXPECT_EQ(mpmc_queue_pop(queue, &out), DSC_ERROR_EMPTY);
+    }
+}
+
+TEST_F(MpmcQueueTest, WideElements) {
+    struct Wide {
+        long double value;
+        char tag[40];
+    };
+    DSCMpmcQueue *wide = mpmc_queue_create(sizeof(Wide), 4);
+    ASSERT_NE(wide, nullptr);
+    for (int i = 0; i < 4; ++i) {
+        Wide element{};
+        element.value = i;
+        element.tag[39] = static_cast<char>('a' + i);
+        ASSERT_EQ(mpmc_queue_push(wide, &element), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 4; ++i) {
+        Wide element;
+        ASSERT_EQ(mpmc_queue_pop(wide, &element), DSC_ERROR_OK);
+        EXPECT_EQ(element.value, i);
+        EXPECT_EQ(element.tag[39], 'a' + i);
+    }
+    mpmc_queue_destroy(wide);
+}
+
+TEST_F(MpmcQueueTest, WaitTimesOut) {
+    int out;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(mpmc_queue_pop_wait(queue, &out, 20000000), DSC_ERROR_EMPTY);
+    EXPECT_GE(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(20));
+    EXPECT_EQ(mpmc_queue_pop_wait(queue, &out, 0), DSC_ERROR_EMPTY);
+
+    for (int i = 0; i < 8; ++i) mpmc_queue_push(queue, &i);
+    int value = 8;
+    EXPECT_EQ(mpmc_queue_push_wait(queue, &value, 1000000), DSC_ERROR_FULL);
+}
+
+TEST_F(MpmcQueueTest, WaitIsWokenByOtherSide) {
+    int out = 0;
+    std::thread producer([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        int value = 42;
+        mpmc_queue_push(queue, &value);
+    });
+    EXPECT_EQ(mpmc_queue_pop_wait(queue, &out, -1), DSC_ERROR_OK);
+    EXPECT_EQ(out, 42);
+    producer.join();
+
+    for (int i = 0; i < 8; ++i) mpmc_queue_push(queue, &i);
+    std::thread consumer([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        int value;
+        mpmc_queue_pop(queue, &value);
+    });
+    int value = 8;
+    EXPECT_EQ(mpmc_queue_push_wait(queue, &value, -1), DSC_ERROR_OK);
+    consumer.join();
+}
+
+TEST(MpmcQueueThreadTest, EveryElementArrivesOnce) {
+    constexpr int kProducers = 4;
+    constexpr int kConsumers = 4;
+    constexpr uint64_t kPerProducer = 1 << 16;
+    DSCMpmcQueue *queue = mpmc_queue_create(sizeof(uint64_t), 64);
+    ASSERT_NE(queue, nullptr);
+
+    // Elements encode their producer and sequence number; each consumer
+    // checks that it sees every producer's elements in order.
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([queue, p] {
+            for (uint64_t i = 0; i < kPerProducer; ++i) {
+                uint64_t value = (uint64_t(p) << 32) | i;
+                ASSERT_EQ(mpmc_queue_push_wait(queue, &value, -1),
+                          DSC_ERROR_OK);
+            }
+        });
+    }
+
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<bool> in_order{true};
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            uint64_t last[kProducers];
+            for (auto &value : last) value = UINT64_MAX;
+            uint64_t local_sum = 0;
+            // The timeout lets idle consumers notice that all is done.
+            while (received < kProducers * kPerProducer) {
+                uint64_t value;
+                if (mpmc_queue_pop_wait(queue, &value, 1000000) !=
+                    DSC_ERROR_OK) {
+                    continue;
+                }
+                uint64_t p = value >> 32, i = value & 0xffffffff;
+                if (last[p] != UINT64_MAX && i <= last[p]) in_order = false;
+                last[p] = i;
+                local_sum += i;
+                ++received;
+            }
+            sum += local_sum;
+        });
+    }
+    for (auto &thread : threads) thread.join();
+
+    EXPECT_EQ(received.load(), kProducers * kPerProducer);
+    EXPECT_EQ(sum.load(),
+              kProducers * (kPerProducer * (kPerProducer - 1) / 2));
+    EXPECT_TRUE(in_order.load());
+    EXPECT_TRUE(mpmc_queue_empty(queue));
+    mpmc_queue_destroy(queue);
+}
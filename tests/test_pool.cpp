@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+
+#include "libdsc/forward_list.h"
+#include "libdsc/list.h"
+#include "libdsc/pool.h"
+
+class PoolTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        pool = pool_create(24);
+        ASSERT_NE(pool, nullptr);
+    }
+
+    void TearDown() override { pool_destroy(pool); }
+
+    DSCPool *pool;
+};
+
+TEST_F(PoolTest, Create) {
+    EXPECT_EQ(pool_block_size(pool) % alignof(std::max_align_t), 0u);
+    EXPECT_GE(pool_block_size(pool), 24u);
+    EXPECT_EQ(pool_capacity(pool), 0u);
+}
+
+TEST_F(PoolTest, InvalidArguments) {
+    EXPECT_EQ(pool_create(0), nullptr);
+    EXPECT_EQ(pool_create(SIZE_MAX), nullptr);
+    EXPECT_EQ(pool_allocate(nullptr), nullptr);
+    EXPECT_EQ(pool_block_size(nullptr), 0u);
+    EXPECT_EQ(pool_capacity(nullptr), 0u);
+    pool_deallocate(pool, nullptr);
+    pool_reset(nullptr);
+    pool_destroy(nullptr);
+}
+
+TEST_F(PoolTest, BlocksAreDistinctAndAligned) {
+    std::set<void *> blocks;
+    for (int i = 0; i < 1000; ++i) {
+        void *block = pool_allocate(pool);
+        ASSERT_NE(block, nullptr);
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(block) %
+                      alignof(std::max_align_t),
+                  0u);
+        memset(block, i, pool_block_size(pool));
+        EXPECT_TRUE(blocks.insert(block).second);
+    }
+    EXPECT_GE(pool_capacity(pool), 1000u);
+}
+
+TEST_F(PoolTest, SlabsGrow) {
+    pool_allocate(pool);
+    EXPECT_EQ(pool_capacity(pool), size_t{DSC_POOL_MIN_SLAB_BLOCKS});
+
+    for (int i = 1; i <= DSC_POOL_MIN_SLAB_BLOCKS; ++i) pool_allocate(pool);
+    EXPECT_EQ(pool_capacity(pool), size_t{3 * DSC_POOL_MIN_SLAB_BLOCKS});
+}
+
+TEST_F(PoolTest, DeallocatedBlocksAreReused) {
+    void *a = pool_allocate(pool);
+    void *b = pool_allocate(pool);
+    pool_deallocate(pool, a);
+    pool_deallocate(pool, b);
+
+    EXPECT_EQ(pool_allocate(pool), b);
+    EXPECT_EQ(pool_allocate(pool), a);
+}
+
+TEST_F(PoolTest, SteadyStateDoesNotGrow) {
+    void *blocks[100];
+    for (auto &block : blocks) block = pool_allocate(pool);
+    size_t capacity = pool_capacity(pool);
+
+    for (int round = 0; round < 10; ++round) {
+        for (auto &block : blocks) pool_deallocate(pool, block);
+        for (auto &block : blocks) block = pool_allocate(pool);
+    }
+    EXPECT_EQ(pool_capacity(pool), capacity);
+}
+
+TEST_F(PoolTest, ResetReusesSlabs) {
+    void *first = pool_allocate(pool);
+    for (int i = 0; i < 100; ++i) pool_allocate(pool);
+    size_t capacity = pool_capacity(pool);
+
+    pool_reset(pool);
+    EXPECT_EQ(pool_allocate(pool), first);
+    for (int i = 0; i < 100; ++i) pool_allocate(pool);
+    EXPECT_EQ(pool_capacity(pool), capacity);
+}
+
+TEST_F(PoolTest, SharedBetweenLists) {
+    DSCPool *nodes = pool_create(list_node_size(sizeof(int)));
+    ASSERT_NE(nodes, nullptr);
+    DSCList *a = list_create_with_pool(sizeof(int), nodes);
+    DSCList *b = list_create_with_pool(sizeof(int), nodes);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(list_push_back(a, &i), DSC_ERROR_OK);
+    }
+    size_t capacity = pool_capacity(nodes);
+
+    // Nodes freed by a are reused by b.
+    list_clear(a);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(list_push_back(b, &i), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(pool_capacity(nodes), capacity);
+    EXPECT_EQ(*static_cast<int *>(list_back(b)), 99);
+
+    list_destroy(a);
+    list_destroy(b);
+    pool_destroy(nodes);
+}
+
+TEST_F(PoolTest, SharedBetweenForwardLists) {
+    DSCPool *nodes = pool_create(forward_list_node_size(sizeof(double)));
+    ASSERT_NE(nodes, nullptr);
+    DSCForwardList *a = forward_list_create_with_pool(sizeof(double), nodes);
+    DSCForwardList *b = forward_list_create_with_pool(sizeof(double), nodes);
+    ASSERT_NE(a, nullptr);
+    ASSERT_NE(b, nullptr);
+
+    for (int i = 0; i < 50; ++i) {
+        double value = i;
+        ASSERT_EQ(forward_list_push_front(a, &value), DSC_ERROR_OK);
+        ASSERT_EQ(forward_list_push_front(b, &value), DSC_ERROR_OK);
+    }
+    forward_list_destroy(a);
+    EXPECT_EQ(forward_list_size(b), 50u);
+    EXPECT_EQ(*static_cast<double *>(forward_list_front(b)), 49.0);
+
+    forward_list_destroy(b);
+    pool_destroy(nodes);
+}
+
+TEST_F(PoolTest, SharedPoolTooSmall) {
+    DSCPool *nodes = pool_create(list_node_size(sizeof(int)));
+    ASSERT_NE(nodes, nullptr);
+    EXPECT_EQ(list_create_with_pool(256, nodes), nullptr);
+    EXPECT_EQ(forward_list_create_with_pool(256, nodes), nullptr);
+    EXPECT_EQ(list_create_with_pool(sizeof(int), nullptr), nullptr);
+    EXPECT_EQ(list_node_size(SIZE_MAX), 0u);
+    pool_destroy(nodes);
+}
+
+TEST(PoolListTest, OwnedPoolReusedAfterClear) {
+    DSCList *list = list_create(sizeof(int));
+    ASSERT_NE(list, nullptr);
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 500; ++i) {
+            ASSERT_EQ(list_push_back(list, &i), DSC_ERROR_OK);
+        }
+        EXPECT_EQ(list_size(list), 500u);
+        EXPECT_EQ(*static_cast<int *>(list_front(list)), 0);
+        EXPECT_EQ(*static_cast<int *>(list_back(list)), 499);
+        size_t capacity = pool_capacity(list->pool);
+        list_clear(list);
+        EXPECT_TRUE(list_empty(list));
+        EXPECT_EQ(pool_capacity(list->pool), capacity);
+    }
+
+    list_destroy(list);
+}
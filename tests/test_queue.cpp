@@ -2,6 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <vector>
+
 #include "libdsc/queue.h"
 
 class QueueTest : public ::testing::Test {
@@ -17,7 +23,7 @@ class QueueTest : public ::testing::Test {
         }
     }
 
-    dsc_queue *queue;
+    DSCQueue *queue;
 };
 
 TEST_F(QueueTest, Create) {
@@ -94,6 +100,162 @@ TEST_F(QueueTest, Reserve) {
     EXPECT_EQ(*front, value);
 }
 
+TEST_F(QueueTest, CapacityIsPowerOfTwo) {
+    EXPECT_EQ(queue_reserve(queue, 100), DSC_ERROR_OK);
+    EXPECT_EQ(queue->capacity, 128u);
+    EXPECT_EQ(queue_reserve(queue, 129), DSC_ERROR_OK);
+    EXPECT_EQ(queue->capacity, 256u);
+    EXPECT_EQ(queue_reserve(queue, SIZE_MAX), DSC_ERROR_OVERFLOW);
+}
+
+// Reads the queue through its spans.
+static std::vector<int> contents(DSCQueue const *queue) {
+    DSCQueueSpan spans[2];
+    size_t count = queue_front_span(queue, spans);
+    std::vector<int> result;
+    for (size_t i = 0; i < count; ++i) {
+        EXPECT_GT(spans[i].count, 0u);
+        int const *data = static_cast<int const *>(spans[i].data);
+        result.insert(result.end(), data, data + spans[i].count);
+    }
+    EXPECT_EQ(result.size(), queue_size(queue));
+    return result;
+}
+
+TEST_F(QueueTest, GrowsWhenFullAndWrapped) {
+    // Fill the initial buffer with the front in the middle, so the front
+    // and back meet away from index 0.
+    std::vector<int> model;
+    size_t capacity = queue->capacity;
+    for (int i = 0; i < 5; ++i) queue_push(queue, &i);
+    for (int i = 0; i < 5; ++i) queue_pop(queue);
+    for (size_t i = 0; i < capacity + 1; ++i) {
+        int value = static_cast<int>(i);
+        ASSERT_EQ(queue_push(queue, &value), DSC_ERROR_OK);
+        model.push_back(value);
+    }
+    EXPECT_GT(queue->capacity, capacity);
+    EXPECT_EQ(contents(queue), model);
+    EXPECT_EQ(*static_cast<int *>(queue_back(queue)), model.back());
+}
+
+TEST_F(QueueTest, FrontSpanWraps) {
+    DSCQueueSpan spans[2];
+    EXPECT_EQ(queue_front_span(queue, spans), 0u);
+    EXPECT_EQ(queue_front_span(nullptr, spans), 0u);
+
+    size_t capacity = queue->capacity;
+    for (size_t i = 0; i < capacity - 2; ++i) queue_push(queue, &i);
+    ASSERT_EQ(queue_consume(queue, capacity - 4), DSC_ERROR_OK);
+    for (int i = 100; i < 105; ++i) queue_push(queue, &i);
+
+    ASSERT_EQ(queue_front_span(queue, spans), 2u);
+    EXPECT_EQ(spans[0].count, 4u);
+    EXPECT_EQ(spans[1].count, 3u);
+    EXPECT_EQ(spans[0].data, queue_front(queue));
+    EXPECT_EQ(contents(queue),
+              (std::vector<int>{static_cast<int>(capacity) - 4,
+                                static_cast<int>(capacity) - 3, 100, 101,
+                                102, 103, 104}));
+
+    EXPECT_EQ(queue_consume(queue, 8), DSC_ERROR_EMPTY);
+    ASSERT_EQ(queue_consume(queue, 5), DSC_ERROR_OK);
+    EXPECT_EQ(contents(queue), (std::vector<int>{103, 104}));
+}
+
+TEST_F(QueueTest, WriteSpanAndCommit) {
+    DSCQueueSpan spans[2];
+    size_t capacity = queue->capacity;
+    for (size_t i = 0; i < capacity - 3; ++i) queue_push(queue, &i);
+    ASSERT_EQ(queue_consume(queue, capacity - 3), DSC_ERROR_OK);
+
+    // Room for 8 wraps after 3 slots.
+    ASSERT_EQ(queue_write_span(queue, 8, spans), DSC_ERROR_OK);
+    EXPECT_EQ(spans[0].count, 3u);
+    EXPECT_EQ(spans[1].count, 5u);
+    int next = 0;
+    for (auto &span : spans) {
+        for (size_t i = 0; i < span.count; ++i) {
+            static_cast<int *>(span.data)[i] = next++;
+        }
+    }
+    EXPECT_TRUE(queue_empty(queue));
+    ASSERT_EQ(queue_commit(queue, 8), DSC_ERROR_OK);
+    EXPECT_EQ(contents(queue), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7}));
+    EXPECT_EQ(*static_cast<int *>(queue_back(queue)), 7);
+
+    // Asking for more than fits grows the queue first.
+    ASSERT_EQ(queue_write_span(queue, 100, spans), DSC_ERROR_OK);
+    EXPECT_GE(queue->capacity, 108u);
+    EXPECT_EQ(spans[0].count + spans[1].count, 100u);
+    static_cast<int *>(spans[0].data)[0] = 8;
+    ASSERT_EQ(queue_commit(queue, 1), DSC_ERROR_OK);
+    EXPECT_EQ(contents(queue),
+              (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+    EXPECT_EQ(queue_commit(queue, queue->capacity), DSC_ERROR_OVERFLOW);
+    EXPECT_EQ(queue_write_span(nullptr, 1, spans),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(queue_write_span(queue, SIZE_MAX, spans), DSC_ERROR_OVERFLOW);
+}
+
+TEST_F(QueueTest, RandomOperationsMatchModel) {
+    std::mt19937 gen(99);
+    std::deque<int> model;
+    for (int step = 0; step < 20000; ++step) {
+        int value = static_cast<int>(gen());
+        if (gen() % 3 != 0) {
+            ASSERT_EQ(queue_push(queue, &value), DSC_ERROR_OK);
+            model.push_back(value);
+        } else if (!model.empty()) {
+            ASSERT_EQ(*static_cast<int *>(queue_front(queue)), model.front());
+            ASSERT_EQ(queue_pop(queue), DSC_ERROR_OK);
+            model.pop_front();
+        }
+    }
+    EXPECT_EQ(contents(queue), std::vector<int>(model.begin(), model.end()));
+}
+
+TEST_F(QueueTest, PushNAndPopN) {
+    // Offset the front so the bulk copies wrap.
+    size_t capacity = queue->capacity;
+    for (size_t i = 0; i < capacity - 3; ++i) queue_push(queue, &i);
+    ASSERT_EQ(queue_consume(queue, capacity - 3), DSC_ERROR_OK);
+
+    std::vector<int> values(10);
+    std::iota(values.begin(), values.end(), 0);
+    ASSERT_EQ(queue_push_n(queue, values.data(), values.size()),
+              DSC_ERROR_OK);
+    EXPECT_EQ(contents(queue), values);
+
+    int out[4];
+    ASSERT_EQ(queue_pop_n(queue, out, 4), 4u);
+    EXPECT_EQ(std::vector<int>(out, out + 4), (std::vector<int>{0, 1, 2, 3}));
+
+    // A push larger than the free space grows once and keeps order.
+    std::vector<int> more(100);
+    std::iota(more.begin(), more.end(), 10);
+    ASSERT_EQ(queue_push_n(queue, more.data(), more.size()), DSC_ERROR_OK);
+    std::vector<int> all(106);
+    ASSERT_EQ(queue_pop_n(queue, all.data(), 200), 106u);
+    std::vector<int> expected(106);
+    std::iota(expected.begin(), expected.end(), 4);
+    EXPECT_EQ(all, expected);
+    EXPECT_TRUE(queue_empty(queue));
+    EXPECT_EQ(queue_pop_n(queue, out, 4), 0u);
+}
+
+TEST_F(QueueTest, PushNInvalid) {
+    int value = 1;
+    EXPECT_EQ(queue_push_n(queue, nullptr, 0), DSC_ERROR_OK);
+    EXPECT_EQ(queue_push_n(queue, nullptr, 1), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(queue_push_n(nullptr, &value, 1), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(queue_push_n(queue, &value, SIZE_MAX), DSC_ERROR_OVERFLOW);
+    EXPECT_EQ(queue_size(queue), 0u);
+    EXPECT_EQ(queue_pop_n(nullptr, &value, 1), 0u);
+    EXPECT_EQ(queue_pop_n(queue, nullptr, 1), 0u);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
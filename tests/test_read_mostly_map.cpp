@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "libdsc/read_mostly_map.h"
+
+class ReadMostlyMapTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        map = read_mostly_map_create(sizeof(uint64_t), sizeof(uint64_t),
+                                     nullptr, nullptr);
+        ASSERT_NE(map, nullptr);
+        reader = read_mostly_map_register(map);
+        ASSERT_NE(reader, nullptr);
+    }
+
+    void TearDown() override {
+        read_mostly_map_unregister(reader);
+        read_mostly_map_destroy(map);
+    }
+
+    uint64_t const *find(uint64_t key) {
+        return static_cast<uint64_t const *>(
+            read_mostly_map_find(reader, &key));
+    }
+
+    DSCReadMostlyMap *map;
+    DSCReadMostlyReader *reader;
+};
+
+static DSCError insert_range(DSCUnorderedMap *table, void *context) {
+    uint64_t n = *static_cast<uint64_t *>(context);
+    for (uint64_t key = 0; key < n; ++key) {
+        uint64_t value = key * 2;
+        DSCError err = unordered_map_insert(table, &key, &value);
+        if (err != DSC_ERROR_OK) return err;
+    }
+    return DSC_ERROR_OK;
+}
+
+static DSCError insert_then_fail(DSCUnorderedMap *table, void *context) {
+    uint64_t key = 99, value = 1;
+    unordered_map_insert(table, &key, &value);
+    return DSC_ERROR_INVALID_ARGUMENT;
+}
+
+TEST_F(ReadMostlyMapTest, InsertFindErase) {
+    uint64_t key = 5, value = 50;
+
+    EXPECT_EQ(read_mostly_map_insert(map, &key, &value), DSC_ERROR_OK);
+    EXPECT_EQ(read_mostly_map_size(map), 1u);
+
+    read_mostly_map_read_lock(reader);
+    ASSERT_NE(find(5), nullptr);
+    EXPECT_EQ(*find(5), 50u);
+    EXPECT_EQ(find(6), nullptr);
+    read_mostly_map_read_unlock(reader);
+
+    EXPECT_EQ(read_mostly_map_erase(map, &key), DSC_ERROR_OK);
+    EXPECT_EQ(read_mostly_map_erase(map, &key), DSC_ERROR_NOT_FOUND);
+    EXPECT_EQ(read_mostly_map_size(map), 0u);
+
+    read_mostly_map_read_lock(reader);
+    EXPECT_EQ(find(5), nullptr);
+    read_mostly_map_read_unlock(reader);
+}
+
+TEST_F(ReadMostlyMapTest, InvalidArguments) {
+    uint64_t key = 1;
+    EXPECT_EQ(read_mostly_map_insert(nullptr, &key, &key),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(read_mostly_map_insert(map, &key, nullptr),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(read_mostly_map_erase(map, nullptr),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(read_mostly_map_update(map, nullptr, nullptr),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(read_mostly_map_register(nullptr), nullptr);
+    EXPECT_EQ(read_mostly_map_size(nullptr), 0u);
+    read_mostly_map_destroy(nullptr);
+}
+
+TEST_F(ReadMostlyMapTest, BatchUpdate) {
+    uint64_t n = 1000;
+    EXPECT_EQ(read_mostly_map_update(map, insert_range, &n), DSC_ERROR_OK);
+    EXPECT_EQ(read_mostly_map_size(map), n);
+
+    // A failed update publishes nothing.
+    EXPECT_EQ(read_mostly_map_update(map, insert_then_fail, nullptr),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(read_mostly_map_size(map), n);
+
+    read_mostly_map_read_lock(reader);
+    for (uint64_t key = 0; key < n; ++key) {
+        ASSERT_NE(find(key), nullptr);
+        EXPECT_EQ(*find(key), key * 2);
+    }
+    EXPECT_EQ(find(99 + n), nullptr);
+    read_mostly_map_read_unlock(reader);
+}
+
+TEST_F(ReadMostlyMapTest, ValuesOutliveConcurrentUpdates) {
+    uint64_t key = 1, value = 10;
+    ASSERT_EQ(read_mostly_map_insert(map, &key, &value), DSC_ERROR_OK);
+
+    read_mostly_map_read_lock(reader);
+    uint64_t const *seen = find(1);
+    ASSERT_NE(seen, nullptr);
+
+    // The table seen above is retired but must not be freed while the
+    // read section is open.
+    value = 20;
+    ASSERT_EQ(read_mostly_map_insert(map, &key, &value), DSC_ERROR_OK);
+    ASSERT_EQ(read_mostly_map_erase(map, &key), DSC_ERROR_OK);
+    EXPECT_EQ(*seen, 10u);
+    EXPECT_EQ(find(1), nullptr);
+    read_mostly_map_read_unlock(reader);
+
+    read_mostly_map_synchronize(map);
+}
+
+TEST_F(ReadMostlyMapTest, ReaderSlotsAreReused) {
+    DSCReadMostlyReader *second = read_mostly_map_register(map);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(second, reader);
+    read_mostly_map_unregister(second);
+
+    DSCReadMostlyReader *third = read_mostly_map_register(map);
+    EXPECT_EQ(third, second);
+    read_mostly_map_unregister(third);
+}
+
+TEST_F(ReadMostlyMapTest, ReadersRunDuringUpdates) {
+    constexpr uint64_t kStable = 512;
+    constexpr int kReaders = 4;
+    constexpr int kWrites = 300;
+
+    uint64_t n = kStable;
+    ASSERT_EQ(read_mostly_map_update(map, insert_range, &n), DSC_ERROR_OK);
+
+    // Writers churn keys above kStable; readers check the stable keys
+    // always read back intact.
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < kReaders; ++t) {
+        readers.emplace_back([this, &stop] {
+            DSCReadMostlyReader *r = read_mostly_map_register(map);
+            ASSERT_NE(r, nullptr);
+            while (!stop.load(std::memory_order_relaxed)) {
+                read_mostly_map_read_lock(r);
+                for (uint64_t key = 0; key < kStable; ++key) {
+                    auto const *value = static_cast<uint64_t const *>(
+                        read_mostly_map_find(r, &key));
+                    ASSERT_NE(value, nullptr);
+                    ASSERT_EQ(*value, key * 2);
+                }
+                read_mostly_map_read_unlock(r);
+            }
+            read_mostly_map_unregister(r);
+        });
+    }
+
+    for (int i = 0; i < kWrites; ++i) {
+        uint64_t key = kStable + i / 2 % 16;
+        if (i % 2 == 0) {
+            ASSERT_EQ(read_mostly_map_insert(map, &key, &key), DSC_ERROR_OK);
+        } else {
+            ASSERT_EQ(read_mostly_map_erase(map, &key), DSC_ERROR_OK);
+        }
+    }
+    stop = true;
+    for (auto &thread : readers) thread.join();
+
+    read_mostly_map_synchronize(map);
+    EXPECT_EQ(read_mostly_map_size(map), kStable);
+}
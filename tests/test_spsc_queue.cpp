@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "libdsc/spsc_queue.h"
+
+class SpscQueueTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        queue = spsc_queue_create(sizeof(int), 8);
+        ASSERT_NE(queue, nullptr);
+    }
+
+    void TearDown() override { spsc_queue_destroy(queue); }
+
+    DSCSpscQueue *queue;
+};
+
+TEST_F(SpscQueueTest, Create) {
+    EXPECT_EQ(spsc_queue_capacity(queue), 8u);
+    EXPECT_EQ(spsc_queue_size(queue), 0u);
+    EXPECT_TRUE(spsc_queue_empty(queue));
+}
+
+TEST_F(SpscQueueTest, CapacityIsRoundedUp) {
+    DSCSpscQueue *odd = spsc_queue_create(sizeof(int), 5);
+    ASSERT_NE(odd, nullptr);
+    EXPECT_EQ(spsc_queue_capacity(odd), 8u);
+    spsc_queue_destroy(odd);
+
+    DSCSpscQueue *one = spsc_queue_create(sizeof(int), 1);
+    ASSERT_NE(one, nullptr);
+    int value = 3, out = 0;
+    EXPECT_EQ(spsc_queue_push(one, &value), DSC_ERROR_OK);
+    EXPECT_EQ(spsc_queue_push(one, &value), DSC_ERROR_FULL);
+    EXPECT_EQ(spsc_queue_pop(one, &out), DSC_ERROR_OK);
+    EXPECT_EQ(out, 3);
+    spsc_queue_destroy(one);
+}
+
+TEST_F(SpscQueueTest, InvalidArguments) {
+    int value = 1;
+    EXPECT_EQ(spsc_queue_create(0, 8), nullptr);
+    EXPECT_EQ(spsc_queue_create(sizeof(int), 0), nullptr);
+    EXPECT_EQ(spsc_queue_create(sizeof(int), SIZE_MAX), nullptr);
+    EXPECT_EQ(spsc_queue_create(SIZE_MAX / 2, 4), nullptr);
+    EXPECT_EQ(spsc_queue_push(nullptr, &value), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(spsc_queue_push(queue, nullptr), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(spsc_queue_pop(queue, nullptr), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(spsc_queue_push_n(nullptr, &value, 1), 0u);
+    EXPECT_EQ(spsc_queue_pop_n(nullptr, &value, 1), 0u);
+    EXPECT_EQ(spsc_queue_push_n(queue, nullptr, 1), 0u);
+    EXPECT_EQ(spsc_queue_size(queue), 0u);
+    ASSERT_EQ(spsc_queue_push(queue, &value), DSC_ERROR_OK);
+    EXPECT_EQ(spsc_queue_pop_n(queue, nullptr, 1), 0u);
+    EXPECT_EQ(spsc_queue_size(queue), 1u);
+    EXPECT_EQ(spsc_queue_capacity(nullptr), 0u);
+    EXPECT_TRUE(spsc_queue_empty(nullptr));
+    spsc_queue_destroy(nullptr);
+}
+
+TEST_F(SpscQueueTest, FullAndEmpty) {
+    int out;
+    EXPECT_EQ(spsc_queue_pop(queue, &out), DSC_ERROR_EMPTY);
+
+    // Several rounds so positions wrap around the buffer.
+    for (int round = 0; round < 5; ++round) {
+        for (int i = 0; i < 8; ++i) {
+            int value = round * 8 + i;
+            ASSERT_EQ(spsc_queue_push(queue, &value), DSC_ERROR_OK);
+        }
+        int extra = -1;
+        EXPECT_EQ(spsc_queue_push(queue, &extra), DSC_ERROR_FULL);
+        EXPECT_EQ(spsc_queue_size(queue), 8u);
+
+        for (int i = 0; i < 8; ++i) {
+            ASSERT_EQ(spsc_queue_pop(queue, &out), DSC_ERROR_OK);
+            EXPECT_EQ(out, round * 8 + i);
+        }
+        EXPECT_EQ(spsc_queue_pop(queue, &out), DSC_ERROR_EMPTY);
+    }
+}
+
+TEST_F(SpscQueueTest, BulkWrapsAround) {
+    int values[8], out[8];
+    int next = 0, expected = 0;
+
+    // Offset the positions so bulk copies straddle the end of the buffer.
+    for (int i = 0; i < 5; ++i) values[i] = next++;
+    ASSERT_EQ(spsc_queue_push_n(queue, values, 5), 5u);
+    ASSERT_EQ(spsc_queue_pop_n(queue, out, 3), 3u);
+    for (int i = 0; i < 3; ++i) EXPECT_EQ(out[i], expected++);
+
+    // Only six of the eight fit.
+    for (int &value : values) value = next++;
+    ASSERT_EQ(spsc_queue_push_n(queue, values, 8), 6u);
+    EXPECT_EQ(spsc_queue_push_n(queue, values, 8), 0u);
+    next -= 2;
+
+    ASSERT_EQ(spsc_queue_pop_n(queue, out, 8), 8u);
+    for (int value : out) EXPECT_EQ(value, expected++);
+    EXPECT_EQ(spsc_queue_pop_n(queue, out, 8), 0u);
+    EXPECT_EQ(expected, next);
+
+    EXPECT_EQ(spsc_queue_push_n(queue, nullptr, 0), 0u);
+    EXPECT_EQ(spsc_queue_pop_n(queue, nullptr, 0), 0u);
+}
+
+TEST(SpscQueueThreadTest, TransfersInOrder) {
+    constexpr uint64_t kCount = 1 << 20;
+    DSCSpscQueue *queue = spsc_queue_create(sizeof(uint64_t), 1024);
+    ASSERT_NE(queue, nullptr);
+
+    // Single-element producer, bulk consumer.
+    std::thread producer([queue] {
+        for (uint64_t i = 0; i < kCount;) {
+            if (spsc_queue_push(queue, &i) == DSC_ERROR_OK) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    bool in_order = true;
+    std::vector<uint64_t> batch(100);
+    while (expected < kCount) {
+        size_t count = spsc_queue_pop_n(queue, batch.data(), batch.size());
+        if (count == 0) std::this_thread::yield();
+        for (size_t i = 0; i < count; ++i) {
+            in_order = in_order && batch[i] == expected++;
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(spsc_queue_empty(queue));
+    spsc_queue_destroy(queue);
+}
+
+TEST(SpscQueueThreadTest, BulkTransfersInOrder) {
+    constexpr uint64_t kCount = 1 << 20;
+    DSCSpscQueue *queue = spsc_queue_create(sizeof(uint64_t), 256);
+    ASSERT_NE(queue, nullptr);
+
+    // Bulk producer, single-element consumer.
+    std::thread producer([queue] {
+        std::vector<uint64_t> batch(37);
+        uint64_t next = 0;
+        while (next < kCount) {
+            size_t count = batch.size();
+            if (count > kCount - next) count = kCount - next;
+            for (size_t i = 0; i < count; ++i) batch[i] = next + i;
+            size_t pushed = spsc_queue_push_n(queue, batch.data(), count);
+            if (pushed == 0) std::this_thread::yield();
+            next += pushed;
+        }
+    });
+
+    bool in_order = true;
+    for (uint64_t expected = 0; expected < kCount;) {
+        uint64_t value;
+        if (spsc_queue_pop(queue, &value) == DSC_ERROR_OK) {
+            in_order = in_order && value == expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    EXPECT_TRUE(in_order);
+    spsc_queue_destroy(queue);
+}
@@ -2,6 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
 #include "libdsc/stack.h"
 
 class StackTest : public ::testing::Test {
@@ -87,6 +91,46 @@ TEST_F(StackTest, Reserve) {
     }
 }
 
+TEST_F(StackTest, PushNAndPopN) {
+    std::vector<int> values(100);
+    std::iota(values.begin(), values.end(), 0);
+
+    // Grows past the initial capacity in one step.
+    ASSERT_EQ(stack_push_n(stack, values.data(), values.size()),
+              DSC_ERROR_OK);
+    EXPECT_EQ(stack_size(stack), 100u);
+    EXPECT_EQ(*static_cast<int *>(stack_top(stack)), 99);
+
+    int value = 100;
+    ASSERT_EQ(stack_push(stack, &value), DSC_ERROR_OK);
+
+    // The top elements come back in push order.
+    int out[3];
+    ASSERT_EQ(stack_pop_n(stack, out, 3), 3u);
+    EXPECT_EQ(out[0], 98);
+    EXPECT_EQ(out[1], 99);
+    EXPECT_EQ(out[2], 100);
+
+    std::vector<int> rest(200);
+    ASSERT_EQ(stack_pop_n(stack, rest.data(), rest.size()), 98u);
+    rest.resize(98);
+    values.resize(98);
+    EXPECT_EQ(rest, values);
+    EXPECT_TRUE(stack_empty(stack));
+    EXPECT_EQ(stack_pop_n(stack, out, 3), 0u);
+}
+
+TEST_F(StackTest, PushNInvalid) {
+    int value = 1;
+    EXPECT_EQ(stack_push_n(stack, nullptr, 0), DSC_ERROR_OK);
+    EXPECT_EQ(stack_push_n(stack, nullptr, 1), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(stack_push_n(nullptr, &value, 1), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(stack_push_n(stack, &value, SIZE_MAX), DSC_ERROR_OVERFLOW);
+    EXPECT_EQ(stack_size(stack), 0u);
+    EXPECT_EQ(stack_pop_n(nullptr, &value, 1), 0u);
+    EXPECT_EQ(stack_pop_n(stack, nullptr, 1), 0u);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,365 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <unordered_map>
+
+#include "libdsc/typed_hashmap.h"
+#include "libdsc/typed_vector.h"
+
+struct Point {
+    int x;
+    int y;
+};
+
+static size_t constant_hash(uint64_t key) {
+    (void)key;
+    return 42;
+}
+
+static bool point_equal(Point a, Point b) { return a.x == b.x && a.y == b.y; }
+
+static size_t point_hash(Point p) {
+    uint64_t packed = static_cast<uint64_t>(static_cast<uint32_t>(p.x)) << 32 |
+                      static_cast<uint32_t>(p.y);
+    return static_cast<size_t>(dsc_hash_mix64(packed));
+}
+
+DSC_DEFINE_VECTOR(int_vector, int)
+DSC_DEFINE_VECTOR(point_vector, Point)
+DSC_DEFINE_HASHMAP(u64_u32, uint64_t, uint32_t, dsc_typed_hash_int,
+                   dsc_typed_equal)
+DSC_DEFINE_HASHMAP(colliding_map, uint64_t, uint64_t, constant_hash,
+                   dsc_typed_equal)
+DSC_DEFINE_HASHMAP(point_map, Point, int, point_hash, point_equal)
+
+class TypedVectorTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        vec = int_vector_create();
+        ASSERT_NE(vec, nullptr);
+    }
+
+    void TearDown() override { int_vector_destroy(vec); }
+
+    int_vector *vec;
+};
+
+TEST_F(TypedVectorTest, Create) {
+    EXPECT_EQ(int_vector_size(vec), 0u);
+    EXPECT_TRUE(int_vector_empty(vec));
+    EXPECT_EQ(int_vector_capacity(vec),
+              static_cast<size_t>(DSC_VECTOR_INITIAL_CAPACITY));
+    EXPECT_EQ(int_vector_front(vec), nullptr);
+    EXPECT_EQ(int_vector_back(vec), nullptr);
+}
+
+TEST_F(TypedVectorTest, PushBackGrows) {
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(int_vector_push_back(vec, i), DSC_ERROR_OK);
+    }
+
+    EXPECT_EQ(int_vector_size(vec), 1000u);
+    EXPECT_GE(int_vector_capacity(vec), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(*int_vector_at(vec, i), i);
+    }
+    EXPECT_EQ(*int_vector_front(vec), 0);
+    EXPECT_EQ(*int_vector_back(vec), 999);
+    EXPECT_EQ(int_vector_at(vec, 1000), nullptr);
+}
+
+TEST_F(TypedVectorTest, PopBack) {
+    EXPECT_EQ(int_vector_pop_back(vec), DSC_ERROR_EMPTY);
+
+    ASSERT_EQ(int_vector_push_back(vec, 1), DSC_ERROR_OK);
+    ASSERT_EQ(int_vector_push_back(vec, 2), DSC_ERROR_OK);
+    EXPECT_EQ(int_vector_pop_back(vec), DSC_ERROR_OK);
+    EXPECT_EQ(int_vector_size(vec), 1u);
+    EXPECT_EQ(*int_vector_back(vec), 1);
+}
+
+TEST_F(TypedVectorTest, InsertAndErase) {
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_EQ(int_vector_push_back(vec, i), DSC_ERROR_OK);
+    }
+
+    EXPECT_EQ(int_vector_insert(vec, 0, -1), DSC_ERROR_OK);
+    EXPECT_EQ(int_vector_insert(vec, 3, 42), DSC_ERROR_OK);
+    EXPECT_EQ(int_vector_insert(vec, 7, 99), DSC_ERROR_OK);
+    EXPECT_EQ(int_vector_insert(vec, 9, 0), DSC_ERROR_INVALID_ARGUMENT);
+
+    int const expected[] = {-1, 0, 1, 42, 2, 3, 4, 99};
+    ASSERT_EQ(int_vector_size(vec), 8u);
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(*int_vector_at(vec, i), expected[i]);
+    }
+
+    EXPECT_EQ(int_vector_erase(vec, 3), DSC_ERROR_OK);
+    EXPECT_EQ(int_vector_erase(vec, 6), DSC_ERROR_OK);
+    EXPECT_EQ(int_vector_erase(vec, 6), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(int_vector_size(vec), 6u);
+    EXPECT_EQ(*int_vector_at(vec, 3), 2);
+    EXPECT_EQ(*int_vector_back(vec), 4);
+}
+
+TEST_F(TypedVectorTest, ResizeZeroFills) {
+    ASSERT_EQ(int_vector_push_back(vec, 7), DSC_ERROR_OK);
+    ASSERT_EQ(int_vector_resize(vec, 100), DSC_ERROR_OK);
+
+    EXPECT_EQ(int_vector_size(vec), 100u);
+    EXPECT_EQ(*int_vector_at(vec, 0), 7);
+    for (size_t i = 1; i < 100; ++i) {
+        EXPECT_EQ(*int_vector_at(vec, i), 0);
+    }
+
+    ASSERT_EQ(int_vector_resize(vec, 10), DSC_ERROR_OK);
+    EXPECT_EQ(int_vector_size(vec), 10u);
+}
+
+TEST_F(TypedVectorTest, ShrinkToFit) {
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_EQ(int_vector_push_back(vec, i), DSC_ERROR_OK);
+    }
+    ASSERT_EQ(int_vector_shrink_to_fit(vec), DSC_ERROR_OK);
+    EXPECT_EQ(int_vector_capacity(vec), 20u);
+
+    // An emptied vector releases its buffer and grows again on demand.
+    int_vector_clear(vec);
+    ASSERT_EQ(int_vector_shrink_to_fit(vec), DSC_ERROR_OK);
+    EXPECT_EQ(int_vector_capacity(vec), 0u);
+    ASSERT_EQ(int_vector_push_back(vec, 5), DSC_ERROR_OK);
+    EXPECT_EQ(*int_vector_front(vec), 5);
+}
+
+TEST(TypedVectorStructTest, StoresStructsByValue) {
+    point_vector *points = point_vector_create();
+    ASSERT_NE(points, nullptr);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(point_vector_push_back(points, Point{i, -i}), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 100; ++i) {
+        Point const *p = point_vector_at(points, i);
+        EXPECT_EQ(p->x, i);
+        EXPECT_EQ(p->y, -i);
+    }
+
+    point_vector_destroy(points);
+}
+
+TEST(TypedVectorNullTest, NullArguments) {
+    EXPECT_EQ(int_vector_size(nullptr), 0u);
+    EXPECT_TRUE(int_vector_empty(nullptr));
+    EXPECT_EQ(int_vector_push_back(nullptr, 1), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(int_vector_at(nullptr, 0), nullptr);
+    int_vector_destroy(nullptr);
+}
+
+class TypedHashMapTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        map = u64_u32_create();
+        ASSERT_NE(map, nullptr);
+    }
+
+    void TearDown() override { u64_u32_destroy(map); }
+
+    u64_u32 *map;
+};
+
+TEST_F(TypedHashMapTest, Create) {
+    EXPECT_EQ(u64_u32_size(map), 0u);
+    EXPECT_TRUE(u64_u32_empty(map));
+    EXPECT_EQ(u64_u32_find(map, 1), nullptr);
+    EXPECT_EQ(u64_u32_erase(map, 1), DSC_ERROR_NOT_FOUND);
+}
+
+TEST_F(TypedHashMapTest, InsertAndFind) {
+    for (uint64_t key = 0; key < 10000; ++key) {
+        ASSERT_EQ(u64_u32_insert(map, key, static_cast<uint32_t>(key * 3)),
+                  DSC_ERROR_OK);
+    }
+
+    EXPECT_EQ(u64_u32_size(map), 10000u);
+    for (uint64_t key = 0; key < 10000; ++key) {
+        uint32_t *value = u64_u32_find(map, key);
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, key * 3);
+        EXPECT_TRUE(u64_u32_contains(map, key));
+    }
+    EXPECT_EQ(u64_u32_find(map, 10000), nullptr);
+    EXPECT_FALSE(u64_u32_contains(map, 10000));
+}
+
+TEST_F(TypedHashMapTest, InsertReplacesValue) {
+    ASSERT_EQ(u64_u32_insert(map, 7, 1), DSC_ERROR_OK);
+    ASSERT_EQ(u64_u32_insert(map, 7, 2), DSC_ERROR_OK);
+
+    EXPECT_EQ(u64_u32_size(map), 1u);
+    EXPECT_EQ(*u64_u32_find(map, 7), 2u);
+}
+
+TEST_F(TypedHashMapTest, TryEmplace) {
+    bool inserted = false;
+    uint32_t *value = u64_u32_try_emplace(map, 5, &inserted);
+    ASSERT_NE(value, nullptr);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*value, 0u);
+    *value = 10;
+
+    value = u64_u32_try_emplace(map, 5, &inserted);
+    ASSERT_NE(value, nullptr);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(*value, 10u);
+    EXPECT_EQ(u64_u32_size(map), 1u);
+}
+
+TEST_F(TypedHashMapTest, Erase) {
+    for (uint64_t key = 0; key < 1000; ++key) {
+        ASSERT_EQ(u64_u32_insert(map, key, 1), DSC_ERROR_OK);
+    }
+    for (uint64_t key = 0; key < 1000; key += 2) {
+        ASSERT_EQ(u64_u32_erase(map, key), DSC_ERROR_OK);
+    }
+
+    EXPECT_EQ(u64_u32_size(map), 500u);
+    for (uint64_t key = 0; key < 1000; ++key) {
+        EXPECT_EQ(u64_u32_contains(map, key), key % 2 == 1);
+    }
+    EXPECT_EQ(u64_u32_erase(map, 0), DSC_ERROR_NOT_FOUND);
+}
+
+TEST_F(TypedHashMapTest, ChurnMatchesReference) {
+    std::unordered_map<uint64_t, uint32_t> reference;
+    std::mt19937_64 rng(7);
+
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t key = rng() % 5000;
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(u64_u32_erase(map, key) == DSC_ERROR_OK,
+                      reference.erase(key) == 1);
+        } else {
+            uint32_t value = static_cast<uint32_t>(rng());
+            ASSERT_EQ(u64_u32_insert(map, key, value), DSC_ERROR_OK);
+            reference[key] = value;
+        }
+    }
+
+    ASSERT_EQ(u64_u32_size(map), reference.size());
+    for (auto const &[key, value] : reference) {
+        uint32_t *found = u64_u32_find(map, key);
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, value);
+    }
+}
+
+TEST_F(TypedHashMapTest, Iteration) {
+    for (uint64_t key = 0; key < 300; ++key) {
+        ASSERT_EQ(u64_u32_insert(map, key, static_cast<uint32_t>(key + 1)),
+                  DSC_ERROR_OK);
+    }
+
+    std::set<uint64_t> seen;
+    size_t cursor = 0;
+    uint64_t const *key;
+    uint32_t *value;
+    while (u64_u32_next(map, &cursor, &key, &value)) {
+        EXPECT_EQ(*value, *key + 1);
+        EXPECT_TRUE(seen.insert(*key).second);
+    }
+    EXPECT_EQ(seen.size(), 300u);
+    EXPECT_FALSE(u64_u32_next(map, &cursor, &key, &value));
+}
+
+TEST_F(TypedHashMapTest, ClearAndReserve) {
+    ASSERT_EQ(u64_u32_reserve(map, 5000), DSC_ERROR_OK);
+    size_t capacity = map->capacity;
+    EXPECT_GE(dsc_capacity_to_growth(capacity), 5000u);
+
+    for (uint64_t key = 0; key < 5000; ++key) {
+        ASSERT_EQ(u64_u32_insert(map, key, 0), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(map->capacity, capacity);
+
+    u64_u32_clear(map);
+    EXPECT_TRUE(u64_u32_empty(map));
+    EXPECT_EQ(u64_u32_find(map, 1), nullptr);
+    ASSERT_EQ(u64_u32_insert(map, 1, 2), DSC_ERROR_OK);
+    EXPECT_EQ(*u64_u32_find(map, 1), 2u);
+}
+
+TEST_F(TypedHashMapTest, HighKeyBitsReachTheHash) {
+    // Keys differing only above bit 31 must not collide on 32-bit targets.
+    for (uint64_t high = 0; high < 1000; ++high) {
+        uint64_t key = high << 32;
+        EXPECT_NE(dsc_typed_hash_int(key), dsc_typed_hash_int(key + 1));
+        if (high > 0) {
+            EXPECT_NE(dsc_typed_hash_int(key), dsc_typed_hash_int(0));
+        }
+        ASSERT_EQ(u64_u32_insert(map, key, static_cast<uint32_t>(high)),
+                  DSC_ERROR_OK);
+    }
+
+    for (uint64_t high = 0; high < 1000; ++high) {
+        uint32_t *value = u64_u32_find(map, high << 32);
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, high);
+    }
+}
+
+TEST(TypedHashMapCollisionTest, CollidingKeys) {
+    colliding_map *map = colliding_map_create();
+    ASSERT_NE(map, nullptr);
+
+    for (uint64_t key = 0; key < 500; ++key) {
+        ASSERT_EQ(colliding_map_insert(map, key, key * 2), DSC_ERROR_OK);
+    }
+    for (uint64_t key = 0; key < 500; key += 3) {
+        ASSERT_EQ(colliding_map_erase(map, key), DSC_ERROR_OK);
+    }
+    for (uint64_t key = 0; key < 500; ++key) {
+        uint64_t *value = colliding_map_find(map, key);
+        if (key % 3 == 0) {
+            EXPECT_EQ(value, nullptr);
+        } else {
+            ASSERT_NE(value, nullptr);
+            EXPECT_EQ(*value, key * 2);
+        }
+    }
+
+    colliding_map_destroy(map);
+}
+
+TEST(TypedHashMapStructTest, StructKeys) {
+    point_map *map = point_map_create();
+    ASSERT_NE(map, nullptr);
+
+    for (int x = 0; x < 50; ++x) {
+        for (int y = 0; y < 50; ++y) {
+            ASSERT_EQ(point_map_insert(map, Point{x, y}, x * 100 + y),
+                      DSC_ERROR_OK);
+        }
+    }
+
+    EXPECT_EQ(point_map_size(map), 2500u);
+    int *value = point_map_find(map, Point{12, 34});
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 1234);
+    EXPECT_EQ(point_map_find(map, Point{50, 0}), nullptr);
+
+    point_map_destroy(map);
+}
+
+TEST(TypedHashMapNullTest, NullArguments) {
+    EXPECT_EQ(u64_u32_size(nullptr), 0u);
+    EXPECT_TRUE(u64_u32_empty(nullptr));
+    EXPECT_EQ(u64_u32_insert(nullptr, 1, 1), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(u64_u32_find(nullptr, 1), nullptr);
+    EXPECT_EQ(u64_u32_erase(nullptr, 1), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(u64_u32_try_emplace(nullptr, 1, nullptr), nullptr);
+    u64_u32_destroy(nullptr);
+}
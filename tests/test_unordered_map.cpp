@@ -2,6 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "libdsc/unordered_map.h"
 
 // Hash function for strings
@@ -34,7 +39,7 @@ class UnorderedMapTest : public ::testing::Test {
         }
     }
 
-    dsc_unordered_map *map;
+    DSCUnorderedMap *map;
 };
 
 TEST_F(UnorderedMapTest, Create) {
@@ -110,6 +115,726 @@ TEST_F(UnorderedMapTest, Reserve) {
     EXPECT_EQ(*found, value);
 }
 
+// Hash function that sends every key to the same probe sequence
+static size_t constant_hash(void const *key) {
+    (void)key;
+    return 7;
+}
+
+TEST(UnorderedMapProbingTest, ManyIntKeys) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+
+    for (int i = 0; i < 10000; ++i) {
+        int value = i * 2;
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &value), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(unordered_map_size(int_map), 10000u);
+
+    for (int i = 0; i < 10000; i += 2) {
+        ASSERT_EQ(unordered_map_erase(int_map, &i), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(unordered_map_size(int_map), 5000u);
+
+    for (int i = 0; i < 10000; ++i) {
+        int *found = static_cast<int *>(unordered_map_find(int_map, &i));
+        if (i % 2 == 0) {
+            EXPECT_EQ(found, nullptr);
+        } else {
+            ASSERT_NE(found, nullptr);
+            EXPECT_EQ(*found, i * 2);
+        }
+    }
+
+    int missing = 10000;
+    EXPECT_EQ(unordered_map_find(int_map, &missing), nullptr);
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapProbingTest, FullCollisions) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), constant_hash, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 100; i += 3) {
+        ASSERT_EQ(unordered_map_erase(int_map, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 100; ++i) {
+        int *found = static_cast<int *>(unordered_map_find(int_map, &i));
+        if (i % 3 == 0) {
+            EXPECT_EQ(found, nullptr);
+        } else {
+            ASSERT_NE(found, nullptr);
+            EXPECT_EQ(*found, i);
+        }
+    }
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapProbingTest, EraseReinsertChurn) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+
+    // Keeps the size constant so deleted slots must be recycled
+    for (int i = 0; i < 50000; ++i) {
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &i), DSC_ERROR_OK);
+        if (i >= 8) {
+            int old = i - 8;
+            ASSERT_EQ(unordered_map_erase(int_map, &old), DSC_ERROR_OK);
+        }
+    }
+    EXPECT_EQ(unordered_map_size(int_map), 8u);
+    EXPECT_LE(int_map->capacity, 64u);
+
+    for (int i = 50000 - 8; i < 50000; ++i) {
+        int *found = static_cast<int *>(unordered_map_find(int_map, &i));
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, i);
+    }
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapProbingTest, ReserveRoundsToPowerOfTwo) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+
+    EXPECT_EQ(unordered_map_reserve(int_map, 100), DSC_ERROR_OK);
+    size_t capacity = int_map->capacity;
+    EXPECT_EQ(capacity & (capacity - 1), 0u);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &i), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(int_map->capacity, capacity);
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapProbingTest, ZeroHashKey) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+
+    int zero = 0;
+    int value = 42;
+    EXPECT_EQ(unordered_map_insert(int_map, &zero, &value), DSC_ERROR_OK);
+    EXPECT_EQ(unordered_map_size(int_map), 1u);
+
+    int *found = static_cast<int *>(unordered_map_find(int_map, &zero));
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(*found, 42);
+
+    EXPECT_EQ(unordered_map_erase(int_map, &zero), DSC_ERROR_OK);
+    EXPECT_EQ(unordered_map_find(int_map, &zero), nullptr);
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapProbingTest, IterateSparse) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_reserve(int_map, 4096), DSC_ERROR_OK);
+
+    long expected = 0;
+    for (int i = 0; i < 37; ++i) {
+        int value = i * 3;
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &value), DSC_ERROR_OK);
+        expected += i + value;
+    }
+
+    size_t cursor = 0;
+    size_t visited = 0;
+    long sum = 0;
+    void *key;
+    void *value;
+    while (unordered_map_next(int_map, &cursor, &key, &value)) {
+        sum += *static_cast<int *>(key) + *static_cast<int *>(value);
+        ++visited;
+    }
+    EXPECT_EQ(visited, 37u);
+    EXPECT_EQ(sum, expected);
+    EXPECT_FALSE(unordered_map_next(int_map, &cursor, &key, &value));
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapRobinHoodTest, InsertFindEraseMany) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_probe_mode(int_map, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+    EXPECT_EQ(unordered_map_probe_mode(int_map), DSC_PROBE_ROBIN_HOOD);
+
+    for (int i = 0; i < 20000; ++i) {
+        int value = -i;
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &value), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 20000; i += 3) {
+        ASSERT_EQ(unordered_map_erase(int_map, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 30000; ++i) {
+        int *found = static_cast<int *>(unordered_map_find(int_map, &i));
+        if (i >= 20000 || i % 3 == 0) {
+            EXPECT_EQ(found, nullptr);
+        } else {
+            ASSERT_NE(found, nullptr);
+            EXPECT_EQ(*found, -i);
+        }
+    }
+    EXPECT_EQ(unordered_map_probe_mode(int_map), DSC_PROBE_ROBIN_HOOD);
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapRobinHoodTest, ReserveUsesHigherLoadFactor) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_probe_mode(int_map, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+
+    // 900 pairs need 2048 slots at 0.75 load but fit in 1024 at 0.9
+    ASSERT_EQ(unordered_map_reserve(int_map, 900), DSC_ERROR_OK);
+    EXPECT_EQ(int_map->capacity, 1024u);
+    for (int i = 0; i < 900; ++i) {
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &i), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(int_map->capacity, 1024u);
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapRobinHoodTest, SwitchModesKeepsContents) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &i), DSC_ERROR_OK);
+    }
+    ASSERT_EQ(unordered_map_set_probe_mode(int_map, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_NE(unordered_map_find(int_map, &i), nullptr);
+    }
+    ASSERT_EQ(unordered_map_set_probe_mode(int_map, DSC_PROBE_GROUP),
+              DSC_ERROR_OK);
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_NE(unordered_map_find(int_map, &i), nullptr);
+    }
+    EXPECT_EQ(unordered_map_size(int_map), 1000u);
+    EXPECT_EQ(unordered_map_set_probe_mode(int_map, (DSCProbeMode)7),
+              DSC_ERROR_INVALID_ARGUMENT);
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapRobinHoodTest, EraseReinsertChurn) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_probe_mode(int_map, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+
+    for (int i = 0; i < 50000; ++i) {
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &i), DSC_ERROR_OK);
+        if (i >= 12) {
+            int old = i - 12;
+            ASSERT_EQ(unordered_map_erase(int_map, &old), DSC_ERROR_OK);
+        }
+    }
+    EXPECT_EQ(unordered_map_size(int_map), 12u);
+    EXPECT_LE(int_map->capacity, 64u);
+    for (int i = 50000 - 12; i < 50000; ++i) {
+        ASSERT_NE(unordered_map_find(int_map, &i), nullptr);
+    }
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapRobinHoodTest, DegenerateHashFallsBackToGroups) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), constant_hash, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_probe_mode(int_map, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+
+    // Probe distances cannot exceed 255 slots
+    for (int i = 0; i < 400; ++i) {
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &i), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(unordered_map_probe_mode(int_map), DSC_PROBE_GROUP);
+    for (int i = 0; i < 400; ++i) {
+        int *found = static_cast<int *>(unordered_map_find(int_map, &i));
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, i);
+    }
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapRobinHoodTest, BackwardShiftErase) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), constant_hash, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_probe_mode(int_map, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+
+    // One long run: every erase shifts the rest of it back
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 200; i += 2) {
+        ASSERT_EQ(unordered_map_erase(int_map, &i), DSC_ERROR_OK);
+        for (int j = i + 1; j < 200; ++j) {
+            ASSERT_NE(unordered_map_find(int_map, &j), nullptr);
+        }
+    }
+    EXPECT_EQ(unordered_map_probe_mode(int_map), DSC_PROBE_ROBIN_HOOD);
+
+    // No tombstones are left behind
+    for (size_t i = 0; i < int_map->capacity; ++i) {
+        EXPECT_NE(int_map->ctrl[i], static_cast<int8_t>(-2));
+    }
+    for (int i = 1; i < 200; i += 2) {
+        ASSERT_EQ(unordered_map_erase(int_map, &i), DSC_ERROR_OK);
+    }
+    EXPECT_TRUE(unordered_map_empty(int_map));
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapIncrementalRehashTest, MigratesAcrossOperations) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_incremental_rehash(int_map, true),
+              DSC_ERROR_OK);
+
+    bool saw_migration = false;
+    for (int i = 0; i < 20000; ++i) {
+        int value = i + 1;
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &value), DSC_ERROR_OK);
+        if (int_map->old_table) {
+            saw_migration = true;
+            // Pairs are found in whichever table currently holds them
+            for (int j = 0; j <= i; j += 97) {
+                int *found =
+                    static_cast<int *>(unordered_map_find(int_map, &j));
+                ASSERT_NE(found, nullptr);
+                EXPECT_EQ(*found, j + 1);
+            }
+        }
+    }
+    EXPECT_TRUE(saw_migration);
+    EXPECT_EQ(unordered_map_size(int_map), 20000u);
+
+    for (int i = 0; i < 20000; ++i) {
+        int *found = static_cast<int *>(unordered_map_find(int_map, &i));
+        ASSERT_NE(found, nullptr);
+        EXPECT_EQ(*found, i + 1);
+    }
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapIncrementalRehashTest, GrowthDoesBoundedWork) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_incremental_rehash(int_map, true),
+              DSC_ERROR_OK);
+
+    int i = 0;
+    while (int_map->capacity < 4096) {
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &i), DSC_ERROR_OK);
+        ++i;
+    }
+    // The insert that grew the map left most pairs in the old table
+    ASSERT_NE(int_map->old_table, nullptr);
+    EXPECT_GT(int_map->old_table->size, 1000u);
+    EXPECT_EQ(unordered_map_size(int_map), static_cast<size_t>(i));
+
+    // Disabling finishes the migration
+    ASSERT_EQ(unordered_map_set_incremental_rehash(int_map, false),
+              DSC_ERROR_OK);
+    EXPECT_EQ(int_map->old_table, nullptr);
+    for (int j = 0; j < i; ++j) {
+        ASSERT_NE(unordered_map_find(int_map, &j), nullptr);
+    }
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapIncrementalRehashTest, UpdateEraseAndIterateMidMigration) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_incremental_rehash(int_map, true),
+              DSC_ERROR_OK);
+
+    int n = 0;
+    while (!int_map->old_table || int_map->capacity < 1024) {
+        ASSERT_EQ(unordered_map_insert(int_map, &n, &n), DSC_ERROR_OK);
+        ++n;
+    }
+
+    // Iteration covers both tables exactly once
+    size_t cursor = 0;
+    size_t visited = 0;
+    long sum = 0;
+    void *key;
+    while (unordered_map_next(int_map, &cursor, &key, nullptr)) {
+        sum += *static_cast<int *>(key);
+        ++visited;
+    }
+    EXPECT_EQ(visited, static_cast<size_t>(n));
+    EXPECT_EQ(sum, static_cast<long>(n) * (n - 1) / 2);
+
+    // Updates and erases reach pairs still in the old table
+    for (int i = 0; i < n; ++i) {
+        int value = -i;
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &value), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(unordered_map_size(int_map), static_cast<size_t>(n));
+    for (int i = 0; i < n; i += 2) {
+        ASSERT_EQ(unordered_map_erase(int_map, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < n; ++i) {
+        int *found = static_cast<int *>(unordered_map_find(int_map, &i));
+        if (i % 2 == 0) {
+            EXPECT_EQ(found, nullptr);
+        } else {
+            ASSERT_NE(found, nullptr);
+            EXPECT_EQ(*found, -i);
+        }
+    }
+    EXPECT_EQ(unordered_map_size(int_map), static_cast<size_t>(n / 2));
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapIncrementalRehashTest, RobinHoodAndModeSwitch) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_probe_mode(int_map, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+    ASSERT_EQ(unordered_map_set_incremental_rehash(int_map, true),
+              DSC_ERROR_OK);
+
+    int n = 0;
+    while (n < 5000 || !int_map->old_table) {
+        ASSERT_EQ(unordered_map_insert(int_map, &n, &n), DSC_ERROR_OK);
+        if (n % 7 == 0) {
+            ASSERT_EQ(unordered_map_erase(int_map, &n), DSC_ERROR_OK);
+        }
+        ++n;
+    }
+
+    // A full rebuild absorbs the pending migration
+    ASSERT_EQ(unordered_map_set_probe_mode(int_map, DSC_PROBE_GROUP),
+              DSC_ERROR_OK);
+    EXPECT_EQ(int_map->old_table, nullptr);
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(unordered_map_find(int_map, &i) != nullptr, i % 7 != 0);
+    }
+
+    unordered_map_clear(int_map);
+    EXPECT_TRUE(unordered_map_empty(int_map));
+    int zero = 0;
+    EXPECT_EQ(unordered_map_find(int_map, &zero), nullptr);
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapBatchTest, FindBatchMatchesFind) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_incremental_rehash(int_map, true),
+              DSC_ERROR_OK);
+
+    for (int i = 0; i < 3000; i += 2) {
+        int value = i * 10;
+        ASSERT_EQ(unordered_map_insert(int_map, &i, &value), DSC_ERROR_OK);
+    }
+
+    // Not a multiple of the batch size, half of the keys missing
+    std::vector<int> keys(1001);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = static_cast<int>(i * 3);
+    }
+    std::vector<void *> values(keys.size());
+    size_t found = unordered_map_find_batch(int_map, keys.data(),
+                                            keys.size(), values.data());
+
+    size_t expected = 0;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        if (keys[i] < 3000 && keys[i] % 2 == 0) {
+            ++expected;
+            ASSERT_NE(values[i], nullptr);
+            EXPECT_EQ(*static_cast<int *>(values[i]), keys[i] * 10);
+        } else {
+            EXPECT_EQ(values[i], nullptr);
+        }
+    }
+    EXPECT_EQ(found, expected);
+
+    EXPECT_EQ(unordered_map_find_batch(int_map, nullptr, 0, nullptr), 0u);
+    EXPECT_EQ(unordered_map_find_batch(int_map, keys.data(), 1, nullptr), 0u);
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapTryEmplaceTest, CountsKeys) {
+    DSCUnorderedMap *int_map = unordered_map_create(
+        sizeof(int), sizeof(long), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_map, nullptr);
+
+    size_t inserts = 0;
+    for (int i = 0; i < 50000; ++i) {
+        int key = i % 1000;
+        bool inserted = false;
+        long *count = static_cast<long *>(
+            unordered_map_try_emplace(int_map, &key, &inserted));
+        ASSERT_NE(count, nullptr);
+        if (inserted) {
+            EXPECT_EQ(*count, 0);
+            ++inserts;
+        }
+        ++*count;
+    }
+    EXPECT_EQ(inserts, 1000u);
+    EXPECT_EQ(unordered_map_size(int_map), 1000u);
+
+    for (int key = 0; key < 1000; ++key) {
+        long *count = static_cast<long *>(unordered_map_find(int_map, &key));
+        ASSERT_NE(count, nullptr);
+        EXPECT_EQ(*count, 50);
+    }
+    unordered_map_destroy(int_map);
+}
+
+TEST(UnorderedMapTryEmplaceTest, PrecomputedHash) {
+    DSCUnorderedMap *int_map =
+        unordered_map_create(sizeof(int), sizeof(int), nullptr, nullptr);
+    ASSERT_NE(int_map, nullptr);
+    ASSERT_EQ(unordered_map_set_incremental_rehash(int_map, true),
+              DSC_ERROR_OK);
+
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 5000; ++i) {
+            size_t hash = unordered_map_hash(int_map, &i);
+            bool inserted = false;
+            int *value = static_cast<int *>(unordered_map_try_emplace_hashed(
+                int_map, &i, hash, &inserted));
+            ASSERT_NE(value, nullptr);
+            EXPECT_EQ(inserted, round == 0);
+            *value += i;
+        }
+    }
+    for (int i = 0; i < 5000; ++i) {
+        int *value = static_cast<int *>(unordered_map_find(int_map, &i));
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, 2 * i);
+    }
+
+    int key = 1;
+    EXPECT_EQ(unordered_map_try_emplace(nullptr, &key, nullptr), nullptr);
+    EXPECT_EQ(unordered_map_try_emplace(int_map, nullptr, nullptr), nullptr);
+    unordered_map_destroy(int_map);
+}
+
+// Table files are only supported on POSIX systems.
+#if defined(__unix__) || defined(__APPLE__)
+
+// Path of a scratch file for the mapped-file tests.
+static std::string temp_path(char const *name) {
+    return testing::TempDir() + name;
+}
+
+TEST(MappedFileTest, SaveAndOpenRoundTrip) {
+    DSCUnorderedMap *map = unordered_map_create(sizeof(uint64_t),
+                                                sizeof(uint64_t), nullptr,
+                                                nullptr);
+    for (uint64_t key = 0; key < 10000; ++key) {
+        uint64_t value = key * 3;
+        ASSERT_EQ(unordered_map_insert(map, &key, &value), DSC_ERROR_OK);
+    }
+    std::string path = temp_path("libdsc_map_roundtrip.dsc");
+    ASSERT_EQ(unordered_map_save(map, path.c_str()), DSC_ERROR_OK);
+    unordered_map_destroy(map);
+
+    DSCUnorderedMap *mapped = unordered_map_open_mapped(
+        path.c_str(), sizeof(uint64_t), sizeof(uint64_t), nullptr, nullptr);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(unordered_map_size(mapped), 10000u);
+    for (uint64_t key = 0; key < 10000; ++key) {
+        auto *value =
+            static_cast<uint64_t *>(unordered_map_find(mapped, &key));
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, key * 3);
+    }
+    uint64_t missing = 10000;
+    EXPECT_EQ(unordered_map_find(mapped, &missing), nullptr);
+
+    size_t cursor = 0, count = 0;
+    while (unordered_map_next(mapped, &cursor, nullptr, nullptr)) ++count;
+    EXPECT_EQ(count, 10000u);
+
+    unordered_map_destroy(mapped);
+    std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, MappedMapIsReadOnly) {
+    DSCUnorderedMap *map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(unordered_map_insert(map, &i, &i), DSC_ERROR_OK);
+    }
+    std::string path = temp_path("libdsc_map_readonly.dsc");
+    ASSERT_EQ(unordered_map_save(map, path.c_str()), DSC_ERROR_OK);
+    unordered_map_destroy(map);
+
+    DSCUnorderedMap *mapped = unordered_map_open_mapped(
+        path.c_str(), sizeof(int), sizeof(int), dsc_hash_int,
+        dsc_compare_int);
+    ASSERT_NE(mapped, nullptr);
+
+    int key = 5, value = 0;
+    EXPECT_EQ(unordered_map_insert(mapped, &key, &value),
+              DSC_ERROR_READ_ONLY);
+    EXPECT_EQ(unordered_map_erase(mapped, &key), DSC_ERROR_READ_ONLY);
+    EXPECT_EQ(unordered_map_try_emplace(mapped, &key, nullptr), nullptr);
+    EXPECT_EQ(unordered_map_reserve(mapped, 1000), DSC_ERROR_READ_ONLY);
+    EXPECT_EQ(unordered_map_set_probe_mode(mapped, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_READ_ONLY);
+    EXPECT_EQ(unordered_map_set_incremental_rehash(mapped, true),
+              DSC_ERROR_READ_ONLY);
+    unordered_map_clear(mapped);
+    EXPECT_EQ(unordered_map_size(mapped), 100u);
+
+    // A clone is an ordinary, writable map.
+    DSCUnorderedMap *copy = unordered_map_clone(mapped);
+    ASSERT_NE(copy, nullptr);
+    EXPECT_EQ(unordered_map_erase(copy, &key), DSC_ERROR_OK);
+    EXPECT_EQ(unordered_map_size(copy), 99u);
+    EXPECT_NE(unordered_map_find(mapped, &key), nullptr);
+
+    unordered_map_destroy(copy);
+    unordered_map_destroy(mapped);
+    std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, RobinHoodAndPendingMigration) {
+    DSCUnorderedMap *map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_EQ(unordered_map_set_probe_mode(map, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+    ASSERT_EQ(unordered_map_set_incremental_rehash(map, true), DSC_ERROR_OK);
+    int n = 0;
+    while (n < 3000 || !map->old_table) {
+        ASSERT_EQ(unordered_map_insert(map, &n, &n), DSC_ERROR_OK);
+        ++n;
+    }
+
+    std::string path = temp_path("libdsc_map_robin_hood.dsc");
+    ASSERT_EQ(unordered_map_save(map, path.c_str()), DSC_ERROR_OK);
+    EXPECT_NE(map->old_table, nullptr);
+    unordered_map_destroy(map);
+
+    DSCUnorderedMap *mapped = unordered_map_open_mapped(
+        path.c_str(), sizeof(int), sizeof(int), dsc_hash_int,
+        dsc_compare_int);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(unordered_map_probe_mode(mapped), DSC_PROBE_ROBIN_HOOD);
+    EXPECT_EQ(unordered_map_size(mapped), static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i) {
+        int *value = static_cast<int *>(unordered_map_find(mapped, &i));
+        ASSERT_NE(value, nullptr);
+        EXPECT_EQ(*value, i);
+    }
+
+    unordered_map_destroy(mapped);
+    std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, ConcurrentSavesReplaceTheFileWhole) {
+    // Two maps of different sizes saved to one path at the same time: the
+    // file must always end up as one complete table or the other.
+    DSCUnorderedMap *maps[2];
+    for (int m = 0; m < 2; ++m) {
+        maps[m] = unordered_map_create(sizeof(int), sizeof(int),
+                                       dsc_hash_int, dsc_compare_int);
+        for (int i = 0; i < 1000 * (m + 1); ++i) {
+            ASSERT_EQ(unordered_map_insert(maps[m], &i, &m), DSC_ERROR_OK);
+        }
+    }
+    std::string path = temp_path("libdsc_map_concurrent.dsc");
+
+    DSCError results[2][20];
+    std::vector<std::thread> writers;
+    for (int m = 0; m < 2; ++m) {
+        writers.emplace_back([&, m] {
+            for (DSCError &result : results[m]) {
+                result = unordered_map_save(maps[m], path.c_str());
+            }
+        });
+    }
+    for (auto &writer : writers) writer.join();
+
+    for (auto const &row : results) {
+        for (DSCError result : row) EXPECT_EQ(result, DSC_ERROR_OK);
+    }
+
+    DSCUnorderedMap *mapped = unordered_map_open_mapped(
+        path.c_str(), sizeof(int), sizeof(int), dsc_hash_int,
+        dsc_compare_int);
+    ASSERT_NE(mapped, nullptr);
+    size_t size = unordered_map_size(mapped);
+    EXPECT_TRUE(size == 1000u || size == 2000u);
+    for (int i = 0; i < static_cast<int>(size); ++i) {
+        EXPECT_NE(unordered_map_find(mapped, &i), nullptr);
+    }
+
+    unordered_map_destroy(mapped);
+    for (DSCUnorderedMap *map : maps) unordered_map_destroy(map);
+    std::remove(path.c_str());
+}
+
+TEST(MappedFileTest, RejectsIncompatibleFiles) {
+    DSCUnorderedMap *map = unordered_map_create(
+        sizeof(int), sizeof(int), dsc_hash_int, dsc_compare_int);
+    int key = 1;
+    ASSERT_EQ(unordered_map_insert(map, &key, &key), DSC_ERROR_OK);
+    std::string path = temp_path("libdsc_map_reject.dsc");
+    ASSERT_EQ(unordered_map_save(map, path.c_str()), DSC_ERROR_OK);
+    unordered_map_destroy(map);
+
+    char const *p = path.c_str();
+    EXPECT_EQ(unordered_map_open_mapped(p, sizeof(long long), sizeof(int),
+                                        dsc_hash_int, dsc_compare_int),
+              nullptr);
+    EXPECT_EQ(unordered_map_open_mapped(p, sizeof(int), sizeof(int), nullptr,
+                                        nullptr),
+              nullptr);
+    EXPECT_EQ(unordered_map_open_mapped("/nonexistent/libdsc.dsc",
+                                        sizeof(int), sizeof(int),
+                                        dsc_hash_int, dsc_compare_int),
+              nullptr);
+    EXPECT_EQ(unordered_map_save(nullptr, p), DSC_ERROR_INVALID_ARGUMENT);
+
+    // A truncated file no longer holds the arrays its header describes.
+    FILE *file = std::fopen(p, "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fclose(file);
+    ASSERT_EQ(truncate(p, size - 1), 0);
+    EXPECT_EQ(unordered_map_open_mapped(p, sizeof(int), sizeof(int),
+                                        dsc_hash_int, dsc_compare_int),
+              nullptr);
+
+    std::remove(p);
+}
+
+#endif
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
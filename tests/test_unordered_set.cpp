@@ -2,6 +2,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdio>
+#include <string>
+
 #include "libdsc/unordered_set.h"
 
 // Hash function for strings
@@ -33,7 +36,7 @@ class UnorderedSetTest : public ::testing::Test {
         }
     }
 
-    dsc_unordered_set *set;
+    DSCUnorderedSet *set;
 };
 
 TEST_F(UnorderedSetTest, Create) {
@@ -105,6 +108,139 @@ TEST_F(UnorderedSetTest, Reserve) {
     EXPECT_STREQ(*found, element);
 }
 
+TEST(UnorderedSetProbingTest, ZeroHashAndManyElements) {
+    DSCUnorderedSet *int_set =
+        unordered_set_create(sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_set, nullptr);
+
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(unordered_set_insert(int_set, &i), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(unordered_set_size(int_set), 5000u);
+
+    int zero = 0;
+    EXPECT_NE(unordered_set_find(int_set, &zero), nullptr);
+
+    for (int i = 0; i < 5000; i += 2) {
+        ASSERT_EQ(unordered_set_erase(int_set, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 5000; ++i) {
+        EXPECT_EQ(unordered_set_find(int_set, &i) != nullptr, i % 2 == 1);
+    }
+    unordered_set_destroy(int_set);
+}
+
+TEST(UnorderedSetProbingTest, Iterate) {
+    DSCUnorderedSet *int_set =
+        unordered_set_create(sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_set, nullptr);
+
+    long expected = 0;
+    for (int i = 0; i < 300; ++i) {
+        ASSERT_EQ(unordered_set_insert(int_set, &i), DSC_ERROR_OK);
+        expected += i;
+    }
+
+    size_t cursor = 0;
+    size_t visited = 0;
+    long sum = 0;
+    void *element;
+    while (unordered_set_next(int_set, &cursor, &element)) {
+        sum += *static_cast<int *>(element);
+        ++visited;
+    }
+    EXPECT_EQ(visited, 300u);
+    EXPECT_EQ(sum, expected);
+    unordered_set_destroy(int_set);
+}
+
+TEST(UnorderedSetRobinHoodTest, InsertFindErase) {
+    DSCUnorderedSet *int_set =
+        unordered_set_create(sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_set, nullptr);
+    ASSERT_EQ(unordered_set_set_probe_mode(int_set, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(unordered_set_insert(int_set, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 5000; i += 2) {
+        ASSERT_EQ(unordered_set_erase(int_set, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 6000; ++i) {
+        EXPECT_EQ(unordered_set_find(int_set, &i) != nullptr,
+                  i < 5000 && i % 2 == 1);
+    }
+    EXPECT_EQ(unordered_set_size(int_set), 2500u);
+    EXPECT_EQ(unordered_set_probe_mode(int_set), DSC_PROBE_ROBIN_HOOD);
+    unordered_set_destroy(int_set);
+}
+
+TEST(UnorderedSetBatchTest, ContainsBatch) {
+    DSCUnorderedSet *int_set =
+        unordered_set_create(sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(int_set, nullptr);
+    ASSERT_EQ(unordered_set_set_probe_mode(int_set, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+
+    for (int i = 0; i < 1000; i += 5) {
+        ASSERT_EQ(unordered_set_insert(int_set, &i), DSC_ERROR_OK);
+    }
+
+    int elements[100];
+    bool results[100];
+    for (int i = 0; i < 100; ++i) {
+        elements[i] = i * 11;
+    }
+    EXPECT_EQ(unordered_set_contains_batch(int_set, elements, 100, results),
+              19u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(results[i], elements[i] < 1000 && elements[i] % 5 == 0);
+    }
+    unordered_set_destroy(int_set);
+}
+
+// Table files are only supported on POSIX systems.
+#if defined(__unix__) || defined(__APPLE__)
+
+TEST(UnorderedSetMappedFileTest, SaveAndOpenRoundTrip) {
+    DSCUnorderedSet *int_set =
+        unordered_set_create(sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_EQ(unordered_set_set_probe_mode(int_set, DSC_PROBE_ROBIN_HOOD),
+              DSC_ERROR_OK);
+    for (int i = 0; i < 5000; i += 2) {
+        ASSERT_EQ(unordered_set_insert(int_set, &i), DSC_ERROR_OK);
+    }
+    std::string path = testing::TempDir() + "libdsc_set_roundtrip.dsc";
+    ASSERT_EQ(unordered_set_save(int_set, path.c_str()), DSC_ERROR_OK);
+    unordered_set_destroy(int_set);
+
+    // Set files are not map files.
+    EXPECT_EQ(unordered_set_open_mapped(path.c_str(), sizeof(int), nullptr,
+                                        nullptr),
+              nullptr);
+
+    DSCUnorderedSet *mapped = unordered_set_open_mapped(
+        path.c_str(), sizeof(int), dsc_hash_int, dsc_compare_int);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(unordered_set_size(mapped), 2500u);
+    for (int i = 0; i < 5000; ++i) {
+        EXPECT_EQ(unordered_set_find(mapped, &i) != nullptr, i % 2 == 0);
+    }
+
+    int element = 1;
+    EXPECT_EQ(unordered_set_insert(mapped, &element), DSC_ERROR_READ_ONLY);
+    EXPECT_EQ(unordered_set_erase(mapped, &element), DSC_ERROR_READ_ONLY);
+    EXPECT_EQ(unordered_set_reserve(mapped, 100000), DSC_ERROR_READ_ONLY);
+    unordered_set_clear(mapped);
+    EXPECT_EQ(unordered_set_size(mapped), 2500u);
+
+    unordered_set_destroy(mapped);
+    std::remove(path.c_str());
+}
+
+#endif
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
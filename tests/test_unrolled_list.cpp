@@ -0,0 +1,262 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "libdsc/unrolled_list.h"
+
+class UnrolledListTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        list = unrolled_list_create(sizeof(int));
+        ASSERT_NE(list, nullptr);
+    }
+
+    void TearDown() override { unrolled_list_destroy(list); }
+
+    // Checks the list against a model, through iterators and node-wise.
+    void ExpectEquals(std::vector<int> const &model) {
+        ASSERT_EQ(unrolled_list_size(list), model.size());
+
+        size_t i = 0;
+        for (auto it = unrolled_list_begin(list); it.node;
+             unrolled_list_advance(&it)) {
+            ASSERT_LT(i, model.size());
+            EXPECT_EQ(*static_cast<int *>(unrolled_list_get(list, it)),
+                      model[i++]);
+        }
+        EXPECT_EQ(i, model.size());
+
+        i = 0;
+        DSCUnrolledListNode *node = nullptr;
+        void *elements;
+        size_t count;
+        while (unrolled_list_next_block(list, &node, &elements, &count)) {
+            EXPECT_GT(count, 0u);
+            EXPECT_LE(count, list->node_capacity);
+            for (size_t j = 0; j < count; ++j) {
+                EXPECT_EQ(static_cast<int *>(elements)[j], model[i++]);
+            }
+        }
+        EXPECT_EQ(i, model.size());
+    }
+
+    DSCUnrolledList *list;
+};
+
+TEST_F(UnrolledListTest, Create) {
+    EXPECT_EQ(unrolled_list_size(list), 0u);
+    EXPECT_TRUE(unrolled_list_empty(list));
+    EXPECT_EQ(unrolled_list_front(list), nullptr);
+    EXPECT_EQ(unrolled_list_back(list), nullptr);
+    EXPECT_EQ(unrolled_list_begin(list).node, nullptr);
+    EXPECT_GT(list->node_capacity, 8u);
+}
+
+TEST_F(UnrolledListTest, InvalidArguments) {
+    int value = 1;
+    EXPECT_EQ(unrolled_list_create(0), nullptr);
+    EXPECT_EQ(unrolled_list_push_back(nullptr, &value),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(unrolled_list_push_front(list, nullptr),
+              DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(unrolled_list_pop_front(list), DSC_ERROR_EMPTY);
+    EXPECT_EQ(unrolled_list_pop_back(list), DSC_ERROR_EMPTY);
+
+    DSCUnrolledListIterator end = unrolled_list_end(list);
+    EXPECT_EQ(unrolled_list_erase(list, &end), DSC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(unrolled_list_at(list, 0), nullptr);
+    unrolled_list_destroy(nullptr);
+}
+
+TEST_F(UnrolledListTest, PushAndPopBothEnds) {
+    std::vector<int> model;
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_EQ(unrolled_list_push_back(list, &i), DSC_ERROR_OK);
+        int negative = -i;
+        ASSERT_EQ(unrolled_list_push_front(list, &negative), DSC_ERROR_OK);
+        model.push_back(i);
+        model.insert(model.begin(), negative);
+    }
+    ExpectEquals(model);
+    EXPECT_EQ(*static_cast<int *>(unrolled_list_front(list)), -499);
+    EXPECT_EQ(*static_cast<int *>(unrolled_list_back(list)), 499);
+
+    for (int i = 0; i < 300; ++i) {
+        ASSERT_EQ(unrolled_list_pop_front(list), DSC_ERROR_OK);
+        ASSERT_EQ(unrolled_list_pop_back(list), DSC_ERROR_OK);
+    }
+    model.erase(model.begin(), model.begin() + 300);
+    model.erase(model.end() - 300, model.end());
+    ExpectEquals(model);
+
+    while (!unrolled_list_empty(list)) {
+        ASSERT_EQ(unrolled_list_pop_back(list), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(list->head, nullptr);
+    EXPECT_EQ(list->tail, nullptr);
+}
+
+TEST_F(UnrolledListTest, At) {
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(unrolled_list_push_back(list, &i), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(*static_cast<int *>(unrolled_list_at(list, i)), i);
+    }
+    EXPECT_EQ(unrolled_list_at(list, 1000), nullptr);
+}
+
+TEST_F(UnrolledListTest, InsertAtEnd) {
+    DSCUnrolledListIterator end = unrolled_list_end(list);
+    int value = 7;
+    ASSERT_EQ(unrolled_list_insert(list, &end, &value), DSC_ERROR_OK);
+    EXPECT_EQ(*static_cast<int *>(unrolled_list_get(list, end)), 7);
+    ExpectEquals({7});
+}
+
+TEST_F(UnrolledListTest, InsertSplitsFullNodes) {
+    std::vector<int> model;
+    // Inserting repeatedly in the middle forces splits.
+    for (int i = 0; i < 1000; ++i) {
+        size_t index = model.size() / 2;
+        DSCUnrolledListIterator it = unrolled_list_iterator_at(list, index);
+        ASSERT_EQ(unrolled_list_insert(list, &it, &i), DSC_ERROR_OK);
+        EXPECT_EQ(*static_cast<int *>(unrolled_list_get(list, it)), i);
+        model.insert(model.begin() + index, i);
+    }
+    ExpectEquals(model);
+}
+
+TEST_F(UnrolledListTest, EraseReturnsNextAndMerges) {
+    std::vector<int> model;
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(unrolled_list_push_back(list, &i), DSC_ERROR_OK);
+        model.push_back(i);
+    }
+
+    // Erase every other element in one pass.
+    DSCUnrolledListIterator it = unrolled_list_begin(list);
+    while (it.node) {
+        ASSERT_EQ(unrolled_list_erase(list, &it), DSC_ERROR_OK);
+        if (it.node) unrolled_list_advance(&it);
+    }
+    std::vector<int> odd;
+    for (int value : model) {
+        if (value % 2) odd.push_back(value);
+    }
+    ExpectEquals(odd);
+
+    // Erase most of what is left, leaving sparse nodes to merge.
+    it = unrolled_list_begin(list);
+    size_t kept = 0;
+    std::vector<int> rest;
+    while (it.node) {
+        int value = *static_cast<int *>(unrolled_list_get(list, it));
+        if (value % 10 == 1) {
+            rest.push_back(value);
+            unrolled_list_advance(&it);
+            ++kept;
+        } else {
+            ASSERT_EQ(unrolled_list_erase(list, &it), DSC_ERROR_OK);
+        }
+    }
+    ExpectEquals(rest);
+
+    size_t nodes = 0;
+    for (auto *node = list->head; node; node = node->next) ++nodes;
+    EXPECT_LE(nodes, kept / (list->node_capacity / 4) + 2);
+}
+
+TEST_F(UnrolledListTest, RandomOperationsMatchModel) {
+    std::mt19937 gen(12345);
+    std::vector<int> model;
+
+    for (int step = 0; step < 20000; ++step) {
+        int value = static_cast<int>(gen());
+        switch (gen() % 6) {
+            case 0:
+                ASSERT_EQ(unrolled_list_push_back(list, &value), DSC_ERROR_OK);
+                model.push_back(value);
+                break;
+            case 1:
+                ASSERT_EQ(unrolled_list_push_front(list, &value),
+                          DSC_ERROR_OK);
+                model.insert(model.begin(), value);
+                break;
+            case 2:
+            case 3: {
+                size_t index = gen() % (model.size() + 1);
+                auto it = unrolled_list_iterator_at(list, index);
+                ASSERT_EQ(unrolled_list_insert(list, &it, &value),
+                          DSC_ERROR_OK);
+                model.insert(model.begin() + index, value);
+                break;
+            }
+            case 4: {
+                if (model.empty()) break;
+                size_t index = gen() % model.size();
+                auto it = unrolled_list_iterator_at(list, index);
+                ASSERT_EQ(unrolled_list_erase(list, &it), DSC_ERROR_OK);
+                model.erase(model.begin() + index);
+                if (index < model.size()) {
+                    ASSERT_NE(it.node, nullptr);
+                    EXPECT_EQ(*static_cast<int *>(unrolled_list_get(list, it)),
+                              model[index]);
+                } else {
+                    EXPECT_EQ(it.node, nullptr);
+                }
+                break;
+            }
+            case 5:
+                if (model.empty()) break;
+                if (gen() % 2) {
+                    ASSERT_EQ(unrolled_list_pop_front(list), DSC_ERROR_OK);
+                    model.erase(model.begin());
+                } else {
+                    ASSERT_EQ(unrolled_list_pop_back(list), DSC_ERROR_OK);
+                    model.pop_back();
+                }
+                break;
+        }
+    }
+    ExpectEquals(model);
+}
+
+TEST_F(UnrolledListTest, ClearReusesNodes) {
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(unrolled_list_push_back(list, &i), DSC_ERROR_OK);
+    }
+    size_t capacity = pool_capacity(list->pool);
+
+    unrolled_list_clear(list);
+    EXPECT_TRUE(unrolled_list_empty(list));
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_EQ(unrolled_list_push_back(list, &i), DSC_ERROR_OK);
+    }
+    EXPECT_EQ(pool_capacity(list->pool), capacity);
+    EXPECT_EQ(*static_cast<int *>(unrolled_list_back(list)), 999);
+}
+
+TEST(UnrolledListLargeTest, LargeElements) {
+    struct Large {
+        int values[100];
+    };
+    DSCUnrolledList *list = unrolled_list_create(sizeof(Large));
+    ASSERT_NE(list, nullptr);
+    EXPECT_EQ(list->node_capacity,
+              size_t{DSC_UNROLLED_LIST_MIN_NODE_ELEMENTS});
+
+    for (int i = 0; i < 20; ++i) {
+        Large large{};
+        large.values[99] = i;
+        ASSERT_EQ(unrolled_list_push_front(list, &large), DSC_ERROR_OK);
+    }
+    for (int i = 0; i < 20; ++i) {
+        auto *large = static_cast<Large *>(unrolled_list_at(list, i));
+        EXPECT_EQ(large->values[99], 19 - i);
+    }
+    unrolled_list_destroy(list);
+}